@@ -187,6 +187,8 @@ SET_PROPERTY(CACHE ALPAKA_DEBUG PROPERTY STRINGS "0;1;2")
 SET(ALPAKA_CXX_STANDARD "11" CACHE STRING "C++ standard version")
 SET_PROPERTY(CACHE ALPAKA_CXX_STANDARD PROPERTY STRINGS "11;14;17")
 
+SET(ALPAKA_ATOMIC_STDLIB_LOCK_HASH_TABLE_SIZE "16" CACHE STRING "Number of locks used by the CPU accelerators for atomic operations on types that are not lock-free")
+
 #-------------------------------------------------------------------------------
 # Debug output of common variables.
 IF(${ALPAKA_DEBUG} GREATER 1)
@@ -947,6 +949,7 @@ IF(ALPAKA_ACC_GPU_HIP_ENABLE)
 ENDIF()
 
 LIST(APPEND _ALPAKA_COMPILE_DEFINITIONS_PUBLIC "ALPAKA_DEBUG=${ALPAKA_DEBUG}")
+LIST(APPEND _ALPAKA_COMPILE_DEFINITIONS_PUBLIC "ALPAKA_ATOMIC_STDLIB_LOCK_HASH_TABLE_SIZE=${ALPAKA_ATOMIC_STDLIB_LOCK_HASH_TABLE_SIZE}")
 
 IF(ALPAKA_CI)
     LIST(APPEND _ALPAKA_COMPILE_DEFINITIONS_PUBLIC "ALPAKA_CI")
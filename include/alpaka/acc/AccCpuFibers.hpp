@@ -14,9 +14,9 @@
 // Base classes.
 #include <alpaka/workdiv/WorkDivMembers.hpp>
 #include <alpaka/idx/gb/IdxGbRef.hpp>
-#include <alpaka/idx/bt/IdxBtRefFiberIdMap.hpp>
+#include <alpaka/idx/bt/IdxBtFiberLocal.hpp>
 #include <alpaka/atomic/AtomicNoOp.hpp>
-#include <alpaka/atomic/AtomicStdLibLock.hpp>
+#include <alpaka/atomic/AtomicStdLibLockFree.hpp>
 #include <alpaka/atomic/AtomicHierarchy.hpp>
 #include <alpaka/math/MathStdLib.hpp>
 #include <alpaka/block/shared/dyn/BlockSharedMemDynBoostAlignedAlloc.hpp>
@@ -68,11 +68,11 @@ namespace alpaka
         class AccCpuFibers final :
             public workdiv::WorkDivMembers<TDim, TIdx>,
             public idx::gb::IdxGbRef<TDim, TIdx>,
-            public idx::bt::IdxBtRefFiberIdMap<TDim, TIdx>,
+            public idx::bt::IdxBtFiberLocal<TDim, TIdx>,
             public atomic::AtomicHierarchy<
-                atomic::AtomicStdLibLock<16>, // grid atomics
-                atomic::AtomicStdLibLock<16>, // block atomics
-                atomic::AtomicNoOp         // thread atomics
+                atomic::AtomicStdLibLockFree<ALPAKA_ATOMIC_STDLIB_LOCK_HASH_TABLE_SIZE>, // grid atomics
+                atomic::AtomicStdLibLockFree<ALPAKA_ATOMIC_STDLIB_LOCK_HASH_TABLE_SIZE>, // block atomics
+                atomic::AtomicNoOp                                                       // thread atomics
             >,
             public math::MathStdLib,
             public block::shared::dyn::BlockSharedMemDynBoostAlignedAlloc,
@@ -99,17 +99,15 @@ namespace alpaka
                 TIdx const & blockSharedMemDynSizeBytes) :
                     workdiv::WorkDivMembers<TDim, TIdx>(workDiv),
                     idx::gb::IdxGbRef<TDim, TIdx>(m_gridBlockIdx),
-                    idx::bt::IdxBtRefFiberIdMap<TDim, TIdx>(m_fibersToIndices),
+                    idx::bt::IdxBtFiberLocal<TDim, TIdx>(),
                     atomic::AtomicHierarchy<
-                        atomic::AtomicStdLibLock<16>, // atomics between grids
-                        atomic::AtomicStdLibLock<16>, // atomics between blocks
-                        atomic::AtomicNoOp         // atomics between threads
+                        atomic::AtomicStdLibLockFree<ALPAKA_ATOMIC_STDLIB_LOCK_HASH_TABLE_SIZE>, // atomics between grids
+                        atomic::AtomicStdLibLockFree<ALPAKA_ATOMIC_STDLIB_LOCK_HASH_TABLE_SIZE>, // atomics between blocks
+                        atomic::AtomicNoOp                                                       // atomics between threads
                     >(),
                     math::MathStdLib(),
                     block::shared::dyn::BlockSharedMemDynBoostAlignedAlloc(static_cast<std::size_t>(blockSharedMemDynSizeBytes)),
-                    block::shared::st::BlockSharedMemStMasterSync(
-                        [this](){block::sync::syncBlockThreads(*this);},
-                        [this](){return (m_masterFiberId == boost::this_fiber::get_id());}),
+                    block::shared::st::BlockSharedMemStMasterSync(),
                     block::sync::BlockSyncBarrierFiber<TIdx>(
                         workdiv::getWorkDiv<Block, Threads>(workDiv).prod()),
                     rand::RandStdLib(),
@@ -131,11 +129,7 @@ namespace alpaka
 
         private:
             // getIdx
-            typename idx::bt::IdxBtRefFiberIdMap<TDim, TIdx>::FiberIdToIdxMap mutable m_fibersToIndices;  //!< The mapping of fibers id's to indices.
             vec::Vec<TDim, TIdx> mutable m_gridBlockIdx;                    //!< The index of the currently executed block.
-
-            // allocBlockSharedArr
-            boost::fibers::fiber::id mutable m_masterFiberId;           //!< The id of the master fiber.
         };
     }
 
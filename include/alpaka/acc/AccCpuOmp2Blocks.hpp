@@ -20,8 +20,7 @@
 #include <alpaka/idx/gb/IdxGbRef.hpp>
 #include <alpaka/idx/bt/IdxBtZero.hpp>
 #include <alpaka/atomic/AtomicNoOp.hpp>
-#include <alpaka/atomic/AtomicStdLibLock.hpp>
-#include <alpaka/atomic/AtomicOmpBuiltIn.hpp>
+#include <alpaka/atomic/AtomicStdLibLockFree.hpp>
 #include <alpaka/atomic/AtomicHierarchy.hpp>
 #include <alpaka/math/MathStdLib.hpp>
 #include <alpaka/block/shared/dyn/BlockSharedMemDynBoostAlignedAlloc.hpp>
@@ -71,9 +70,9 @@ namespace alpaka
             public idx::gb::IdxGbRef<TDim, TIdx>,
             public idx::bt::IdxBtZero<TDim, TIdx>,
             public atomic::AtomicHierarchy<
-                atomic::AtomicStdLibLock<16>,   // grid atomics
-                atomic::AtomicOmpBuiltIn,    // block atomics
-                atomic::AtomicNoOp           // thread atomics
+                atomic::AtomicStdLibLockFree<ALPAKA_ATOMIC_STDLIB_LOCK_HASH_TABLE_SIZE>, // grid atomics
+                atomic::AtomicStdLibLockFree<ALPAKA_ATOMIC_STDLIB_LOCK_HASH_TABLE_SIZE>, // block atomics
+                atomic::AtomicNoOp                                                       // thread atomics
             >,
             public math::MathStdLib,
             public block::shared::dyn::BlockSharedMemDynBoostAlignedAlloc,
@@ -102,9 +101,9 @@ namespace alpaka
                     idx::gb::IdxGbRef<TDim, TIdx>(m_gridBlockIdx),
                     idx::bt::IdxBtZero<TDim, TIdx>(),
                     atomic::AtomicHierarchy<
-                        atomic::AtomicStdLibLock<16>,// atomics between grids
-                        atomic::AtomicOmpBuiltIn, // atomics between blocks
-                        atomic::AtomicNoOp        // atomics between threads
+                        atomic::AtomicStdLibLockFree<ALPAKA_ATOMIC_STDLIB_LOCK_HASH_TABLE_SIZE>, // atomics between grids
+                        atomic::AtomicStdLibLockFree<ALPAKA_ATOMIC_STDLIB_LOCK_HASH_TABLE_SIZE>, // atomics between blocks
+                        atomic::AtomicNoOp                                                       // atomics between threads
                     >(),
                     math::MathStdLib(),
                     block::shared::dyn::BlockSharedMemDynBoostAlignedAlloc(static_cast<std::size_t>(blockSharedMemDynSizeBytes)),
@@ -19,7 +19,7 @@
 #include <alpaka/workdiv/WorkDivMembers.hpp>
 #include <alpaka/idx/gb/IdxGbRef.hpp>
 #include <alpaka/idx/bt/IdxBtOmp.hpp>
-#include <alpaka/atomic/AtomicStdLibLock.hpp>
+#include <alpaka/atomic/AtomicStdLibLockFree.hpp>
 #include <alpaka/atomic/AtomicOmpBuiltIn.hpp>
 #include <alpaka/atomic/AtomicHierarchy.hpp>
 #include <alpaka/math/MathStdLib.hpp>
@@ -72,9 +72,9 @@ namespace alpaka
             public idx::gb::IdxGbRef<TDim, TIdx>,
             public idx::bt::IdxBtOmp<TDim, TIdx>,
             public atomic::AtomicHierarchy<
-                atomic::AtomicStdLibLock<16>,   // grid atomics
-                atomic::AtomicOmpBuiltIn,    // block atomics
-                atomic::AtomicOmpBuiltIn     // thread atomics
+                atomic::AtomicStdLibLockFree<ALPAKA_ATOMIC_STDLIB_LOCK_HASH_TABLE_SIZE>, // grid atomics
+                atomic::AtomicOmpBuiltIn,                                                // block atomics
+                atomic::AtomicOmpBuiltIn                                                 // thread atomics
             >,
             public math::MathStdLib,
             public block::shared::dyn::BlockSharedMemDynBoostAlignedAlloc,
@@ -103,15 +103,13 @@ namespace alpaka
                     idx::gb::IdxGbRef<TDim, TIdx>(m_gridBlockIdx),
                     idx::bt::IdxBtOmp<TDim, TIdx>(),
                     atomic::AtomicHierarchy<
-                        atomic::AtomicStdLibLock<16>,// atomics between grids
-                        atomic::AtomicOmpBuiltIn, // atomics between blocks
-                        atomic::AtomicOmpBuiltIn  // atomics between threads
+                        atomic::AtomicStdLibLockFree<ALPAKA_ATOMIC_STDLIB_LOCK_HASH_TABLE_SIZE>, // atomics between grids
+                        atomic::AtomicOmpBuiltIn,                                                // atomics between blocks
+                        atomic::AtomicOmpBuiltIn                                                 // atomics between threads
                     >(),
                     math::MathStdLib(),
                     block::shared::dyn::BlockSharedMemDynBoostAlignedAlloc(static_cast<std::size_t>(blockSharedMemDynSizeBytes)),
-                    block::shared::st::BlockSharedMemStMasterSync(
-                        [this](){block::sync::syncBlockThreads(*this);},
-                        [](){return (::omp_get_thread_num() == 0);}),
+                    block::shared::st::BlockSharedMemStMasterSync(),
                     block::sync::BlockSyncBarrierOmp(),
                     rand::RandStdLib(),
                     time::TimeOmp(),
@@ -16,7 +16,7 @@
 #include <alpaka/idx/gb/IdxGbRef.hpp>
 #include <alpaka/idx/bt/IdxBtZero.hpp>
 #include <alpaka/atomic/AtomicNoOp.hpp>
-#include <alpaka/atomic/AtomicStdLibLock.hpp>
+#include <alpaka/atomic/AtomicStdLibLockFree.hpp>
 #include <alpaka/atomic/AtomicHierarchy.hpp>
 #include <alpaka/math/MathStdLib.hpp>
 #include <alpaka/block/shared/dyn/BlockSharedMemDynBoostAlignedAlloc.hpp>
@@ -65,9 +65,9 @@ namespace alpaka
             public idx::gb::IdxGbRef<TDim, TIdx>,
             public idx::bt::IdxBtZero<TDim, TIdx>,
             public atomic::AtomicHierarchy<
-                atomic::AtomicStdLibLock<16>, // grid atomics
-                atomic::AtomicNoOp,        // block atomics
-                atomic::AtomicNoOp         // thread atomics
+                atomic::AtomicStdLibLockFree<ALPAKA_ATOMIC_STDLIB_LOCK_HASH_TABLE_SIZE>, // grid atomics
+                atomic::AtomicNoOp,                                                      // block atomics
+                atomic::AtomicNoOp                                                       // thread atomics
             >,
             public math::MathStdLib,
             public block::shared::dyn::BlockSharedMemDynBoostAlignedAlloc,
@@ -96,9 +96,9 @@ namespace alpaka
                     idx::gb::IdxGbRef<TDim, TIdx>(m_gridBlockIdx),
                     idx::bt::IdxBtZero<TDim, TIdx>(),
                     atomic::AtomicHierarchy<
-                        atomic::AtomicStdLibLock<16>, // atomics between grids
-                        atomic::AtomicNoOp,        // atomics between blocks
-                        atomic::AtomicNoOp         // atomics between threads
+                        atomic::AtomicStdLibLockFree<ALPAKA_ATOMIC_STDLIB_LOCK_HASH_TABLE_SIZE>, // atomics between grids
+                        atomic::AtomicNoOp,                                                      // atomics between blocks
+                        atomic::AtomicNoOp                                                       // atomics between threads
                     >(),
                     math::MathStdLib(),
                     block::shared::dyn::BlockSharedMemDynBoostAlignedAlloc(static_cast<std::size_t>(blockSharedMemDynSizeBytes)),
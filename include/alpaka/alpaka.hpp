@@ -36,6 +36,7 @@
 #include <alpaka/atomic/AtomicNoOp.hpp>
 #include <alpaka/atomic/AtomicOmpBuiltIn.hpp>
 #include <alpaka/atomic/AtomicStdLibLock.hpp>
+#include <alpaka/atomic/AtomicStdLibLockFree.hpp>
 #include <alpaka/atomic/Op.hpp>
 #include <alpaka/atomic/Traits.hpp>
 //-----------------------------------------------------------------------------
@@ -45,6 +46,7 @@
         //-----------------------------------------------------------------------------
         // dynamic
         #include <alpaka/block/shared/dyn/BlockSharedMemDynBoostAlignedAlloc.hpp>
+        #include <alpaka/block/shared/dyn/BlockSharedMemDynBoostAlignedAllocUncached.hpp>
         #include <alpaka/block/shared/dyn/BlockSharedMemDynCudaBuiltIn.hpp>
         #include <alpaka/block/shared/dyn/BlockSharedMemDynHipBuiltIn.hpp>
         #include <alpaka/block/shared/dyn/Traits.hpp>
@@ -76,17 +78,22 @@
 #include <alpaka/core/Cuda.hpp>
 #include <alpaka/core/Debug.hpp>
 #include <alpaka/core/Fibers.hpp>
+#include <alpaka/core/Futex.hpp>
 #include <alpaka/core/Hip.hpp>
 #include <alpaka/core/Positioning.hpp>
+#include <alpaka/core/SpinLock.hpp>
+#include <alpaka/core/ThreadAffinity.hpp>
 #include <alpaka/core/Unroll.hpp>
 #include <alpaka/core/Unused.hpp>
 #include <alpaka/core/Utility.hpp>
 #include <alpaka/core/Vectorize.hpp>
+#include <alpaka/core/WorkStealingQueue.hpp>
 //-----------------------------------------------------------------------------
 // dev
 #include <alpaka/dev/DevCudaRt.hpp>
 #include <alpaka/dev/DevCpu.hpp>
 #include <alpaka/dev/DevHipRt.hpp>
+#include <alpaka/dev/cpu/Numa.hpp>
 #include <alpaka/dev/cpu/Wait.hpp>
 #include <alpaka/dev/Traits.hpp>
 //-----------------------------------------------------------------------------
@@ -104,12 +111,16 @@
 // extent
 #include <alpaka/extent/Traits.hpp>
 //-----------------------------------------------------------------------------
+// graph
+#include <alpaka/graph/GraphCpu.hpp>
+#include <alpaka/graph/Traits.hpp>
+//-----------------------------------------------------------------------------
 // idx
 #include <alpaka/idx/bt/IdxBtCudaBuiltIn.hpp>
 #include <alpaka/idx/bt/IdxBtHipBuiltIn.hpp>
 #include <alpaka/idx/bt/IdxBtOmp.hpp>
-#include <alpaka/idx/bt/IdxBtRefFiberIdMap.hpp>
-#include <alpaka/idx/bt/IdxBtRefThreadIdMap.hpp>
+#include <alpaka/idx/bt/IdxBtFiberLocal.hpp>
+#include <alpaka/idx/bt/IdxBtThreadLocal.hpp>
 #include <alpaka/idx/bt/IdxBtZero.hpp>
 #include <alpaka/idx/gb/IdxGbCudaBuiltIn.hpp>
 #include <alpaka/idx/gb/IdxGbRef.hpp>
@@ -136,6 +147,8 @@
 //-----------------------------------------------------------------------------
 // mem
 #include <alpaka/mem/alloc/AllocCpuBoostAligned.hpp>
+#include <alpaka/mem/alloc/AllocCpuCaching.hpp>
+#include <alpaka/mem/alloc/AllocCpuHugePages.hpp>
 #include <alpaka/mem/alloc/AllocCpuNew.hpp>
 #include <alpaka/mem/alloc/Traits.hpp>
 
@@ -191,6 +204,7 @@
 #include <alpaka/queue/QueueCudaRtBlocking.hpp>
 #include <alpaka/queue/QueueCpuNonBlocking.hpp>
 #include <alpaka/queue/QueueCpuBlocking.hpp>
+#include <alpaka/queue/QueueCpuConcurrent.hpp>
 #include <alpaka/queue/Traits.hpp>
 //-----------------------------------------------------------------------------
 // time
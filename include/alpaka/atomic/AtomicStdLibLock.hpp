@@ -12,14 +12,32 @@
 #include <alpaka/atomic/Traits.hpp>
 
 #include <alpaka/core/BoostPredef.hpp>
+#include <alpaka/core/SpinLock.hpp>
 
 #include <mutex>
 #include <array>
 
+//! The default number of locks in the hash table of AtomicStdLibLock used by the CPU accelerators.
+#ifndef ALPAKA_ATOMIC_STDLIB_LOCK_HASH_TABLE_SIZE
+    #define ALPAKA_ATOMIC_STDLIB_LOCK_HASH_TABLE_SIZE 16
+#endif
+
 namespace alpaka
 {
     namespace atomic
     {
+        namespace detail
+        {
+            //#############################################################################
+            //! A lock of the AtomicStdLibLock hash table.
+            //!
+            //! Each lock occupies its own cache line so that threads using neighbouring locks do not false share.
+            struct alignas(64) AtomicStdLibLockStripe
+            {
+                core::threads::SpinLock m_lock;
+            };
+        }
+
         //#############################################################################
         //! The CPU threads accelerator atomic ops.
         //
@@ -75,7 +93,7 @@ namespace alpaka
             /*virtual*/ ~AtomicStdLibLock() = default;
 
             template<typename TPtr>
-            std::mutex & getMutex(TPtr const * const ptr) const
+            core::threads::SpinLock & getLock(TPtr const * const ptr) const
             {
                 //-----------------------------------------------------------------------------
                 //! get the size of the hash table
@@ -89,12 +107,12 @@ namespace alpaka
     #pragma clang diagnostic ignored "-Wexit-time-destructors"
 #endif
                 static std::array<
-                    std::mutex,
-                    hashTableSize> m_mtxAtomic; //!< The mutex protecting access for an atomic operation.
+                    detail::AtomicStdLibLockStripe,
+                    hashTableSize> m_lockAtomic; //!< The locks protecting access for an atomic operation.
 #if BOOST_COMP_CLANG
     #pragma clang diagnostic pop
 #endif
-                return m_mtxAtomic[hashedAddr];
+                return m_lockAtomic[hashedAddr].m_lock;
             }
         };
 
@@ -120,7 +138,7 @@ namespace alpaka
                     T const & value)
                 -> T
                 {
-                    std::lock_guard<std::mutex> lock(atomic.getMutex(addr));
+                    std::lock_guard<core::threads::SpinLock> lock(atomic.getLock(addr));
                     return TOp()(addr, value);
                 }
                 //-----------------------------------------------------------------------------
@@ -131,7 +149,7 @@ namespace alpaka
                     T const & value)
                 -> T
                 {
-                    std::lock_guard<std::mutex> lock(atomic.getMutex(addr));
+                    std::lock_guard<core::threads::SpinLock> lock(atomic.getLock(addr));
                     return TOp()(addr, compare, value);
                 }
             };
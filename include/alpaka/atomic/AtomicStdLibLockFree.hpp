@@ -0,0 +1,324 @@
+/* Copyright 2019 Benjamin Worpitz
+ *
+ * This file is part of Alpaka.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <alpaka/atomic/AtomicStdLibLock.hpp>
+#include <alpaka/atomic/Op.hpp>
+#include <alpaka/atomic/Traits.hpp>
+
+#include <alpaka/core/BoostPredef.hpp>
+#include <alpaka/core/Unused.hpp>
+
+#include <cstddef>
+#include <cstring>
+#include <mutex>
+#include <type_traits>
+
+// The lock-free implementation requires the __atomic builtins.
+#if BOOST_COMP_GNUC || BOOST_COMP_CLANG || BOOST_COMP_INTEL
+    #define ALPAKA_ATOMIC_STDLIB_LOCK_FREE_BUILTINS_AVAILABLE
+#endif
+
+namespace alpaka
+{
+    namespace atomic
+    {
+        //#############################################################################
+        //! The CPU lock-free atomic ops.
+        //
+        //  Atomics can be used in the grids, blocks and threads hierarchy levels.
+        //  Atomics are not guaranteed to be save between devices.
+        //
+        //  Operations on naturally aligned arithmetic types with a size the processor can access atomically are executed lock-free.
+        //  Add, Sub, And, Or, Xor, Exch and Cas map directly to the corresponding atomic instructions.
+        //  Min, Max, Inc, Dec and all floating point operations (except Exch and Cas) are implemented as compare-and-swap loops.
+        //  All other types fall back to the striped locks of AtomicStdLibLock.
+        //
+        // \tparam THashTableSize size of the hash table of the lock fallback
+        template<size_t THashTableSize>
+        class AtomicStdLibLockFree
+        {
+        public:
+            //-----------------------------------------------------------------------------
+            AtomicStdLibLockFree() = default;
+            //-----------------------------------------------------------------------------
+            AtomicStdLibLockFree(AtomicStdLibLockFree const &) = delete;
+            //-----------------------------------------------------------------------------
+            AtomicStdLibLockFree(AtomicStdLibLockFree &&) = delete;
+            //-----------------------------------------------------------------------------
+            auto operator=(AtomicStdLibLockFree const &) -> AtomicStdLibLockFree & = delete;
+            //-----------------------------------------------------------------------------
+            auto operator=(AtomicStdLibLockFree &&) -> AtomicStdLibLockFree & = delete;
+            //-----------------------------------------------------------------------------
+            /*virtual*/ ~AtomicStdLibLockFree() = default;
+        };
+
+        namespace detail
+        {
+            //#############################################################################
+            //! If operations on the type are executed lock-free.
+            template<
+                typename T>
+            struct IsAtomicStdLibLockFree :
+                std::integral_constant<
+                    bool,
+#ifdef ALPAKA_ATOMIC_STDLIB_LOCK_FREE_BUILTINS_AVAILABLE
+                    std::is_arithmetic<T>::value
+                    && !std::is_same<T, bool>::value
+                    && ((sizeof(T) == 1u) || (sizeof(T) == 2u) || (sizeof(T) == 4u) || (sizeof(T) == 8u))
+                    && __atomic_always_lock_free(sizeof(T), 0)
+#else
+                    false
+#endif
+                >
+            {};
+
+#ifdef ALPAKA_ATOMIC_STDLIB_LOCK_FREE_BUILTINS_AVAILABLE
+            //#############################################################################
+            //! The lock-free atomic operation implemented by a compare-and-swap loop.
+            //!
+            //! This is the fallback for all operations without a dedicated atomic instruction.
+            template<
+                typename TOp,
+                typename T,
+                typename TSfinae = void>
+            struct AtomicOpLockFree
+            {
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST static auto atomicOp(
+                    T * const addr,
+                    T const & value)
+                -> T
+                {
+                    T old;
+                    __atomic_load(addr, &old, __ATOMIC_RELAXED);
+                    while(true)
+                    {
+                        T desired(old);
+                        TOp()(&desired, value);
+                        // If the operation does not change the value (e.g. Min/Max), there is nothing to write.
+                        if(std::memcmp(&desired, &old, sizeof(T)) == 0)
+                        {
+                            __atomic_thread_fence(__ATOMIC_SEQ_CST);
+                            return old;
+                        }
+                        if(__atomic_compare_exchange(addr, &old, &desired, true, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED))
+                        {
+                            return old;
+                        }
+                    }
+                }
+            };
+            //#############################################################################
+            template<
+                typename T>
+            struct AtomicOpLockFree<
+                op::Add,
+                T,
+                typename std::enable_if<std::is_integral<T>::value>::type>
+            {
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST static auto atomicOp(
+                    T * const addr,
+                    T const & value)
+                -> T
+                {
+                    return __atomic_fetch_add(addr, value, __ATOMIC_SEQ_CST);
+                }
+            };
+            //#############################################################################
+            template<
+                typename T>
+            struct AtomicOpLockFree<
+                op::Sub,
+                T,
+                typename std::enable_if<std::is_integral<T>::value>::type>
+            {
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST static auto atomicOp(
+                    T * const addr,
+                    T const & value)
+                -> T
+                {
+                    return __atomic_fetch_sub(addr, value, __ATOMIC_SEQ_CST);
+                }
+            };
+            //#############################################################################
+            template<
+                typename T>
+            struct AtomicOpLockFree<
+                op::And,
+                T,
+                typename std::enable_if<std::is_integral<T>::value>::type>
+            {
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST static auto atomicOp(
+                    T * const addr,
+                    T const & value)
+                -> T
+                {
+                    return __atomic_fetch_and(addr, value, __ATOMIC_SEQ_CST);
+                }
+            };
+            //#############################################################################
+            template<
+                typename T>
+            struct AtomicOpLockFree<
+                op::Or,
+                T,
+                typename std::enable_if<std::is_integral<T>::value>::type>
+            {
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST static auto atomicOp(
+                    T * const addr,
+                    T const & value)
+                -> T
+                {
+                    return __atomic_fetch_or(addr, value, __ATOMIC_SEQ_CST);
+                }
+            };
+            //#############################################################################
+            template<
+                typename T>
+            struct AtomicOpLockFree<
+                op::Xor,
+                T,
+                typename std::enable_if<std::is_integral<T>::value>::type>
+            {
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST static auto atomicOp(
+                    T * const addr,
+                    T const & value)
+                -> T
+                {
+                    return __atomic_fetch_xor(addr, value, __ATOMIC_SEQ_CST);
+                }
+            };
+            //#############################################################################
+            template<
+                typename T>
+            struct AtomicOpLockFree<
+                op::Exch,
+                T>
+            {
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST static auto atomicOp(
+                    T * const addr,
+                    T const & value)
+                -> T
+                {
+                    T desired(value);
+                    T old;
+                    __atomic_exchange(addr, &desired, &old, __ATOMIC_SEQ_CST);
+                    return old;
+                }
+            };
+            //#############################################################################
+            template<
+                typename T>
+            struct AtomicOpLockFree<
+                op::Cas,
+                T>
+            {
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST static auto atomicOp(
+                    T * const addr,
+                    T const & compare,
+                    T const & value)
+                -> T
+                {
+                    // On failure the current value is written into old.
+                    T old(compare);
+                    T desired(value);
+                    __atomic_compare_exchange(addr, &old, &desired, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+                    return old;
+                }
+            };
+#endif
+        }
+
+        namespace traits
+        {
+            //#############################################################################
+            //! The CPU lock-free atomic operation.
+            template<
+                typename TOp,
+                typename T,
+                typename THierarchy,
+                size_t THashTableSize>
+            struct AtomicOp<
+                TOp,
+                atomic::AtomicStdLibLockFree<THashTableSize>,
+                T,
+                THierarchy>
+            {
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST static auto atomicOp(
+                    atomic::AtomicStdLibLockFree<THashTableSize> const & atomic,
+                    T * const addr,
+                    T const & value)
+                -> T
+                {
+                    alpaka::ignore_unused(atomic);
+                    return atomicOpImpl(
+                        typename detail::IsAtomicStdLibLockFree<T>::type(),
+                        addr,
+                        value);
+                }
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST static auto atomicOp(
+                    atomic::AtomicStdLibLockFree<THashTableSize> const & atomic,
+                    T * const addr,
+                    T const & compare,
+                    T const & value)
+                -> T
+                {
+                    alpaka::ignore_unused(atomic);
+                    return atomicOpImpl(
+                        typename detail::IsAtomicStdLibLockFree<T>::type(),
+                        addr,
+                        compare,
+                        value);
+                }
+
+            private:
+#ifdef ALPAKA_ATOMIC_STDLIB_LOCK_FREE_BUILTINS_AVAILABLE
+                //-----------------------------------------------------------------------------
+                //! Executes the operation lock-free.
+                template<
+                    typename... TArgs>
+                ALPAKA_FN_HOST static auto atomicOpImpl(
+                    std::true_type const &,
+                    T * const addr,
+                    TArgs const & ... args)
+                -> T
+                {
+                    return detail::AtomicOpLockFree<TOp, T>::atomicOp(addr, args...);
+                }
+#endif
+                //-----------------------------------------------------------------------------
+                //! Executes the operation while holding the lock of the address.
+                template<
+                    typename... TArgs>
+                ALPAKA_FN_HOST static auto atomicOpImpl(
+                    std::false_type const &,
+                    T * const addr,
+                    TArgs const & ... args)
+                -> T
+                {
+                    // All instances share the same lock table.
+                    atomic::AtomicStdLibLock<THashTableSize> const atomicLock{};
+                    std::lock_guard<core::threads::SpinLock> lock(atomicLock.getLock(addr));
+                    return TOp()(addr, args...);
+                }
+            };
+        }
+    }
+}
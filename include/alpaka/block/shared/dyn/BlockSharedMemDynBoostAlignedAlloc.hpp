@@ -16,8 +16,11 @@
 
 #include <boost/align.hpp>
 
-#include <vector>
+#include <cstddef>
 #include <memory>
+#include <new>
+#include <utility>
+#include <vector>
 
 namespace alpaka
 {
@@ -27,8 +30,160 @@ namespace alpaka
         {
             namespace dyn
             {
+                namespace detail
+                {
+                    //#############################################################################
+                    //! A cache of block shared dynamic memory buffers.
+                    //!
+                    //! There is one cache per thread so that no synchronization is required.
+                    //! The buffers are reused across blocks and kernel launches and only grow if a larger size is requested.
+                    //! The cached bytes are limited because the cache lives as long as its thread, e.g. a queue worker.
+                    class BlockSharedMemDynCache final
+                    {
+                    public:
+                        using BufferPtr = std::unique_ptr<
+                            uint8_t,
+                            boost::alignment::aligned_delete>;
+
+                        //#############################################################################
+                        struct Buffer
+                        {
+                            BufferPtr m_pMem;
+                            std::size_t m_sizeBytes;
+                        };
+
+                        //! The maximum number of buffers kept by the cache of a thread.
+                        static constexpr std::size_t bufferCountMax = 4u;
+                        //! The maximum number of bytes kept by the cache of a thread. Larger buffers are freed when they are released.
+                        static constexpr std::size_t cachedBytesMax = std::size_t(1u) << 20u;
+
+                        //-----------------------------------------------------------------------------
+                        BlockSharedMemDynCache() :
+                            m_buffers(),
+                            m_cachedBytes(0u)
+                        {}
+                        //-----------------------------------------------------------------------------
+                        BlockSharedMemDynCache(BlockSharedMemDynCache const &) = delete;
+                        //-----------------------------------------------------------------------------
+                        BlockSharedMemDynCache(BlockSharedMemDynCache &&) = delete;
+                        //-----------------------------------------------------------------------------
+                        auto operator=(BlockSharedMemDynCache const &) -> BlockSharedMemDynCache & = delete;
+                        //-----------------------------------------------------------------------------
+                        auto operator=(BlockSharedMemDynCache &&) -> BlockSharedMemDynCache & = delete;
+                        //-----------------------------------------------------------------------------
+                        ~BlockSharedMemDynCache() = default;
+
+                        //-----------------------------------------------------------------------------
+                        //! \return A buffer of at least the given size. The caller owns the buffer until it is released.
+                        auto acquire(
+                            std::size_t const sizeBytes)
+                        -> Buffer
+                        {
+                            // Prefer the smallest cached buffer that is large enough.
+                            auto itBest(m_buffers.end());
+                            for(auto it(m_buffers.begin()); it != m_buffers.end(); ++it)
+                            {
+                                if((it->m_sizeBytes >= sizeBytes)
+                                    && ((itBest == m_buffers.end()) || (it->m_sizeBytes < itBest->m_sizeBytes)))
+                                {
+                                    itBest = it;
+                                }
+                            }
+                            if(itBest != m_buffers.end())
+                            {
+                                Buffer buffer(std::move(*itBest));
+                                m_buffers.erase(itBest);
+                                m_cachedBytes -= buffer.m_sizeBytes;
+                                return buffer;
+                            }
+
+                            // Grow: A cached buffer that is too small would only be replaced later, so it is freed now.
+                            if(!m_buffers.empty())
+                            {
+                                m_cachedBytes -= m_buffers.back().m_sizeBytes;
+                                m_buffers.pop_back();
+                            }
+                            BufferPtr pMem(
+                                reinterpret_cast<uint8_t *>(
+                                    boost::alignment::aligned_alloc(core::vectorization::defaultAlignment, sizeBytes)));
+                            if(!pMem)
+                            {
+                                throw std::bad_alloc();
+                            }
+                            return Buffer{std::move(pMem), sizeBytes};
+                        }
+                        //-----------------------------------------------------------------------------
+                        //! Returns the buffer to the cache.
+                        auto release(
+                            Buffer && buffer)
+                        -> void
+                        {
+                            if(!buffer.m_pMem)
+                            {
+                                return;
+                            }
+                            // A single launch with a large size must not keep its memory for the lifetime of the thread.
+                            if(buffer.m_sizeBytes > cachedBytesMax)
+                            {
+                                return;
+                            }
+                            // The loop ends at the latest when the cache is empty because the buffer is not larger than cachedBytesMax.
+                            while((m_buffers.size() >= bufferCountMax) || (m_cachedBytes + buffer.m_sizeBytes > cachedBytesMax))
+                            {
+                                // Drop the smallest buffer.
+                                auto itSmallest(m_buffers.begin());
+                                for(auto it(m_buffers.begin()); it != m_buffers.end(); ++it)
+                                {
+                                    if(it->m_sizeBytes < itSmallest->m_sizeBytes)
+                                    {
+                                        itSmallest = it;
+                                    }
+                                }
+                                if(itSmallest->m_sizeBytes >= buffer.m_sizeBytes)
+                                {
+                                    return;
+                                }
+                                m_cachedBytes -= itSmallest->m_sizeBytes;
+                                m_buffers.erase(itSmallest);
+                            }
+                            m_cachedBytes += buffer.m_sizeBytes;
+                            m_buffers.emplace_back(std::move(buffer));
+                        }
+                        //-----------------------------------------------------------------------------
+                        //! \return The number of bytes currently held by the cache.
+                        auto getCachedBytes() const
+                        -> std::size_t
+                        {
+                            return m_cachedBytes;
+                        }
+
+                    private:
+                        std::vector<Buffer> m_buffers;
+                        std::size_t m_cachedBytes;
+                    };
+
+                    //-----------------------------------------------------------------------------
+                    //! \return The block shared dynamic memory cache of the calling thread.
+                    inline auto getBlockSharedMemDynCache()
+                    -> BlockSharedMemDynCache &
+                    {
+#if BOOST_COMP_CLANG
+    #pragma clang diagnostic push
+    #pragma clang diagnostic ignored "-Wexit-time-destructors"
+#endif
+                        thread_local BlockSharedMemDynCache cache;
+#if BOOST_COMP_CLANG
+    #pragma clang diagnostic pop
+#endif
+                        return cache;
+                    }
+                }
+
                 //#############################################################################
                 //! The block shared dynamic memory allocator without synchronization.
+                //!
+                //! The memory is taken from the block shared dynamic memory cache of the thread creating the accelerator.
+                //! It is returned to the cache of the thread destroying the accelerator.
                 class BlockSharedMemDynBoostAlignedAlloc
                 {
                 public:
@@ -36,13 +191,14 @@ namespace alpaka
 
                     //-----------------------------------------------------------------------------
                     BlockSharedMemDynBoostAlignedAlloc(
-                        std::size_t const & blockSharedMemDynSizeBytes)
+                        std::size_t const & blockSharedMemDynSizeBytes) :
+                            m_buffer{nullptr, 0u},
+                            m_blockSharedMemDyn(nullptr)
                     {
                         if(blockSharedMemDynSizeBytes > 0u)
                         {
-                            m_blockSharedMemDyn.reset(
-                                reinterpret_cast<uint8_t *>(
-                                    boost::alignment::aligned_alloc(core::vectorization::defaultAlignment, blockSharedMemDynSizeBytes)));
+                            m_buffer = detail::getBlockSharedMemDynCache().acquire(blockSharedMemDynSizeBytes);
+                            m_blockSharedMemDyn = m_buffer.m_pMem.get();
                         }
                     }
                     //-----------------------------------------------------------------------------
@@ -54,13 +210,16 @@ namespace alpaka
                     //-----------------------------------------------------------------------------
                     auto operator=(BlockSharedMemDynBoostAlignedAlloc &&) -> BlockSharedMemDynBoostAlignedAlloc & = delete;
                     //-----------------------------------------------------------------------------
-                    /*virtual*/ ~BlockSharedMemDynBoostAlignedAlloc() = default;
+                    /*virtual*/ ~BlockSharedMemDynBoostAlignedAlloc()
+                    {
+                        detail::getBlockSharedMemDynCache().release(std::move(m_buffer));
+                    }
+
+                private:
+                    detail::BlockSharedMemDynCache::Buffer m_buffer;
 
                 public:
-                    std::unique_ptr<
-                        uint8_t,
-                        boost::alignment::aligned_delete> mutable
-                            m_blockSharedMemDyn;  //!< Block shared dynamic memory.
+                    uint8_t * m_blockSharedMemDyn;  //!< Block shared dynamic memory.
                 };
 
                 namespace traits
@@ -85,7 +244,7 @@ namespace alpaka
                                 core::vectorization::defaultAlignment >= alignof(T),
                                 "Unable to get block shared dynamic memory for types with alignment higher than defaultAlignment!");
 
-                            return reinterpret_cast<T*>(blockSharedMemDyn.m_blockSharedMemDyn.get());
+                            return reinterpret_cast<T*>(blockSharedMemDyn.m_blockSharedMemDyn);
                         }
                     };
 #if BOOST_COMP_GNUC
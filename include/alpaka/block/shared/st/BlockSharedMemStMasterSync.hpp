@@ -12,13 +12,25 @@
 #include <alpaka/core/Vectorize.hpp>
 #include <alpaka/block/shared/st/Traits.hpp>
 
+#include <alpaka/core/Assert.hpp>
 #include <alpaka/core/Common.hpp>
 
 #include <boost/align.hpp>
 
-#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
-#include <functional>
+#include <mutex>
+#include <new>
+#include <vector>
+
+//! The size of the block shared static memory arena allocated when the first variable of a block is requested.
+//! The arena grows if it is too small and is resized to the required size for the following blocks.
+#ifndef ALPAKA_BLOCK_SHARED_ST_ARENA_SIZE_BYTES
+    #define ALPAKA_BLOCK_SHARED_ST_ARENA_SIZE_BYTES 16384u
+#endif
 
 namespace alpaka
 {
@@ -29,18 +41,39 @@ namespace alpaka
             namespace st
             {
                 //#############################################################################
-                //! The block shared memory allocator allocating memory with synchronization on the master thread.
+                //! The block shared memory allocator for accelerators with multiple threads per block.
+                //!
+                //! The variables are bump-allocated from an arena that is reset, not freed, between blocks.
+                //! The location of each variable is looked up by its key in a table that is kept for all blocks executed with the accelerator.
+                //! The key is unique for each combination of the type and the TuniqueId, so a helper template instantiated with different types gets distinct variables like with the CUDA allocator.
+                //! Only the first request of a key takes a lock, all following requests (of all blocks) are a lock-free table lookup.
+                //! In contrast to an allocation by a master thread no block synchronization is required.
                 class BlockSharedMemStMasterSync
                 {
                 public:
                     using BlockSharedMemStBase = BlockSharedMemStMasterSync;
 
+                    //#############################################################################
+                    //! The location of a variable in the arena.
+                    struct Entry
+                    {
+                        void const * m_pKey;
+                        std::size_t m_sizeBytes;
+                        std::uint8_t * m_pMem;
+                    };
+
+                    //! The number of entries that can be looked up without taking the lock.
+                    static constexpr std::size_t entryCountMaxLockFree = 64u;
+
                     //-----------------------------------------------------------------------------
-                    BlockSharedMemStMasterSync(
-                        std::function<void()> fnSync,
-                        std::function<bool()> fnIsMasterThread) :
-                            m_syncFn(fnSync),
-                            m_isMasterThreadFn(fnIsMasterThread)
+                    //! \param arenaSizeBytes The initial size of the arena.
+                    explicit BlockSharedMemStMasterSync(
+                        std::size_t const arenaSizeBytes = ALPAKA_BLOCK_SHARED_ST_ARENA_SIZE_BYTES) :
+                            m_entryCount(0u),
+                            m_arenaSizeBytes(arenaSizeBytes),
+                            m_requiredSizeBytes(0u),
+                            m_chunkOffsetBytes(0u),
+                            m_chunkSizeBytes(0u)
                     {}
                     //-----------------------------------------------------------------------------
                     BlockSharedMemStMasterSync(BlockSharedMemStMasterSync const &) = delete;
@@ -53,17 +86,144 @@ namespace alpaka
                     //-----------------------------------------------------------------------------
                     /*virtual*/ ~BlockSharedMemStMasterSync() = default;
 
-                public:
-                    // TODO: We should add the size of the (current) allocation.
-                    // This would allow to assert that all parallel function calls request to allocate the same size.
+                    //-----------------------------------------------------------------------------
+                    //! \return The memory of the variable with the given key or nullptr if it has not been allocated yet.
+                    //! Only the entries visible without the lock are searched.
+                    auto findLockFree(
+                        void const * const pKey) const
+                    -> std::uint8_t *
+                    {
+                        auto const entryCount(m_entryCount.load(std::memory_order_acquire));
+                        for(std::size_t i(0u); i < entryCount; ++i)
+                        {
+                            if(m_entries[i].m_pKey == pKey)
+                            {
+                                return m_entries[i].m_pMem;
+                            }
+                        }
+                        return nullptr;
+                    }
+                    //-----------------------------------------------------------------------------
+                    //! \return The memory of the variable with the given key. It is allocated if this is the first request.
+                    auto findOrAlloc(
+                        void const * const pKey,
+                        std::size_t const sizeBytes,
+                        std::size_t const alignmentBytes) const
+                    -> std::uint8_t *
+                    {
+                        std::lock_guard<std::mutex> lock(m_mtxAlloc);
+
+                        // Another thread could have allocated the variable while this thread was waiting for the lock.
+                        auto const entryCount(m_entryCount.load(std::memory_order_relaxed));
+                        for(std::size_t i(0u); i < entryCount; ++i)
+                        {
+                            if(m_entries[i].m_pKey == pKey)
+                            {
+                                ALPAKA_ASSERT(m_entries[i].m_sizeBytes == sizeBytes);
+                                return m_entries[i].m_pMem;
+                            }
+                        }
+                        for(auto const & entry : m_entriesOverflow)
+                        {
+                            if(entry.m_pKey == pKey)
+                            {
+                                ALPAKA_ASSERT(entry.m_sizeBytes == sizeBytes);
+                                return entry.m_pMem;
+                            }
+                        }
+
+                        auto * const pMem(bumpAlloc(sizeBytes, alignmentBytes));
+
+                        Entry const entry{pKey, sizeBytes, pMem};
+                        if(entryCount < entryCountMaxLockFree)
+                        {
+                            m_entries[entryCount] = entry;
+                            // Publish the entry to the lock-free lookup.
+                            m_entryCount.store(entryCount + 1u, std::memory_order_release);
+                        }
+                        else
+                        {
+                            m_entriesOverflow.push_back(entry);
+                        }
+                        return pMem;
+                    }
+                    //-----------------------------------------------------------------------------
+                    //! Resets the arena after a block has been executed.
+                    //!
+                    //! The memory and the variable locations are kept for the next block.
+                    //! Only if the arena had to grow during the block, it is replaced lazily by a single chunk of the required size.
+                    //! This must not be called while any thread of a block is executing.
+                    auto reset() const
+                    -> void
+                    {
+                        if(m_chunks.size() > 1u)
+                        {
+                            m_arenaSizeBytes = std::max(m_arenaSizeBytes, m_requiredSizeBytes);
+                            m_chunks.clear();
+                            m_chunkOffsetBytes = 0u;
+                            m_chunkSizeBytes = 0u;
+                            m_requiredSizeBytes = 0u;
+                            m_entryCount.store(0u, std::memory_order_relaxed);
+                            m_entriesOverflow.clear();
+                        }
+                    }
+
+                private:
+                    //-----------------------------------------------------------------------------
+                    //! Allocates the given number of bytes from the arena. Has to be called with the lock held.
+                    auto bumpAlloc(
+                        std::size_t const sizeBytes,
+                        std::size_t const alignmentBytes) const
+                    -> std::uint8_t *
+                    {
+                        // An upper bound of the size required to hold all variables in a single chunk.
+                        m_requiredSizeBytes += sizeBytes + alignmentBytes;
+
+                        if(!m_chunks.empty())
+                        {
+                            auto * const pChunk(m_chunks.back().get());
+                            auto * const pMem(
+                                reinterpret_cast<std::uint8_t *>(
+                                    boost::alignment::align_up(pChunk + m_chunkOffsetBytes, alignmentBytes)));
+                            auto const offsetBytes(static_cast<std::size_t>(pMem - pChunk));
+                            if(offsetBytes + sizeBytes <= m_chunkSizeBytes)
+                            {
+                                m_chunkOffsetBytes = offsetBytes + sizeBytes;
+                                return pMem;
+                            }
+                        }
+
+                        // The memory handed out before has to stay valid, so a new chunk is added instead of growing the current one.
+                        auto const chunkSizeBytes(std::max(
+                            m_chunks.empty() ? m_arenaSizeBytes : m_chunkSizeBytes,
+                            sizeBytes));
+                        auto * const pChunk(
+                            reinterpret_cast<std::uint8_t *>(
+                                boost::alignment::aligned_alloc(std::max(alignmentBytes, core::vectorization::defaultAlignment), chunkSizeBytes)));
+                        if(pChunk == nullptr)
+                        {
+                            throw std::bad_alloc();
+                        }
+                        m_chunks.emplace_back(pChunk);
+                        m_chunkOffsetBytes = sizeBytes;
+                        m_chunkSizeBytes = chunkSizeBytes;
+                        return pChunk;
+                    }
+
+                    std::atomic<std::size_t> mutable m_entryCount;
+                    Entry mutable m_entries[entryCountMaxLockFree];
+                    std::vector<Entry> mutable m_entriesOverflow;
+
+                    std::mutex mutable m_mtxAlloc;
+                    std::size_t mutable m_arenaSizeBytes;
+                    std::size_t mutable m_requiredSizeBytes;
                     std::vector<
                         std::unique_ptr<
-                            uint8_t,
+                            std::uint8_t,
                             boost::alignment::aligned_delete>> mutable
-                        m_sharedAllocs;
-
-                    std::function<void()> m_syncFn;
-                    std::function<bool()> m_isMasterThreadFn;
+                        m_chunks;
+                    std::size_t mutable m_chunkOffsetBytes;
+                    std::size_t mutable m_chunkSizeBytes;
                 };
 
                 namespace traits
@@ -89,21 +249,24 @@ namespace alpaka
                             // TODO: replace with constexpr std::max in C++14
                             constexpr std::size_t alignmentInBytes = (core::vectorization::defaultAlignment < alignof(T)) ? alignof(T) : core::vectorization::defaultAlignment;
 
-                            // Assure that all threads have executed the return of the last allocBlockSharedArr function (if there was one before).
-                            blockSharedMemSt.m_syncFn();
-
-                            if(blockSharedMemSt.m_isMasterThreadFn())
+                            auto * pMem(blockSharedMemSt.findLockFree(getKey()));
+                            if(pMem == nullptr)
                             {
-                                blockSharedMemSt.m_sharedAllocs.emplace_back(
-                                    reinterpret_cast<uint8_t *>(
-                                        boost::alignment::aligned_alloc(alignmentInBytes, sizeof(T))));
+                                pMem = blockSharedMemSt.findOrAlloc(getKey(), sizeof(T), alignmentInBytes);
                             }
-                            blockSharedMemSt.m_syncFn();
 
-                            return
-                                std::ref(
-                                    *reinterpret_cast<T*>(
-                                        blockSharedMemSt.m_sharedAllocs.back().get()));
+                            return *reinterpret_cast<T*>(pMem);
+                        }
+
+                    private:
+                        //-----------------------------------------------------------------------------
+                        //! \return The key of the variable. Each instantiation has its own key object, so the address is unique for the type and the id.
+                        ALPAKA_FN_HOST static auto getKey()
+                        -> void const *
+                        {
+                            // Not const so that it can not be merged with identical constants.
+                            static char key(0);
+                            return &key;
                         }
                     };
 #if BOOST_COMP_GNUC
@@ -119,7 +282,7 @@ namespace alpaka
                             block::shared::st::BlockSharedMemStMasterSync const & blockSharedMemSt)
                         -> void
                         {
-                            blockSharedMemSt.m_sharedAllocs.clear();
+                            blockSharedMemSt.reset();
                         }
                     };
                 }
@@ -16,8 +16,10 @@
 
 #include <boost/align.hpp>
 
+#include <cstdint>
 #include <vector>
 #include <memory>
+#include <utility>
 
 namespace alpaka
 {
@@ -29,6 +31,9 @@ namespace alpaka
             {
                 //#############################################################################
                 //! The block shared memory allocator without synchronization.
+                //!
+                //! Each variable is allocated on its first request within a block.
+                //! Further requests with the same type and TuniqueId return the same memory like the other allocators.
                 class BlockSharedMemStNoSync
                 {
                 public:
@@ -48,12 +53,13 @@ namespace alpaka
                     /*virtual*/ ~BlockSharedMemStNoSync() = default;
 
                 public:
-                    // TODO: We should add the size of the (current) allocation.
-                    // This would allow to assert that all parallel function calls request to allocate the same size.
+                    //! The variables of the current block with the key identifying them.
                     std::vector<
-                        std::unique_ptr<
-                            uint8_t,
-                            boost::alignment::aligned_delete>> mutable
+                        std::pair<
+                            void const *,
+                            std::unique_ptr<
+                                uint8_t,
+                                boost::alignment::aligned_delete>>> mutable
                         m_sharedAllocs;
                 };
 
@@ -80,13 +86,34 @@ namespace alpaka
                             // TODO: replace with constexpr std::max in C++14
                             constexpr std::size_t alignmentInBytes = (core::vectorization::defaultAlignment < alignof(T)) ? alignof(T) : core::vectorization::defaultAlignment;
 
+                            for(auto const & sharedAlloc : blockSharedMemSt.m_sharedAllocs)
+                            {
+                                if(sharedAlloc.first == getKey())
+                                {
+                                    return *reinterpret_cast<T*>(sharedAlloc.second.get());
+                                }
+                            }
+
                             blockSharedMemSt.m_sharedAllocs.emplace_back(
-                                reinterpret_cast<uint8_t *>(
-                                    boost::alignment::aligned_alloc(alignmentInBytes, sizeof(T))));
+                                getKey(),
+                                std::unique_ptr<uint8_t, boost::alignment::aligned_delete>(
+                                    reinterpret_cast<uint8_t *>(
+                                        boost::alignment::aligned_alloc(alignmentInBytes, sizeof(T)))));
                             return
                                 std::ref(
                                     *reinterpret_cast<T*>(
-                                        blockSharedMemSt.m_sharedAllocs.back().get()));
+                                        blockSharedMemSt.m_sharedAllocs.back().second.get()));
+                        }
+
+                    private:
+                        //-----------------------------------------------------------------------------
+                        //! \return The key of the variable. Each instantiation has its own key object, so the address is unique for the type and the id.
+                        ALPAKA_FN_HOST static auto getKey()
+                        -> void const *
+                        {
+                            // Not const so that it can not be merged with identical constants.
+                            static char key(0);
+                            return &key;
                         }
                     };
 #if BOOST_COMP_GNUC
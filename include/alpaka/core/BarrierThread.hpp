@@ -9,18 +9,19 @@
 
 #pragma once
 
-// Uncomment this to disable the standard spinlock behaviour of the threads
+// Uncomment this to disable the spinning of the threads waiting at a barrier by default.
+// The threads are then immediately parked until the last thread arrives.
 //#define ALPAKA_THREAD_BARRIER_DISABLE_SPINLOCK
 
 #include <alpaka/core/Common.hpp>
+#include <alpaka/core/Futex.hpp>
 #include <alpaka/block/sync/Traits.hpp>
 
-#include <mutex>
-#include <condition_variable>
-#ifndef ALPAKA_THREAD_BARRIER_DISABLE_SPINLOCK
-    #include <atomic>
-    #include <thread>
-#endif
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
 
 namespace alpaka
 {
@@ -28,8 +29,88 @@ namespace alpaka
     {
         namespace threads
         {
+            namespace detail
+            {
+                //-----------------------------------------------------------------------------
+                //! \return The storage of the number of spin iterations a thread waiting at a barrier executes before it is parked.
+                inline auto barrierSpinCount()
+                -> std::atomic<std::uint32_t> &
+                {
+#ifdef ALPAKA_THREAD_BARRIER_DISABLE_SPINLOCK
+                    static std::atomic<std::uint32_t> spinCount(0u);
+#else
+                    static std::atomic<std::uint32_t> spinCount(1024u);
+#endif
+                    return spinCount;
+                }
+                //-----------------------------------------------------------------------------
+                //! \return The number of hardware threads.
+                inline auto getHardwareConcurrency()
+                -> std::uint32_t
+                {
+                    // Querying the number of processors is not cheap on all systems.
+                    static std::uint32_t const hardwareConcurrency(std::max(std::thread::hardware_concurrency(), 1u));
+                    return hardwareConcurrency;
+                }
+                //-----------------------------------------------------------------------------
+                //! Spins for at most spinCount iterations and then parks the calling thread until the generation has changed.
+                inline auto waitForGenerationChange(
+                    Futex & generation,
+                    std::uint32_t const generationWhenEnteredTheWait,
+                    std::uint32_t const spinCount)
+                -> void
+                {
+                    for(std::uint32_t i(0u); i < spinCount; ++i)
+                    {
+                        if(generation.load(std::memory_order_acquire) != generationWhenEnteredTheWait)
+                        {
+                            return;
+                        }
+                        cpuRelax();
+                    }
+                    while(generation.load(std::memory_order_acquire) == generationWhenEnteredTheWait)
+                    {
+                        generation.wait(generationWhenEnteredTheWait);
+                    }
+                }
+                //-----------------------------------------------------------------------------
+                //! \return The default number of spin iterations for a barrier with the given number of threads.
+                inline auto getBarrierSpinCount(
+                    std::size_t const threadCount)
+                -> std::uint32_t
+                {
+                    return (threadCount <= getHardwareConcurrency())
+                        ? barrierSpinCount().load(std::memory_order_relaxed)
+                        : 0u;
+                }
+            }
+
+            //-----------------------------------------------------------------------------
+            //! Sets the number of spin iterations a thread waiting at a barrier executes before it is parked.
+            //!
+            //! A value of zero parks the waiting threads immediately.
+            //! The value is applied to all barriers created afterwards.
+            inline auto setBarrierSpinCount(
+                std::uint32_t const spinCount)
+            -> void
+            {
+                detail::barrierSpinCount().store(spinCount, std::memory_order_relaxed);
+            }
+            //-----------------------------------------------------------------------------
+            //! \return The number of spin iterations a thread waiting at a barrier executes before it is parked.
+            inline auto getBarrierSpinCount()
+            -> std::uint32_t
+            {
+                return detail::barrierSpinCount().load(std::memory_order_relaxed);
+            }
+
             //#############################################################################
             //! A self-resetting barrier.
+            //!
+            //! The barrier is sense-reversing: The threads wait for the generation counter to change.
+            //! A waiting thread first spins for a bounded number of iterations and is then parked on a futex.
+            //! This keeps the wake-up latency low for short waits without burning whole cores under oversubscription.
+            //! If there are more threads than hardware threads, spinning can not succeed and the threads are parked immediately.
             template<
                 typename TIdx>
             class BarrierThread final
@@ -38,9 +119,18 @@ namespace alpaka
                 //-----------------------------------------------------------------------------
                 explicit BarrierThread(
                     TIdx const & threadCount) :
+                    BarrierThread(
+                        threadCount,
+                        detail::getBarrierSpinCount(static_cast<std::size_t>(threadCount)))
+                {}
+                //-----------------------------------------------------------------------------
+                BarrierThread(
+                    TIdx const & threadCount,
+                    std::uint32_t const spinCount) :
                     m_threadCount(threadCount),
+                    m_spinCount(spinCount),
                     m_curThreadCount(threadCount),
-                    m_generation(0)
+                    m_generation(0u)
                 {}
                 //-----------------------------------------------------------------------------
                 BarrierThread(BarrierThread const &) = delete;
@@ -58,86 +148,85 @@ namespace alpaka
                 auto wait()
                 -> void
                 {
-                    TIdx const generationWhenEnteredTheWait = m_generation;
-#ifdef ALPAKA_THREAD_BARRIER_DISABLE_SPINLOCK
-                    std::unique_lock<std::mutex> lock(m_mtxBarrier);
-#endif
-                    if(--m_curThreadCount == 0)
+                    // The generation has to be read before the arrival is signaled.
+                    // Otherwise the last thread could already have started the next generation.
+                    std::uint32_t const generationWhenEnteredTheWait(m_generation.load(std::memory_order_acquire));
+
+                    if(m_curThreadCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
                     {
-                        m_curThreadCount = m_threadCount;
-                        ++m_generation;
-#ifdef ALPAKA_THREAD_BARRIER_DISABLE_SPINLOCK
-                        m_cvAllThreadsReachedBarrier.notify_all();
-#endif
+                        // The counter is reset before the generation is released so that threads of the next generation see the full count.
+                        m_curThreadCount.store(m_threadCount, std::memory_order_relaxed);
+                        m_generation.store(generationWhenEnteredTheWait + 1u, std::memory_order_seq_cst);
+                        m_generation.notifyAll();
                     }
                     else
                     {
-#ifdef ALPAKA_THREAD_BARRIER_DISABLE_SPINLOCK
-                        m_cvAllThreadsReachedBarrier.wait(lock, [this, generationWhenEnteredTheWait] { return generationWhenEnteredTheWait != m_generation; });
-#else
-                        while(generationWhenEnteredTheWait == m_generation)
-                        {
-                            std::this_thread::yield();
-                        }
-#endif
+                        detail::waitForGenerationChange(m_generation, generationWhenEnteredTheWait, m_spinCount);
                     }
                 }
 
             private:
-#ifdef ALPAKA_THREAD_BARRIER_DISABLE_SPINLOCK
-                std::mutex m_mtxBarrier;
-                std::condition_variable m_cvAllThreadsReachedBarrier;
-#endif
-                const TIdx m_threadCount;
-#ifdef ALPAKA_THREAD_BARRIER_DISABLE_SPINLOCK
-                TIdx m_curThreadCount;
-                TIdx m_generation;
-#else
+                TIdx const m_threadCount;
+                std::uint32_t const m_spinCount;
                 std::atomic<TIdx> m_curThreadCount;
-                std::atomic<TIdx> m_generation;
-#endif
+                Futex m_generation;
             };
 
             namespace detail
             {
                 //#############################################################################
+                //! Derives the result of the predicate reduction from the number of threads with a true predicate.
                 template<
                     typename TOp>
-                struct AtomicOp;
+                struct PredicateResult;
                 //#############################################################################
                 template<>
-                struct AtomicOp<
+                struct PredicateResult<
                     block::sync::op::Count>
                 {
-                    void operator()(std::atomic<int>& result, bool value)
+                    template<
+                        typename TIdx>
+                    static auto get(TIdx const & trueCount, TIdx const &)
+                    -> int
                     {
-                        result += static_cast<int>(value);
+                        return static_cast<int>(trueCount);
                     }
                 };
                 //#############################################################################
                 template<>
-                struct AtomicOp<
+                struct PredicateResult<
                     block::sync::op::LogicalAnd>
                 {
-                    void operator()(std::atomic<int>& result, bool value)
+                    template<
+                        typename TIdx>
+                    static auto get(TIdx const & trueCount, TIdx const & threadCount)
+                    -> int
                     {
-                        result &= static_cast<int>(value);
+                        return static_cast<int>(trueCount == threadCount);
                     }
                 };
                 //#############################################################################
                 template<>
-                struct AtomicOp<
+                struct PredicateResult<
                     block::sync::op::LogicalOr>
                 {
-                    void operator()(std::atomic<int>& result, bool value)
+                    template<
+                        typename TIdx>
+                    static auto get(TIdx const & trueCount, TIdx const &)
+                    -> int
                     {
-                        result |= static_cast<int>(value);
+                        return static_cast<int>(trueCount != static_cast<TIdx>(0));
                     }
                 };
             }
 
             //#############################################################################
-            //! A self-resetting barrier with barrier.
+            //! A self-resetting barrier with predicate reduction that does not use any lock.
+            //!
+            //! Each generation counts the threads with a true predicate in one of the two double-buffered result slots.
+            //! Counting is independent of the reduction operation, so the last arriving thread can reset the slot of the next generation
+            //! before it releases the waiting threads. All threads of the previous generation using this slot have already read their result at this point.
+            //! Waiting threads spin for a bounded number of iterations and are then parked like in BarrierThread.
             template<
                 typename TIdx>
             class BarrierThreadWithPredicate final
@@ -146,12 +235,24 @@ namespace alpaka
                 //-----------------------------------------------------------------------------
                 explicit BarrierThreadWithPredicate(
                     TIdx const & threadCount) :
+                    BarrierThreadWithPredicate(
+                        threadCount,
+                        detail::getBarrierSpinCount(static_cast<std::size_t>(threadCount)))
+                {}
+                //-----------------------------------------------------------------------------
+                BarrierThreadWithPredicate(
+                    TIdx const & threadCount,
+                    std::uint32_t const spinCount) :
                     m_threadCount(threadCount),
+                    m_spinCount(spinCount),
                     m_curThreadCount(threadCount),
-                    m_generation(0)
-                {}
+                    m_generation(0u)
+                {
+                    m_trueCount[0u].store(static_cast<TIdx>(0), std::memory_order_relaxed);
+                    m_trueCount[1u].store(static_cast<TIdx>(0), std::memory_order_relaxed);
+                }
                 //-----------------------------------------------------------------------------
-                BarrierThreadWithPredicate(BarrierThreadWithPredicate const & other) = delete;
+                BarrierThreadWithPredicate(BarrierThreadWithPredicate const &) = delete;
                 //-----------------------------------------------------------------------------
                 BarrierThreadWithPredicate(BarrierThreadWithPredicate &&) = delete;
                 //-----------------------------------------------------------------------------
@@ -163,45 +264,44 @@ namespace alpaka
 
                 //-----------------------------------------------------------------------------
                 //! Waits for all the other threads to reach the barrier.
+                //! \return The reduction of the predicates of all threads.
                 template<
                     typename TOp>
                 ALPAKA_FN_HOST auto wait(int predicate)
                 -> int
                 {
-                    TIdx const generationWhenEnteredTheWait = m_generation;
-                    std::unique_lock<std::mutex> lock(m_mtxBarrier);
+                    std::uint32_t const generationWhenEnteredTheWait(m_generation.load(std::memory_order_acquire));
+                    std::atomic<TIdx> & trueCount(m_trueCount[generationWhenEnteredTheWait % 2u]);
 
-                    auto const generationMod2(m_generation % static_cast<TIdx>(2u));
-                    if(m_curThreadCount == m_threadCount)
+                    // The increment is published to the last thread by the release of the arrival below.
+                    if(predicate != 0)
                     {
-                        m_result[generationMod2] = TOp::InitialValue;
+                        trueCount.fetch_add(static_cast<TIdx>(1), std::memory_order_relaxed);
                     }
 
-                    std::atomic<int>& result(m_result[generationMod2]);
-                    bool const predicateBool(predicate != 0);
-
-                    detail::AtomicOp<TOp>()(result, predicateBool);
-
-                    if(--m_curThreadCount == 0)
+                    if(m_curThreadCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
                     {
-                        m_curThreadCount = m_threadCount;
-                        ++m_generation;
-                        m_cvAllThreadsReachedBarrier.notify_all();
+                        m_trueCount[(generationWhenEnteredTheWait + 1u) % 2u].store(static_cast<TIdx>(0), std::memory_order_relaxed);
+                        m_curThreadCount.store(m_threadCount, std::memory_order_relaxed);
+                        m_generation.store(generationWhenEnteredTheWait + 1u, std::memory_order_seq_cst);
+                        m_generation.notifyAll();
                     }
                     else
                     {
-                        m_cvAllThreadsReachedBarrier.wait(lock, [this, generationWhenEnteredTheWait] { return generationWhenEnteredTheWait != m_generation; });
+                        detail::waitForGenerationChange(m_generation, generationWhenEnteredTheWait, m_spinCount);
                     }
-                    return m_result[generationMod2];
+
+                    return detail::PredicateResult<TOp>::get(
+                        trueCount.load(std::memory_order_relaxed),
+                        m_threadCount);
                 }
 
             private:
-                std::mutex m_mtxBarrier;
-                std::condition_variable m_cvAllThreadsReachedBarrier;
-                const TIdx m_threadCount;
-                TIdx m_curThreadCount;
-                TIdx m_generation;
-                std::atomic<int> m_result[2];
+                TIdx const m_threadCount;
+                std::uint32_t const m_spinCount;
+                std::atomic<TIdx> m_curThreadCount;
+                Futex m_generation;
+                std::atomic<TIdx> m_trueCount[2];
             };
         }
     }
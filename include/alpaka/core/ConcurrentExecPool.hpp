@@ -16,11 +16,16 @@
 // Therefore, we can not even parse those parts when compiling device code.
 //-----------------------------------------------------------------------------
 #include <alpaka/core/Common.hpp>
+#include <alpaka/core/ThreadAffinity.hpp>
+#include <alpaka/core/Unused.hpp>
+#include <alpaka/core/WorkStealingQueue.hpp>
 
 #include <boost/config.hpp>
 
 #include <queue>
 #include <mutex>
+#include <new>
+#include <type_traits>
 #include <stdexcept>
 #include <vector>
 #include <exception>
@@ -36,6 +41,12 @@ namespace alpaka
         namespace detail
         {
             //#############################################################################
+            //! A std::queue protected by a single mutex shared by all workers.
+            //!
+            //! This is the default task queue policy of the ConcurrentExecPool.
+            //! A task queue policy has to provide ensureWorkerCount, empty, push and pop (with the index of the popping worker).
+            //! All of them except ensureWorkerCount have to be callable concurrently.
+            //! See WorkStealingQueue for the alternative policy.
             template<
                 typename T>
             class ThreadSafeQueue :
@@ -46,10 +57,20 @@ namespace alpaka
                 ThreadSafeQueue()
                 {}
                 //-----------------------------------------------------------------------------
+                //! All workers share the same queue so there is nothing to do.
+                auto ensureWorkerCount(
+                    std::size_t const workerCount)
+                -> void
+                {
+                    alpaka::ignore_unused(workerCount);
+                }
+                //-----------------------------------------------------------------------------
                 //! \return If the queue is empty.
                 auto empty() const
                 -> bool
                 {
+                    std::lock_guard<std::mutex> lk(m_Mutex);
+
                     return std::queue<T>::empty();
                 }
                 //-----------------------------------------------------------------------------
@@ -76,14 +97,26 @@ namespace alpaka
                     }
                     else
                     {
-                        t = std::queue<T>::front();
+                        t = std::move(std::queue<T>::front());
                         std::queue<T>::pop();
                         return true;
                     }
                 }
+                //-----------------------------------------------------------------------------
+                //! Pops the given value from the front of the queue.
+                //! The index of the popping worker is ignored.
+                auto pop(
+                    std::size_t const workerIdx,
+                    T & t)
+                -> bool
+                {
+                    alpaka::ignore_unused(workerIdx);
+
+                    return pop(t);
+                }
 
             private:
-                std::mutex m_Mutex;
+                mutable std::mutex m_Mutex;
             };
 
             //#############################################################################
@@ -118,6 +151,10 @@ namespace alpaka
                     }
                 }
 
+                //-----------------------------------------------------------------------------
+                //! Releases this task after it has been run or has received an exception.
+                virtual auto dispose() -> void = 0;
+
             private:
                 //-----------------------------------------------------------------------------
                 //! The execution function.
@@ -137,6 +174,22 @@ namespace alpaka
     #pragma clang diagnostic pop
 #endif
 
+            //#############################################################################
+            //! Disposes a task package instead of deleting it.
+            struct TaskPkgDisposer
+            {
+                //-----------------------------------------------------------------------------
+                auto operator()(
+                    ITaskPkg * const pTaskPkg) const
+                -> void
+                {
+                    pTaskPkg->dispose();
+                }
+            };
+            //#############################################################################
+            //! The exclusive ownership of a task package.
+            using UniqueTaskPkg = std::unique_ptr<ITaskPkg, TaskPkgDisposer>;
+
             //#############################################################################
             template<
                 template<typename TFnObjReturn> class TPromise,
@@ -164,6 +217,13 @@ namespace alpaka
                         m_Promise(),
                         m_FnObj(std::move(func))
                 {}
+                //-----------------------------------------------------------------------------
+                //! The task package has been allocated by the pool exclusively for this task.
+                virtual auto dispose()
+                -> void final
+                {
+                    delete this;
+                }
 
             private:
                 //-----------------------------------------------------------------------------
@@ -213,6 +273,13 @@ namespace alpaka
                         m_Promise(),
                         m_FnObj(std::move(func))
                 {}
+                //-----------------------------------------------------------------------------
+                //! The task package has been allocated by the pool exclusively for this task.
+                virtual auto dispose()
+                -> void final
+                {
+                    delete this;
+                }
 
             private:
                 //-----------------------------------------------------------------------------
@@ -242,6 +309,374 @@ namespace alpaka
                 typename std::remove_reference<TFnObj>::type m_FnObj;
             };
 
+            //#############################################################################
+            //! A countdown latch to wait for the completion of a group of tasks without futures.
+            //!
+            //! The latch can be reused after wait has returned.
+            //!
+            //! \tparam TMutex The mutex type used for locking.
+            //! \tparam TCondVar The condition variable type used to wait for the completion.
+            template<
+                typename TMutex,
+                typename TCondVar>
+            class TaskLatch final
+            {
+            public:
+                //-----------------------------------------------------------------------------
+                TaskLatch() :
+                    m_count(0u),
+                    m_mtx(),
+                    m_cv()
+// Workaround: Clang can not support this when natively compiling device code. See ConcurrentExecPool.hpp.
+#if !(BOOST_COMP_CLANG_CUDA && BOOST_ARCH_PTX)
+                    , m_exceptPtr()
+#endif
+                {}
+                //-----------------------------------------------------------------------------
+                TaskLatch(TaskLatch const &) = delete;
+                //-----------------------------------------------------------------------------
+                TaskLatch(TaskLatch &&) = delete;
+                //-----------------------------------------------------------------------------
+                auto operator=(TaskLatch const &) -> TaskLatch & = delete;
+                //-----------------------------------------------------------------------------
+                auto operator=(TaskLatch &&) -> TaskLatch & = delete;
+
+                //-----------------------------------------------------------------------------
+                //! Registers one more task the latch has to wait for.
+                auto add()
+                -> void
+                {
+                    m_count.fetch_add(1u, std::memory_order_relaxed);
+                }
+                //-----------------------------------------------------------------------------
+                //! Signals the completion of one task.
+                auto countDown()
+                -> void
+                {
+                    // Only the last count down has to lock the mutex.
+                    auto count(m_count.load(std::memory_order_relaxed));
+                    while(count > 1u)
+                    {
+                        if(m_count.compare_exchange_weak(count, count - 1u, std::memory_order_release, std::memory_order_relaxed))
+                        {
+                            return;
+                        }
+                    }
+
+                    // The last decrement has to be done while holding the mutex.
+                    // Otherwise, the waiting thread could destroy the latch before it is notified.
+                    std::lock_guard<TMutex> lock(m_mtx);
+                    m_count.fetch_sub(1u, std::memory_order_release);
+                    m_cv.notify_all();
+                }
+                //-----------------------------------------------------------------------------
+                //! Waits until all registered tasks have counted down.
+                auto wait()
+                -> void
+                {
+                    std::unique_lock<TMutex> lock(m_mtx);
+                    m_cv.wait(lock, [this](){return m_count.load(std::memory_order_acquire) == 0u;});
+                }
+// Workaround: Clang can not support this when natively compiling device code. See ConcurrentExecPool.hpp.
+#if !(BOOST_COMP_CLANG_CUDA && BOOST_ARCH_PTX)
+                //-----------------------------------------------------------------------------
+                //! Stores the exception of a task (only the first one is kept) and counts down.
+                auto setException(
+                    std::exception_ptr const & exceptPtr)
+                -> void
+                {
+                    {
+                        std::lock_guard<TMutex> lock(m_mtx);
+                        if(!m_exceptPtr)
+                        {
+                            m_exceptPtr = exceptPtr;
+                        }
+                    }
+                    countDown();
+                }
+                //-----------------------------------------------------------------------------
+                //! \return The first exception thrown by one of the tasks since the last call or a null pointer.
+                //! The latch does not keep the exception, so it can be reused for the next tasks.
+                //! Must only be called after wait has returned.
+                auto takeException()
+                -> std::exception_ptr
+                {
+                    std::lock_guard<TMutex> lock(m_mtx);
+                    std::exception_ptr exceptPtr;
+                    std::swap(exceptPtr, m_exceptPtr);
+                    return exceptPtr;
+                }
+#endif
+
+            private:
+                std::atomic<std::size_t> m_count;
+                TMutex m_mtx;
+                TCondVar m_cv;
+// Workaround: Clang can not support this when natively compiling device code. See ConcurrentExecPool.hpp.
+#if !(BOOST_COMP_CLANG_CUDA && BOOST_ARCH_PTX)
+                std::exception_ptr m_exceptPtr;
+#endif
+            };
+
+            class PooledTaskPkgCache;
+
+            //#############################################################################
+            //! A task package which is recycled instead of deleted and which signals its completion to a TaskLatch.
+            //!
+            //! Function objects up to inlineStorageSize bytes are stored in-place without any heap allocation.
+#if BOOST_COMP_CLANG
+    #pragma clang diagnostic push
+    #pragma clang diagnostic ignored "-Wweak-vtables"
+#endif
+            class PooledTaskPkg final :
+                public ITaskPkg
+            {
+                friend class PooledTaskPkgCache;
+
+            public:
+                static constexpr std::size_t inlineStorageSize = 128u;
+
+                //-----------------------------------------------------------------------------
+                explicit PooledTaskPkg(
+                    PooledTaskPkgCache & cache) :
+                        m_cache(cache),
+                        m_pNextReleased(nullptr),
+                        m_storage(),
+                        m_pfnInvoke(nullptr),
+                        m_pfnDestroy(nullptr),
+                        m_pLatch(nullptr),
+                        m_pfnCountDown(nullptr),
+// Workaround: Clang can not support this when natively compiling device code. See ConcurrentExecPool.hpp.
+#if !(BOOST_COMP_CLANG_CUDA && BOOST_ARCH_PTX)
+                        m_pfnSetException(nullptr),
+#endif
+                        m_pNumActiveTasks(nullptr)
+                {}
+                //-----------------------------------------------------------------------------
+                PooledTaskPkg(PooledTaskPkg const &) = delete;
+                //-----------------------------------------------------------------------------
+                PooledTaskPkg(PooledTaskPkg &&) = delete;
+                //-----------------------------------------------------------------------------
+                auto operator=(PooledTaskPkg const &) -> PooledTaskPkg & = delete;
+                //-----------------------------------------------------------------------------
+                auto operator=(PooledTaskPkg &&) -> PooledTaskPkg & = delete;
+                //-----------------------------------------------------------------------------
+                virtual ~PooledTaskPkg()
+                {
+                    destroyFnObj();
+                }
+
+                //-----------------------------------------------------------------------------
+                //! Stores the function object and the latch signaled on completion.
+                template<
+                    typename TFnObj,
+                    typename TLatchMutex,
+                    typename TLatchCondVar>
+                auto assign(
+                    TFnObj && fnObj,
+                    TaskLatch<TLatchMutex, TLatchCondVar> & latch,
+                    std::atomic<std::uint32_t> & numActiveTasks)
+                -> void
+                {
+                    using FnObj = typename std::decay<TFnObj>::type;
+                    using Latch = TaskLatch<TLatchMutex, TLatchCondVar>;
+
+                    emplaceFnObj<FnObj>(
+                        std::forward<TFnObj>(fnObj),
+                        std::integral_constant<
+                            bool,
+                            (sizeof(FnObj) <= inlineStorageSize) && (alignof(FnObj) <= alignof(Storage))>());
+
+                    m_pLatch = &latch;
+                    m_pfnCountDown = [](void * const pLatch){static_cast<Latch *>(pLatch)->countDown();};
+// Workaround: Clang can not support this when natively compiling device code. See ConcurrentExecPool.hpp.
+#if !(BOOST_COMP_CLANG_CUDA && BOOST_ARCH_PTX)
+                    m_pfnSetException =
+                        [](void * const pLatch, std::exception_ptr const & exceptPtr)
+                        {
+                            static_cast<Latch *>(pLatch)->setException(exceptPtr);
+                        };
+#endif
+                    m_pNumActiveTasks = &numActiveTasks;
+                }
+
+                //-----------------------------------------------------------------------------
+                //! Returns the task package to the cache it has been acquired from.
+                virtual auto dispose()
+                -> void final;
+
+            private:
+                //-----------------------------------------------------------------------------
+                //! The execution function.
+                virtual auto run()
+                -> void final
+                {
+                    m_pfnInvoke(&m_storage);
+                    // The function object is destroyed before the completion is signaled
+                    // because the waiting thread may free everything it references afterwards.
+                    destroyFnObj();
+                    --(*m_pNumActiveTasks);
+                    m_pfnCountDown(m_pLatch);
+                }
+            public:
+// Workaround: Clang can not support this when natively compiling device code. See ConcurrentExecPool.hpp.
+#if !(BOOST_COMP_CLANG_CUDA && BOOST_ARCH_PTX)
+                //-----------------------------------------------------------------------------
+                //! Sets an exception.
+                virtual auto setException(
+                    std::exception_ptr const & exceptPtr)
+                -> void final
+                {
+                    destroyFnObj();
+                    --(*m_pNumActiveTasks);
+                    m_pfnSetException(m_pLatch, exceptPtr);
+                }
+#endif
+
+            private:
+                //-----------------------------------------------------------------------------
+                //! Stores the function object in-place.
+                template<
+                    typename TFnObj,
+                    typename TFnObjFwd>
+                auto emplaceFnObj(
+                    TFnObjFwd && fnObj,
+                    std::true_type)
+                -> void
+                {
+                    new (&m_storage) TFnObj(std::forward<TFnObjFwd>(fnObj));
+                    m_pfnInvoke = [](void * const pStorage){(*static_cast<TFnObj *>(pStorage))();};
+                    m_pfnDestroy = [](void * const pStorage){static_cast<TFnObj *>(pStorage)->~TFnObj();};
+                }
+                //-----------------------------------------------------------------------------
+                //! Stores a pointer to a heap allocated copy of the function object because it is too large to be stored in-place.
+                template<
+                    typename TFnObj,
+                    typename TFnObjFwd>
+                auto emplaceFnObj(
+                    TFnObjFwd && fnObj,
+                    std::false_type)
+                -> void
+                {
+                    new (&m_storage) TFnObj *(new TFnObj(std::forward<TFnObjFwd>(fnObj)));
+                    m_pfnInvoke = [](void * const pStorage){(**static_cast<TFnObj **>(pStorage))();};
+                    m_pfnDestroy = [](void * const pStorage){delete *static_cast<TFnObj **>(pStorage);};
+                }
+                //-----------------------------------------------------------------------------
+                //! Destroys the stored function object if there is one.
+                auto destroyFnObj()
+                -> void
+                {
+                    if(m_pfnDestroy)
+                    {
+                        m_pfnDestroy(&m_storage);
+                        m_pfnDestroy = nullptr;
+                    }
+                }
+
+            private:
+                using Storage = typename std::aligned_storage<inlineStorageSize, alignof(std::max_align_t)>::type;
+
+                PooledTaskPkgCache & m_cache;
+                PooledTaskPkg * m_pNextReleased;
+
+                Storage m_storage;
+                void (* m_pfnInvoke)(void *);
+                void (* m_pfnDestroy)(void *);
+
+                void * m_pLatch;
+                void (* m_pfnCountDown)(void *);
+// Workaround: Clang can not support this when natively compiling device code. See ConcurrentExecPool.hpp.
+#if !(BOOST_COMP_CLANG_CUDA && BOOST_ARCH_PTX)
+                void (* m_pfnSetException)(void *, std::exception_ptr const &);
+#endif
+                std::atomic<std::uint32_t> * m_pNumActiveTasks;
+            };
+#if BOOST_COMP_CLANG
+    #pragma clang diagnostic pop
+#endif
+
+            //#############################################################################
+            //! Owns the PooledTaskPkg objects of a pool and recycles them.
+            //!
+            //! Acquiring is serialized by a mutex which is uncontended when there is only one submitting thread.
+            //! Workers release the packages lock-free onto a stack which is taken over as a whole by the next acquire that runs dry.
+            //! Taking the whole stack at once instead of popping single elements avoids the ABA problem.
+            //! New packages are only allocated until the number of packages in flight has been reached once.
+            class PooledTaskPkgCache final
+            {
+            public:
+                //-----------------------------------------------------------------------------
+                PooledTaskPkgCache() :
+                    m_mtxAcquire(),
+                    m_vAvailable(),
+                    m_vAll(),
+                    m_pReleased(nullptr)
+                {}
+                //-----------------------------------------------------------------------------
+                PooledTaskPkgCache(PooledTaskPkgCache const &) = delete;
+                //-----------------------------------------------------------------------------
+                PooledTaskPkgCache(PooledTaskPkgCache &&) = delete;
+                //-----------------------------------------------------------------------------
+                auto operator=(PooledTaskPkgCache const &) -> PooledTaskPkgCache & = delete;
+                //-----------------------------------------------------------------------------
+                auto operator=(PooledTaskPkgCache &&) -> PooledTaskPkgCache & = delete;
+
+                //-----------------------------------------------------------------------------
+                //! \return A task package which is exclusively owned by the caller until it is disposed.
+                auto acquire()
+                -> PooledTaskPkg *
+                {
+                    std::lock_guard<std::mutex> lock(m_mtxAcquire);
+
+                    if(m_vAvailable.empty())
+                    {
+                        auto * pTaskPkg(m_pReleased.exchange(nullptr, std::memory_order_acquire));
+                        while(pTaskPkg)
+                        {
+                            m_vAvailable.push_back(pTaskPkg);
+                            pTaskPkg = pTaskPkg->m_pNextReleased;
+                        }
+                    }
+
+                    if(m_vAvailable.empty())
+                    {
+                        m_vAll.emplace_back(new PooledTaskPkg(*this));
+                        return m_vAll.back().get();
+                    }
+
+                    auto * const pTaskPkg(m_vAvailable.back());
+                    m_vAvailable.pop_back();
+                    return pTaskPkg;
+                }
+                //-----------------------------------------------------------------------------
+                //! Returns the task package to the cache. Can be called by any thread.
+                auto release(
+                    PooledTaskPkg * const pTaskPkg)
+                -> void
+                {
+                    auto * pHead(m_pReleased.load(std::memory_order_relaxed));
+                    do
+                    {
+                        pTaskPkg->m_pNextReleased = pHead;
+                    }
+                    while(!m_pReleased.compare_exchange_weak(pHead, pTaskPkg, std::memory_order_release, std::memory_order_relaxed));
+                }
+
+            private:
+                std::mutex m_mtxAcquire;
+                std::vector<PooledTaskPkg *> m_vAvailable;
+                std::vector<std::unique_ptr<PooledTaskPkg>> m_vAll;
+                std::atomic<PooledTaskPkg *> m_pReleased;
+            };
+
+            //-----------------------------------------------------------------------------
+            inline auto PooledTaskPkg::dispose()
+            -> void
+            {
+                m_cache.release(this);
+            }
+
             //-----------------------------------------------------------------------------
             template<
                 typename TFnObj0,
@@ -282,6 +717,7 @@ namespace alpaka
             //! \tparam TMutex Unused. The mutex type used for locking threads.
             //! \tparam TCondVar Unused. The condition variable type used to make the threads wait if there is no work.
             //! \tparam TisYielding Boolean value if the threads should yield instead of wait for a condition variable.
+            //! \tparam TTaskQueue The task queue policy (ThreadSafeQueue or WorkStealingQueue).
             template<
                 typename TIdx,
                 typename TConcurrentExec,
@@ -289,7 +725,8 @@ namespace alpaka
                 typename TYield,
                 typename TMutex = void,
                 typename TCondVar = void,
-                bool TisYielding = true>
+                bool TisYielding = true,
+                template<typename TTask> class TTaskQueue = ThreadSafeQueue>
             class ConcurrentExecPool final
             {
             public:
@@ -302,6 +739,7 @@ namespace alpaka
                 ConcurrentExecPool(
                     TIdx concurrentExecutionCount) :
                     m_vConcurrentExecs(),
+                    m_taskPkgCache(),
                     m_qTasks(),
                     m_numActiveTasks(0u),
                     m_bShutdownFlag(false)
@@ -311,13 +749,7 @@ namespace alpaka
                         throw std::invalid_argument("The argument 'concurrentExecutionCount' has to be greate or equal to one!");
                     }
 
-                    m_vConcurrentExecs.reserve(static_cast<std::size_t>(concurrentExecutionCount));
-
-                    // Create all concurrent executors.
-                    for(TIdx concurrentExec(0u); concurrentExec < concurrentExecutionCount; ++concurrentExec)
-                    {
-                        m_vConcurrentExecs.emplace_back([this](){concurrentExecFn();});
-                    }
+                    ensureConcurrentExecutionCount(concurrentExecutionCount);
                 }
                 //-----------------------------------------------------------------------------
                 ConcurrentExecPool(ConcurrentExecPool const &) = delete;
@@ -338,15 +770,17 @@ namespace alpaka
 
                     joinAllConcurrentExecs();
 
-                    auto currentTaskPackage = std::shared_ptr<ITaskPkg>{nullptr};
+                    ITaskPkg * pCurrentTaskPackage(nullptr);
 
                     // Signal to each incomplete task that it will not complete due to pool destruction.
-                    while(popTask(currentTaskPackage))
+                    // All concurrent executors are joined so the first one can pop all remaining tasks.
+                    while(popTask(0u, pCurrentTaskPackage))
                     {
+                        UniqueTaskPkg upCurrentTaskPackage(pCurrentTaskPackage);
                         auto const except(std::runtime_error("Could not perform task before ConcurrentExecPool destruction"));
 // Workaround: Clang can not support this when natively compiling device code. See ConcurrentExecPool.hpp.
 #if !(BOOST_COMP_CLANG_CUDA && BOOST_ARCH_PTX)
-                        currentTaskPackage->setException(std::make_exception_ptr(except));
+                        upCurrentTaskPackage->setException(std::make_exception_ptr(except));
 #endif
                     }
                 }
@@ -378,31 +812,52 @@ namespace alpaka
 #endif
 #endif
                 {
-                    auto boundTask([=](){return task(args...);});
-                    auto decrementNumActiveTasks([this](){--m_numActiveTasks;});
-
+                    // The task and its arguments are copied only once into the task package.
                     auto extendedTask(
-                        [boundTask, decrementNumActiveTasks]()
+                        [=]()
                         {
                             return
                                 invokeBothReturnFirst(
-                                    std::move(boundTask),
-                                    std::move(decrementNumActiveTasks)
+                                    [&](){return task(args...);},
+                                    [this](){--m_numActiveTasks;}
                                 );
                         });
 
                     using TaskPackage = TaskPkg<TPromise, decltype(extendedTask)>;
-                    auto pTaskPackage(new TaskPackage(std::move(extendedTask)));
-                    std::shared_ptr<ITaskPkg> upTaskPackage(pTaskPackage);
+                    std::unique_ptr<TaskPackage> upTaskPackage(new TaskPackage(std::move(extendedTask)));
 
-                    auto future(pTaskPackage->m_Promise.get_future());
+                    auto future(upTaskPackage->m_Promise.get_future());
 
                     ++m_numActiveTasks;
-                    m_qTasks.push(std::move(upTaskPackage));
+                    m_qTasks.push(upTaskPackage.release());
 
                     return future;
                 }
                 //-----------------------------------------------------------------------------
+                //! Runs the given function on one of the pool without creating a future.
+                //! Once enough task packages have been recycled, no heap allocation is done
+                //! as long as the function object fits into PooledTaskPkg::inlineStorageSize bytes.
+                //!
+                //! \param latch    The latch counted down when the task has completed.
+                //!                 It also receives the exception if the task throws or the pool is destroyed before the task has run.
+                //! \param task     Function object to be called on the pool. Takes no arguments and returns void.
+                template<
+                    typename TLatchMutex,
+                    typename TLatchCondVar,
+                    typename TFnObj>
+                auto enqueueTaskWithLatch(
+                    TaskLatch<TLatchMutex, TLatchCondVar> & latch,
+                    TFnObj && task)
+                -> void
+                {
+                    auto * const pTaskPackage(m_taskPkgCache.acquire());
+                    pTaskPackage->assign(std::forward<TFnObj>(task), latch, m_numActiveTasks);
+
+                    latch.add();
+                    ++m_numActiveTasks;
+                    m_qTasks.push(pTaskPackage);
+                }
+                //-----------------------------------------------------------------------------
                 //! \return The number of concurrent executors available.
                 auto getConcurrentExecutionCount() const
                 -> TIdx
@@ -410,6 +865,31 @@ namespace alpaka
                     return m_vConcurrentExecs.size();
                 }
                 //-----------------------------------------------------------------------------
+                //! Grows the pool to at least the given number of concurrent executors.
+                //! Already existing concurrent executors are kept, the pool never shrinks.
+                //!
+                //! NOTE: This must not be called concurrently with itself or getConcurrentExecutionCount.
+                auto ensureConcurrentExecutionCount(
+                    TIdx concurrentExecutionCount)
+                -> void
+                {
+                    auto const concurrentExecutionCountOld(static_cast<TIdx>(m_vConcurrentExecs.size()));
+                    if(concurrentExecutionCount <= concurrentExecutionCountOld)
+                    {
+                        return;
+                    }
+
+                    m_vConcurrentExecs.reserve(static_cast<std::size_t>(concurrentExecutionCount));
+                    m_qTasks.ensureWorkerCount(static_cast<std::size_t>(concurrentExecutionCount));
+
+                    // Create the missing concurrent executors.
+                    for(TIdx concurrentExec(concurrentExecutionCountOld); concurrentExec < concurrentExecutionCount; ++concurrentExec)
+                    {
+                        auto const concurrentExecIdx(static_cast<std::size_t>(concurrentExec));
+                        m_vConcurrentExecs.emplace_back([this, concurrentExecIdx](){concurrentExecFn(concurrentExecIdx);});
+                    }
+                }
+                //-----------------------------------------------------------------------------
                 //! \return If the thread pool is idle.
                 auto isIdle() const
                 -> bool
@@ -420,17 +900,21 @@ namespace alpaka
             private:
                 //-----------------------------------------------------------------------------
                 //! The function the concurrent executors are executing.
-                void concurrentExecFn()
+                //!
+                //! \param concurrentExecIdx The index of the concurrent executor within the pool.
+                void concurrentExecFn(
+                    std::size_t const concurrentExecIdx)
                 {
                     // Checks whether pool is being destroyed, if so, stop running.
                     while(!m_bShutdownFlag.load(std::memory_order_relaxed))
                     {
-                        auto currentTaskPackage = std::shared_ptr<ITaskPkg>{nullptr};
+                        ITaskPkg * pCurrentTaskPackage(nullptr);
 
-                        // Use popTask so we only ever have one reference to the ITaskPkg
-                        if(popTask(currentTaskPackage))
+                        // The popped task is exclusively owned by this concurrent executor.
+                        if(popTask(concurrentExecIdx, pCurrentTaskPackage))
                         {
-                            currentTaskPackage->runTask();
+                            UniqueTaskPkg upCurrentTaskPackage(pCurrentTaskPackage);
+                            upCurrentTaskPackage->runTask();
                         }
                         else
                         {
@@ -451,10 +935,11 @@ namespace alpaka
                 //-----------------------------------------------------------------------------
                 //! Pops a task from the queue.
                 auto popTask(
-                    std::shared_ptr<ITaskPkg> & out)
+                    std::size_t const concurrentExecIdx,
+                    ITaskPkg * & out)
                 -> bool
                 {
-                    if(m_qTasks.pop(out))
+                    if(m_qTasks.pop(concurrentExecIdx, out))
                     {
                         return true;
                     }
@@ -463,26 +948,42 @@ namespace alpaka
 
             private:
                 std::vector<TConcurrentExec> m_vConcurrentExecs;
-                ThreadSafeQueue<std::shared_ptr<ITaskPkg>> m_qTasks;
+                PooledTaskPkgCache m_taskPkgCache;
+                TTaskQueue<ITaskPkg *> m_qTasks;
                 std::atomic<std::uint32_t> m_numActiveTasks;
                 std::atomic<bool> m_bShutdownFlag;
             };
 
+            //-----------------------------------------------------------------------------
+            //! \return The index of the calling thread within the ConcurrentExecPool waiting on a condition variable it belongs to.
+            //! It is 0 for all other threads.
+            inline auto currentConcurrentExecIdx()
+            -> std::size_t &
+            {
+                thread_local std::size_t concurrentExecIdx(0u);
+                return concurrentExecIdx;
+            }
+
             //#############################################################################
             //! ConcurrentExecPool using a condition variable to wait for new work.
             //!
+            //! Only concurrent executors running out of work lock the mutex of the condition variable.
+            //! Pushing a task locks it only if a concurrent executor is sleeping.
+            //!
             //! \tparam TConcurrentExec The type of concurrent executor (for example std::thread).
             //! \tparam TPromise The promise type returned by the task.
             //! \tparam TYield Unused. The type is required to have a static method "void yield()" to yield the current thread if there is no work.
             //! \tparam TMutex The mutex type used for locking threads.
             //! \tparam TCondVar The condition variable type used to make the threads wait if there is no work.
+            //! \tparam TTaskQueue The task queue policy (ThreadSafeQueue or WorkStealingQueue).
             template<
                 typename TIdx,
                 typename TConcurrentExec,
                 template<typename TFnObjReturn> class TPromise,
                 typename TYield,
                 typename TMutex,
-                typename TCondVar>
+                typename TCondVar,
+                template<typename TTask> class TTaskQueue>
             class ConcurrentExecPool<
                 TIdx,
                 TConcurrentExec,
@@ -490,7 +991,8 @@ namespace alpaka
                 TYield,
                 TMutex,
                 TCondVar,
-                false> final
+                false,
+                TTaskQueue> final
             {
             public:
                 //-----------------------------------------------------------------------------
@@ -502,24 +1004,23 @@ namespace alpaka
                 ConcurrentExecPool(
                     TIdx concurrentExecutionCount) :
                     m_vConcurrentExecs(),
+                    m_taskPkgCache(),
                     m_qTasks(),
                     m_numActiveTasks(0u),
+                    m_numIdleConcurrentExecs(0u),
                     m_mtxWakeup(),
                     m_cvWakeup(),
-                    m_bShutdownFlag(false)
+                    m_bShutdownFlag(false),
+                    m_affinityPolicy(),
+                    m_inheritedCpus(),
+                    m_affinityPolicyVersion(0u)
                 {
                     if(concurrentExecutionCount < 1)
                     {
                         throw std::invalid_argument("The argument 'concurrentExecutionCount' has to be greate or equal to one!");
                     }
 
-                    m_vConcurrentExecs.reserve(static_cast<std::size_t>(concurrentExecutionCount));
-
-                    // Create all concurrent executors.
-                    for(TIdx concurrentExec(0u); concurrentExec < concurrentExecutionCount; ++concurrentExec)
-                    {
-                        m_vConcurrentExecs.emplace_back([this](){concurrentExecFn();});
-                    }
+                    ensureConcurrentExecutionCount(concurrentExecutionCount);
                 }
                 //-----------------------------------------------------------------------------
                 ConcurrentExecPool(ConcurrentExecPool const &) = delete;
@@ -546,15 +1047,17 @@ namespace alpaka
 
                     joinAllConcurrentExecs();
 
-                    auto currentTaskPackage = std::shared_ptr<ITaskPkg>{nullptr};
+                    ITaskPkg * pCurrentTaskPackage(nullptr);
 
                     // Signal to each incomplete task that it will not complete due to pool destruction.
-                    while(popTask(currentTaskPackage))
+                    // All concurrent executors are joined so the first one can pop all remaining tasks.
+                    while(popTask(0u, pCurrentTaskPackage))
                     {
+                        UniqueTaskPkg upCurrentTaskPackage(pCurrentTaskPackage);
                         auto const except(std::runtime_error("Could not perform task before ConcurrentExecPool destruction"));
 // Workaround: Clang can not support this when natively compiling device code. See ConcurrentExecPool.hpp.
 #if !(BOOST_COMP_CLANG_CUDA && BOOST_ARCH_PTX)
-                        currentTaskPackage->setException(std::make_exception_ptr(except));
+                        upCurrentTaskPackage->setException(std::make_exception_ptr(except));
 #endif
                     }
                 }
@@ -586,36 +1089,54 @@ namespace alpaka
 #endif
 #endif
                 {
-                    auto boundTask([=](){return task(args...);});
-                    auto decrementNumActiveTasks([this](){--m_numActiveTasks;});
-
+                    // The task and its arguments are copied only once into the task package.
                     auto extendedTask(
-                        [boundTask, decrementNumActiveTasks]()
+                        [=]()
                         {
                             return
                                 invokeBothReturnFirst(
-                                    std::move(boundTask),
-                                    std::move(decrementNumActiveTasks)
+                                    [&](){return task(args...);},
+                                    [this](){--m_numActiveTasks;}
                                 );
                         });
 
                     using TaskPackage = TaskPkg<TPromise, decltype(extendedTask)>;
-                    auto pTaskPackage(new TaskPackage(std::move(extendedTask)));
-                    std::shared_ptr<ITaskPkg> upTaskPackage(pTaskPackage);
+                    std::unique_ptr<TaskPackage> upTaskPackage(new TaskPackage(std::move(extendedTask)));
 
-                    auto future(pTaskPackage->m_Promise.get_future());
+                    auto future(upTaskPackage->m_Promise.get_future());
 
                     ++m_numActiveTasks;
-                    {
-                        std::lock_guard<TMutex> lock(m_mtxWakeup);
-                        m_qTasks.push(std::move(upTaskPackage));
-
-                        m_cvWakeup.notify_one();
-                    }
+                    m_qTasks.push(upTaskPackage.release());
+                    wakeupConcurrentExec();
 
                     return future;
                 }
                 //-----------------------------------------------------------------------------
+                //! Runs the given function on one of the pool without creating a future.
+                //! Once enough task packages have been recycled, no heap allocation is done
+                //! as long as the function object fits into PooledTaskPkg::inlineStorageSize bytes.
+                //!
+                //! \param latch    The latch counted down when the task has completed.
+                //!                 It also receives the exception if the task throws or the pool is destroyed before the task has run.
+                //! \param task     Function object to be called on the pool. Takes no arguments and returns void.
+                template<
+                    typename TLatchMutex,
+                    typename TLatchCondVar,
+                    typename TFnObj>
+                auto enqueueTaskWithLatch(
+                    TaskLatch<TLatchMutex, TLatchCondVar> & latch,
+                    TFnObj && task)
+                -> void
+                {
+                    auto * const pTaskPackage(m_taskPkgCache.acquire());
+                    pTaskPackage->assign(std::forward<TFnObj>(task), latch, m_numActiveTasks);
+
+                    latch.add();
+                    ++m_numActiveTasks;
+                    m_qTasks.push(pTaskPackage);
+                    wakeupConcurrentExec();
+                }
+                //-----------------------------------------------------------------------------
                 //! \return The number of concurrent executors available.
                 auto getConcurrentExecutionCount() const
                 -> TIdx
@@ -623,41 +1144,127 @@ namespace alpaka
                     return m_vConcurrentExecs.size();
                 }
                 //-----------------------------------------------------------------------------
+                //! Grows the pool to at least the given number of concurrent executors.
+                //! Already existing concurrent executors are kept, the pool never shrinks.
+                //!
+                //! NOTE: This must not be called concurrently with itself or getConcurrentExecutionCount.
+                auto ensureConcurrentExecutionCount(
+                    TIdx concurrentExecutionCount)
+                -> void
+                {
+                    auto const concurrentExecutionCountOld(static_cast<TIdx>(m_vConcurrentExecs.size()));
+                    if(concurrentExecutionCount <= concurrentExecutionCountOld)
+                    {
+                        return;
+                    }
+
+                    m_vConcurrentExecs.reserve(static_cast<std::size_t>(concurrentExecutionCount));
+                    m_qTasks.ensureWorkerCount(static_cast<std::size_t>(concurrentExecutionCount));
+
+                    // Create the missing concurrent executors.
+                    for(TIdx concurrentExec(concurrentExecutionCountOld); concurrentExec < concurrentExecutionCount; ++concurrentExec)
+                    {
+                        auto const concurrentExecIdx(static_cast<std::size_t>(concurrentExec));
+                        m_vConcurrentExecs.emplace_back([this, concurrentExecIdx](){concurrentExecFn(concurrentExecIdx);});
+                    }
+                }
+                //-----------------------------------------------------------------------------
                 //! \return If the thread pool is idle.
                 auto isIdle() const
                 -> bool
                 {
                     return m_numActiveTasks == 0u;
                 }
+                //-----------------------------------------------------------------------------
+                //! Sets the affinity policy of the concurrent executors.
+                //!
+                //! Each concurrent executor pins itself to the CPUs the policy assigns to its index before it executes its next task.
+                //! Concurrent executors the policy assigns no CPUs to are restricted to the inherited CPUs instead.
+                //! If these are empty too, the concurrent executors pinned before get back their original CPUs.
+                //! This is only meaningful if the concurrent executors are threads.
+                //!
+                //! \param inheritedCpus The CPUs of the launching thread as returned by core::threads::getInheritedCpus.
+                auto setAffinityPolicy(
+                    core::threads::AffinityPolicy const & affinityPolicy,
+                    std::vector<std::uint32_t> const & inheritedCpus = std::vector<std::uint32_t>())
+                -> void
+                {
+                    std::unique_lock<TMutex> lock(m_mtxWakeup);
+
+                    if((affinityPolicy != m_affinityPolicy) || (inheritedCpus != m_inheritedCpus))
+                    {
+                        m_affinityPolicy = affinityPolicy;
+                        m_inheritedCpus = inheritedCpus;
+                        ++m_affinityPolicyVersion;
+                    }
+                }
 
             private:
                 //-----------------------------------------------------------------------------
                 //! The function the concurrent executors are executing.
-                void concurrentExecFn()
+                //!
+                //! \param concurrentExecIdx The index of the concurrent executor within the pool.
+                void concurrentExecFn(
+                    std::size_t const concurrentExecIdx)
                 {
+                    std::uint32_t affinityPolicyVersion(0u);
+                    currentConcurrentExecIdx() = concurrentExecIdx;
+
                     // Checks whether pool is being destroyed, if so, stop running (lazy check without mutex).
                     while(!m_bShutdownFlag)
                     {
-                        auto currentTaskPackage = std::shared_ptr<ITaskPkg>{nullptr};
+                        if(m_affinityPolicyVersion.load(std::memory_order_relaxed) != affinityPolicyVersion)
+                        {
+                            core::threads::AffinityPolicy affinityPolicy;
+                            std::vector<std::uint32_t> inheritedCpus;
+                            {
+                                std::unique_lock<TMutex> lock(m_mtxWakeup);
+                                affinityPolicy = m_affinityPolicy;
+                                inheritedCpus = m_inheritedCpus;
+                                affinityPolicyVersion = m_affinityPolicyVersion.load(std::memory_order_relaxed);
+                            }
+                            core::threads::pinCurrentThread(affinityPolicy, concurrentExecIdx, inheritedCpus);
+                        }
 
-                        // Use popTask so we only ever have one reference to the ITaskPkg
-                        if(popTask(currentTaskPackage))
+                        ITaskPkg * pCurrentTaskPackage(nullptr);
+
+                        // The popped task is exclusively owned by this concurrent executor.
+                        // As long as there are tasks, the mutex is not touched.
+                        if(popTask(concurrentExecIdx, pCurrentTaskPackage))
                         {
-                            currentTaskPackage->runTask();
+                            UniqueTaskPkg upCurrentTaskPackage(pCurrentTaskPackage);
+                            upCurrentTaskPackage->runTask();
+                            continue;
                         }
+
+                        // Announce going to sleep before checking for tasks a last time.
+                        // Either the pushing thread sees this executor as idle and notifies it or the check below sees the pushed task.
+                        // The read-modify-write operations on the idle count are totally ordered.
+                        // If the one in wakeupConcurrentExec comes first, this one synchronizes with it and the check sees the task.
+                        m_numIdleConcurrentExecs.fetch_add(1u, std::memory_order_acq_rel);
                         {
                             std::unique_lock<TMutex> lock(m_mtxWakeup);
-                            if(m_qTasks.empty())
-                            {
-                                // If the shutdown flag has been set since the last check, return now.
-                                if(m_bShutdownFlag)
-                                {
-                                    return;
-                                }
+                            m_cvWakeup.wait(lock, [this]() { return ((!m_qTasks.empty()) || m_bShutdownFlag); });
+                        }
+                        m_numIdleConcurrentExecs.fetch_sub(1u, std::memory_order_relaxed);
+                    }
+                }
 
-                                m_cvWakeup.wait(lock, [this]() { return ((!m_qTasks.empty()) || m_bShutdownFlag); });
-                            }
+                //-----------------------------------------------------------------------------
+                //! Wakes up one sleeping concurrent executor after a task has been pushed.
+                //! The mutex is only locked if at least one concurrent executor announced that it goes to sleep.
+                auto wakeupConcurrentExec()
+                -> void
+                {
+                    // A read-modify-write instead of a plain load orders the push with the announcement in concurrentExecFn.
+                    // Without it the load could miss an executor that has not seen the pushed task.
+                    if(m_numIdleConcurrentExecs.fetch_add(0u, std::memory_order_acq_rel) != 0u)
+                    {
+                        // Locking the mutex ensures that the sleeping executor is either waiting already or checks the queue after the push.
+                        {
+                            std::lock_guard<TMutex> lock(m_mtxWakeup);
                         }
+                        m_cvWakeup.notify_one();
                     }
                 }
 
@@ -673,10 +1280,11 @@ namespace alpaka
                 //-----------------------------------------------------------------------------
                 //! Pops a task from the queue.
                 auto popTask(
-                    std::shared_ptr<ITaskPkg> & out)
+                    std::size_t const concurrentExecIdx,
+                    ITaskPkg * & out)
                 -> bool
                 {
-                    if(m_qTasks.pop(out))
+                    if(m_qTasks.pop(concurrentExecIdx, out))
                     {
                         return true;
                     }
@@ -685,12 +1293,18 @@ namespace alpaka
 
             private:
                 std::vector<TConcurrentExec> m_vConcurrentExecs;
-                ThreadSafeQueue<std::shared_ptr<ITaskPkg>> m_qTasks;
+                PooledTaskPkgCache m_taskPkgCache;
+                TTaskQueue<ITaskPkg *> m_qTasks;
                 std::atomic<std::uint32_t> m_numActiveTasks;
+                std::atomic<std::size_t> m_numIdleConcurrentExecs;        //!< The number of concurrent executors sleeping or about to sleep on m_cvWakeup.
 
                 TMutex m_mtxWakeup;
                 TCondVar m_cvWakeup;
                 std::atomic<bool> m_bShutdownFlag;
+
+                core::threads::AffinityPolicy m_affinityPolicy;             //!< The affinity policy of the concurrent executors. Guarded by m_mtxWakeup.
+                std::vector<std::uint32_t> m_inheritedCpus;                 //!< The CPUs of the concurrent executors the policy assigns none to. Guarded by m_mtxWakeup.
+                std::atomic<std::uint32_t> m_affinityPolicyVersion;       //!< Incremented whenever the affinity policy changes.
             };
         }
     }
@@ -0,0 +1,211 @@
+/* Copyright 2019 Benjamin Worpitz
+ *
+ * This file is part of Alpaka.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <alpaka/core/BoostPredef.hpp>
+
+#if BOOST_OS_LINUX
+    #include <linux/futex.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#else
+    #include <condition_variable>
+    #include <mutex>
+#endif
+
+#if BOOST_ARCH_X86 && (BOOST_COMP_GNUC || BOOST_COMP_CLANG || BOOST_COMP_INTEL || BOOST_COMP_MSVC)
+    #include <immintrin.h>
+#endif
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+
+namespace alpaka
+{
+    namespace core
+    {
+        namespace threads
+        {
+            //-----------------------------------------------------------------------------
+            //! Hints the processor that the calling thread is busy waiting.
+            //!
+            //! This reduces the power consumption of the spin loop and frees execution resources for a hyper-thread sibling.
+            inline auto cpuRelax()
+            -> void
+            {
+#if BOOST_ARCH_X86 && (BOOST_COMP_GNUC || BOOST_COMP_CLANG || BOOST_COMP_INTEL || BOOST_COMP_MSVC)
+                _mm_pause();
+#elif BOOST_ARCH_ARM && (BOOST_COMP_GNUC || BOOST_COMP_CLANG)
+                __asm__ __volatile__("yield" ::: "memory");
+#elif BOOST_ARCH_PPC && (BOOST_COMP_GNUC || BOOST_COMP_CLANG)
+                __asm__ __volatile__("or 27,27,27" ::: "memory");
+#endif
+            }
+
+            //#############################################################################
+            //! A 32 bit atomic value threads can block on until it changes.
+            //!
+            //! On Linux the waiting threads are parked directly in the kernel via the futex system call.
+            //! On other systems a mutex and a condition variable are used.
+            //! The notification is skipped completely if no thread is blocked.
+            class Futex final
+            {
+            public:
+                //-----------------------------------------------------------------------------
+                explicit Futex(
+                    std::uint32_t const value = 0u) :
+                        m_value(value),
+                        m_waiterCount(0u)
+                {}
+                //-----------------------------------------------------------------------------
+                Futex(Futex const &) = delete;
+                //-----------------------------------------------------------------------------
+                Futex(Futex &&) = delete;
+                //-----------------------------------------------------------------------------
+                auto operator=(Futex const &) -> Futex & = delete;
+                //-----------------------------------------------------------------------------
+                auto operator=(Futex &&) -> Futex & = delete;
+                //-----------------------------------------------------------------------------
+                ~Futex() = default;
+
+                //-----------------------------------------------------------------------------
+                //! \return The current value.
+                auto load(
+                    std::memory_order const order = std::memory_order_seq_cst) const
+                -> std::uint32_t
+                {
+                    return m_value.load(order);
+                }
+                //-----------------------------------------------------------------------------
+                //! Sets the value without waking up any blocked thread.
+                auto store(
+                    std::uint32_t const value,
+                    std::memory_order const order = std::memory_order_seq_cst)
+                -> void
+                {
+                    m_value.store(value, order);
+                }
+                //-----------------------------------------------------------------------------
+                //! Adds to the value without waking up any blocked thread.
+                //! \return The previous value.
+                auto fetchAdd(
+                    std::uint32_t const value,
+                    std::memory_order const order = std::memory_order_seq_cst)
+                -> std::uint32_t
+                {
+                    return m_value.fetch_add(value, order);
+                }
+                //-----------------------------------------------------------------------------
+                //! Atomically replaces the value if it is equal to expected.
+                //! \return If the value has been replaced.
+                auto compareExchange(
+                    std::uint32_t & expected,
+                    std::uint32_t const desired,
+                    std::memory_order const order = std::memory_order_seq_cst)
+                -> bool
+                {
+                    return m_value.compare_exchange_strong(expected, desired, order);
+                }
+                //-----------------------------------------------------------------------------
+                //! Blocks the calling thread as long as the value is equal to expected.
+                //!
+                //! The function may return spuriously. The caller has to recheck the value.
+                auto wait(
+                    std::uint32_t const expected)
+                -> void
+                {
+                    // The increment has to be ordered before the value check so that a concurrent notify either sees the waiter or the waiter sees the new value.
+                    m_waiterCount.fetch_add(1u, std::memory_order_seq_cst);
+#if BOOST_OS_LINUX
+                    static_assert(
+                        sizeof(std::atomic<std::uint32_t>) == sizeof(int),
+                        "The futex system call requires the atomic to have the layout of an int!");
+                    ::syscall(
+                        SYS_futex,
+                        reinterpret_cast<int *>(&m_value),
+                        FUTEX_WAIT_PRIVATE,
+                        static_cast<int>(expected),
+                        nullptr,
+                        nullptr,
+                        0);
+#else
+                    {
+                        std::unique_lock<std::mutex> lock(m_mtx);
+                        m_cv.wait(
+                            lock,
+                            [this, expected]
+                            {
+                                return m_value.load(std::memory_order_seq_cst) != expected;
+                            });
+                    }
+#endif
+                    m_waiterCount.fetch_sub(1u, std::memory_order_relaxed);
+                }
+                //-----------------------------------------------------------------------------
+                //! Wakes up at least one thread blocked in wait.
+                auto notifyOne()
+                -> void
+                {
+                    if(m_waiterCount.load(std::memory_order_seq_cst) != 0u)
+                    {
+#if BOOST_OS_LINUX
+                        wake(1);
+#else
+                        std::lock_guard<std::mutex> lock(m_mtx);
+                        m_cv.notify_one();
+#endif
+                    }
+                }
+                //-----------------------------------------------------------------------------
+                //! Wakes up all threads blocked in wait.
+                auto notifyAll()
+                -> void
+                {
+                    if(m_waiterCount.load(std::memory_order_seq_cst) != 0u)
+                    {
+#if BOOST_OS_LINUX
+                        wake(std::numeric_limits<int>::max());
+#else
+                        std::lock_guard<std::mutex> lock(m_mtx);
+                        m_cv.notify_all();
+#endif
+                    }
+                }
+
+            private:
+#if BOOST_OS_LINUX
+                //-----------------------------------------------------------------------------
+                auto wake(
+                    int const threadCount)
+                -> void
+                {
+                    ::syscall(
+                        SYS_futex,
+                        reinterpret_cast<int *>(&m_value),
+                        FUTEX_WAKE_PRIVATE,
+                        threadCount,
+                        nullptr,
+                        nullptr,
+                        0);
+                }
+#endif
+
+            private:
+                std::atomic<std::uint32_t> m_value;
+                std::atomic<std::uint32_t> m_waiterCount;
+#if !BOOST_OS_LINUX
+                std::mutex m_mtx;
+                std::condition_variable m_cv;
+#endif
+            };
+        }
+    }
+}
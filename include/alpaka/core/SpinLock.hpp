@@ -0,0 +1,90 @@
+/* Copyright 2019 Benjamin Worpitz
+ *
+ * This file is part of Alpaka.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <alpaka/core/Futex.hpp>
+
+#include <atomic>
+#include <cstdint>
+
+namespace alpaka
+{
+    namespace core
+    {
+        namespace threads
+        {
+            //#############################################################################
+            //! A lightweight lock that spins for a short time and then parks the calling thread on a futex.
+            //!
+            //! It fulfills the Lockable requirements and can be used with std::lock_guard and std::unique_lock.
+            //! In contrast to std::mutex it has the size of two 32 bit integers and the unlock is free of system calls as long as no thread is parked.
+            class SpinLock final
+            {
+            public:
+                //! The number of iterations a thread spins before it is parked.
+                static constexpr std::uint32_t spinCountMax = 128u;
+
+                //-----------------------------------------------------------------------------
+                SpinLock() :
+                    m_state(0u)
+                {}
+                //-----------------------------------------------------------------------------
+                SpinLock(SpinLock const &) = delete;
+                //-----------------------------------------------------------------------------
+                SpinLock(SpinLock &&) = delete;
+                //-----------------------------------------------------------------------------
+                auto operator=(SpinLock const &) -> SpinLock & = delete;
+                //-----------------------------------------------------------------------------
+                auto operator=(SpinLock &&) -> SpinLock & = delete;
+                //-----------------------------------------------------------------------------
+                ~SpinLock() = default;
+
+                //-----------------------------------------------------------------------------
+                //! \return If the lock has been acquired.
+                auto try_lock()
+                -> bool
+                {
+                    std::uint32_t expected(0u);
+                    return m_state.compareExchange(expected, 1u, std::memory_order_acquire);
+                }
+                //-----------------------------------------------------------------------------
+                //! Blocks until the lock has been acquired.
+                auto lock()
+                -> void
+                {
+                    for(std::uint32_t i(0u); i < spinCountMax; ++i)
+                    {
+                        // Only try to acquire the lock if it looks free to keep the cache line shared while spinning.
+                        if((m_state.load(std::memory_order_relaxed) == 0u) && try_lock())
+                        {
+                            return;
+                        }
+                        cpuRelax();
+                    }
+                    while(!try_lock())
+                    {
+                        m_state.wait(1u);
+                    }
+                }
+                //-----------------------------------------------------------------------------
+                auto unlock()
+                -> void
+                {
+                    // The store has to be sequentially consistent so that it is not reordered with the check for parked threads.
+                    m_state.store(0u);
+                    m_state.notifyOne();
+                }
+
+            private:
+                Futex m_state;
+            };
+        }
+    }
+}
@@ -0,0 +1,739 @@
+/* Copyright 2019 Benjamin Worpitz
+ *
+ * This file is part of Alpaka.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <alpaka/core/BoostPredef.hpp>
+#include <alpaka/core/Unused.hpp>
+
+#if BOOST_OS_LINUX
+    #include <pthread.h>
+    #include <sched.h>
+    #include <fstream>
+    #include <string>
+#endif
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace alpaka
+{
+    namespace core
+    {
+        namespace threads
+        {
+            namespace detail
+            {
+#if BOOST_OS_LINUX
+                //-----------------------------------------------------------------------------
+                //! \return The indices of the logical CPUs the given thread is allowed to run on.
+                inline auto getThreadAffinity(
+                    pthread_t const thread)
+                -> std::vector<std::uint32_t>
+                {
+                    std::vector<std::uint32_t> cpus;
+                    cpu_set_t cpuSet;
+                    CPU_ZERO(&cpuSet);
+                    if(pthread_getaffinity_np(thread, sizeof(cpu_set_t), &cpuSet) == 0)
+                    {
+                        for(std::uint32_t cpu(0u); cpu < static_cast<std::uint32_t>(CPU_SETSIZE); ++cpu)
+                        {
+                            if(CPU_ISSET(cpu, &cpuSet))
+                            {
+                                cpus.push_back(cpu);
+                            }
+                        }
+                    }
+                    return cpus;
+                }
+
+                //-----------------------------------------------------------------------------
+                //! Restricts the given thread to the given logical CPUs.
+                inline auto setThreadAffinity(
+                    pthread_t const thread,
+                    std::vector<std::uint32_t> const & cpus)
+                -> bool
+                {
+                    cpu_set_t cpuSet;
+                    CPU_ZERO(&cpuSet);
+                    for(auto const cpu : cpus)
+                    {
+                        if(cpu < static_cast<std::uint32_t>(CPU_SETSIZE))
+                        {
+                            CPU_SET(cpu, &cpuSet);
+                        }
+                    }
+                    return (CPU_COUNT(&cpuSet) > 0) && (pthread_setaffinity_np(thread, sizeof(cpu_set_t), &cpuSet) == 0);
+                }
+#endif
+            }
+
+            //-----------------------------------------------------------------------------
+            //! \return The indices of the logical CPUs the calling thread is allowed to run on.
+            //! An empty set is returned if the affinity is not supported on this system.
+            inline auto getCurrentThreadAffinity()
+            -> std::vector<std::uint32_t>
+            {
+#if BOOST_OS_LINUX
+                return detail::getThreadAffinity(pthread_self());
+#else
+                return std::vector<std::uint32_t>();
+#endif
+            }
+
+            //-----------------------------------------------------------------------------
+            //! \return The indices of the logical CPUs the given thread is allowed to run on.
+            //! An empty set is returned if the affinity is not supported on this system.
+            inline auto getThreadAffinity(
+                std::thread & thread)
+            -> std::vector<std::uint32_t>
+            {
+#if BOOST_OS_LINUX
+                return detail::getThreadAffinity(thread.native_handle());
+#else
+                alpaka::ignore_unused(thread);
+                return std::vector<std::uint32_t>();
+#endif
+            }
+
+            namespace detail
+            {
+                //-----------------------------------------------------------------------------
+                //! \return The number of times the affinity of the calling thread has been set by setCurrentThreadAffinity.
+                //! It is used to detect changes of the affinity without querying it.
+                inline auto currentThreadAffinityVersion()
+                -> std::uint32_t &
+                {
+                    thread_local std::uint32_t version(0u);
+                    return version;
+                }
+            }
+
+            //-----------------------------------------------------------------------------
+            //! Restricts the calling thread to the given logical CPUs.
+            //!
+            //! Threads created afterwards by the calling thread inherit the affinity.
+            //! \return If the affinity has been set. This fails if the affinity is not supported on this system or none of the CPUs is available.
+            inline auto setCurrentThreadAffinity(
+                std::vector<std::uint32_t> const & cpus)
+            -> bool
+            {
+                ++detail::currentThreadAffinityVersion();
+#if BOOST_OS_LINUX
+                return detail::setThreadAffinity(pthread_self(), cpus);
+#else
+                alpaka::ignore_unused(cpus);
+                return false;
+#endif
+            }
+
+            //#############################################################################
+            //! Restricts the calling thread to the given logical CPUs for the lifetime of the object.
+            //!
+            //! An empty set of CPUs leaves the affinity unchanged.
+            class ScopedThreadAffinity final
+            {
+            public:
+                //-----------------------------------------------------------------------------
+                explicit ScopedThreadAffinity(
+                    std::vector<std::uint32_t> const & cpus) :
+                        m_previousCpus()
+                {
+                    if(!cpus.empty())
+                    {
+                        auto previousCpus(getCurrentThreadAffinity());
+                        if(setCurrentThreadAffinity(cpus))
+                        {
+                            m_previousCpus = std::move(previousCpus);
+                        }
+                    }
+                }
+                //-----------------------------------------------------------------------------
+                ScopedThreadAffinity(ScopedThreadAffinity const &) = delete;
+                //-----------------------------------------------------------------------------
+                ScopedThreadAffinity(ScopedThreadAffinity &&) = delete;
+                //-----------------------------------------------------------------------------
+                auto operator=(ScopedThreadAffinity const &) -> ScopedThreadAffinity & = delete;
+                //-----------------------------------------------------------------------------
+                auto operator=(ScopedThreadAffinity &&) -> ScopedThreadAffinity & = delete;
+                //-----------------------------------------------------------------------------
+                ~ScopedThreadAffinity()
+                {
+                    if(!m_previousCpus.empty())
+                    {
+                        setCurrentThreadAffinity(m_previousCpus);
+                    }
+                }
+
+            private:
+                std::vector<std::uint32_t> m_previousCpus;  //!< The affinity to restore. Empty if it has not been changed.
+            };
+
+            namespace detail
+            {
+                //#############################################################################
+                //! The position of a logical CPU within the processor topology.
+                struct CpuLocation
+                {
+                    std::uint32_t m_cpu;
+                    std::uint32_t m_packageRank;    //!< The rank of the package (socket) among the packages of the CPU set.
+                    std::uint32_t m_coreRank;       //!< The rank of the core among the cores of the package.
+                    std::uint32_t m_threadRank;     //!< The rank of the logical CPU among the hardware threads of the core.
+                };
+
+                //-----------------------------------------------------------------------------
+                //! \return The locations of the given logical CPUs read from /sys/devices/system/cpu.
+                //! If the topology is not available, each CPU is treated as a separate core of a single package.
+                inline auto getCpuLocations(
+                    std::vector<std::uint32_t> const & cpus)
+                -> std::vector<CpuLocation>
+                {
+                    // (package id, core id, cpu)
+                    std::vector<std::tuple<std::uint32_t, std::uint32_t, std::uint32_t>> topology;
+                    for(auto const cpu : cpus)
+                    {
+                        std::uint32_t packageId(0u);
+                        std::uint32_t coreId(cpu);
+#if BOOST_OS_LINUX
+                        std::string const topologyDir("/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/");
+                        std::ifstream packageIdFile(topologyDir + "physical_package_id");
+                        std::ifstream coreIdFile(topologyDir + "core_id");
+                        std::uint32_t id(0u);
+                        if(packageIdFile >> id)
+                        {
+                            packageId = id;
+                        }
+                        if(coreIdFile >> id)
+                        {
+                            coreId = id;
+                        }
+#endif
+                        topology.emplace_back(packageId, coreId, cpu);
+                    }
+                    std::sort(topology.begin(), topology.end());
+
+                    std::vector<CpuLocation> locations;
+                    for(std::size_t i(0u); i < topology.size(); ++i)
+                    {
+                        CpuLocation location{std::get<2>(topology[i]), 0u, 0u, 0u};
+                        if(i > 0u)
+                        {
+                            auto const & previous(locations.back());
+                            bool const bSamePackage(std::get<0>(topology[i]) == std::get<0>(topology[i - 1u]));
+                            bool const bSameCore(bSamePackage && (std::get<1>(topology[i]) == std::get<1>(topology[i - 1u])));
+                            location.m_packageRank = bSamePackage ? previous.m_packageRank : previous.m_packageRank + 1u;
+                            location.m_coreRank = bSameCore ? previous.m_coreRank : (bSamePackage ? previous.m_coreRank + 1u : 0u);
+                            location.m_threadRank = bSameCore ? previous.m_threadRank + 1u : 0u;
+                        }
+                        locations.push_back(location);
+                    }
+                    return locations;
+                }
+            }
+
+            //#############################################################################
+            //! The policy assigning logical CPUs to the worker threads executing the tasks of a queue.
+            //!
+            //! The workers are identified by their index, e.g. the index of a thread within the block thread pool.
+            //! Worker i is pinned to the i-th CPU of the ordered CPU list (modulo its size).
+            class AffinityPolicy final
+            {
+            public:
+                //#############################################################################
+                enum class Kind
+                {
+                    Inherit,    //!< The workers are not pinned and inherit the affinity of the thread creating them.
+                    Compact,    //!< Consecutive workers are pinned to the hardware threads of the same core, then to the cores of the same package.
+                    Scatter,    //!< Consecutive workers are spread over the packages first, then over the cores and only then over the hardware threads of a core.
+                    Explicit    //!< The workers are pinned to the CPUs of an explicitly given list in its order.
+                };
+
+                //-----------------------------------------------------------------------------
+                //! Constructs the inherit policy.
+                AffinityPolicy() :
+                    m_kind(Kind::Inherit),
+                    m_cpus(),
+                    m_cpuCount(0u)
+                {}
+
+                //-----------------------------------------------------------------------------
+                //! \return The policy leaving the affinity of the workers unchanged.
+                static auto inherit()
+                -> AffinityPolicy
+                {
+                    return AffinityPolicy();
+                }
+                //-----------------------------------------------------------------------------
+                //! \param cpus The CPUs to distribute the workers on.
+                //! \return The policy filling the cores one after another.
+                static auto compact(
+                    std::vector<std::uint32_t> const & cpus = getCurrentThreadAffinity())
+                -> AffinityPolicy
+                {
+                    auto locations(detail::getCpuLocations(cpus));
+                    std::stable_sort(
+                        locations.begin(),
+                        locations.end(),
+                        [](detail::CpuLocation const & lhs, detail::CpuLocation const & rhs)
+                        {
+                            return
+                                std::make_tuple(lhs.m_packageRank, lhs.m_coreRank, lhs.m_threadRank)
+                                < std::make_tuple(rhs.m_packageRank, rhs.m_coreRank, rhs.m_threadRank);
+                        });
+                    return AffinityPolicy(Kind::Compact, locations);
+                }
+                //-----------------------------------------------------------------------------
+                //! \param cpus The CPUs to distribute the workers on.
+                //! \return The policy spreading the workers as far as possible.
+                static auto scatter(
+                    std::vector<std::uint32_t> const & cpus = getCurrentThreadAffinity())
+                -> AffinityPolicy
+                {
+                    auto locations(detail::getCpuLocations(cpus));
+                    std::stable_sort(
+                        locations.begin(),
+                        locations.end(),
+                        [](detail::CpuLocation const & lhs, detail::CpuLocation const & rhs)
+                        {
+                            return
+                                std::make_tuple(lhs.m_threadRank, lhs.m_coreRank, lhs.m_packageRank)
+                                < std::make_tuple(rhs.m_threadRank, rhs.m_coreRank, rhs.m_packageRank);
+                        });
+                    return AffinityPolicy(Kind::Scatter, locations);
+                }
+                //-----------------------------------------------------------------------------
+                //! \param cpus The CPUs the workers are pinned to in the given order.
+                //! \return The policy using the given CPU list.
+                static auto explicitCpus(
+                    std::vector<std::uint32_t> cpus)
+                -> AffinityPolicy
+                {
+                    AffinityPolicy policy;
+                    policy.m_kind = Kind::Explicit;
+                    policy.m_cpus = std::move(cpus);
+                    policy.updateCpuCount();
+                    return policy;
+                }
+
+                //-----------------------------------------------------------------------------
+                auto operator==(AffinityPolicy const & rhs) const
+                -> bool
+                {
+                    return (m_kind == rhs.m_kind) && (m_cpus == rhs.m_cpus);
+                }
+                //-----------------------------------------------------------------------------
+                auto operator!=(AffinityPolicy const & rhs) const
+                -> bool
+                {
+                    return !((*this) == rhs);
+                }
+
+                //-----------------------------------------------------------------------------
+                auto getKind() const
+                -> Kind
+                {
+                    return m_kind;
+                }
+                //-----------------------------------------------------------------------------
+                //! \return The CPUs in the order they are assigned to the workers. Empty for the inherit policy.
+                auto getCpus() const
+                -> std::vector<std::uint32_t> const &
+                {
+                    return m_cpus;
+                }
+                //-----------------------------------------------------------------------------
+                //! \return The number of distinct CPUs the workers are pinned to. Zero for the inherit policy.
+                auto getCpuCount() const
+                -> std::size_t
+                {
+                    return m_cpuCount;
+                }
+                //-----------------------------------------------------------------------------
+                //! \return The CPUs the worker with the given index is pinned to. Empty if the affinity of the worker is left unchanged.
+                auto getWorkerCpus(
+                    std::size_t const workerIdx) const
+                -> std::vector<std::uint32_t>
+                {
+                    if(m_cpus.empty())
+                    {
+                        return std::vector<std::uint32_t>();
+                    }
+                    return std::vector<std::uint32_t>{m_cpus[workerIdx % m_cpus.size()]};
+                }
+                //-----------------------------------------------------------------------------
+                //! \return The policy of the same kind assigning the count CPUs of this policy starting at the given one (modulo its size) to the workers.
+                //! The inherit policy is returned unchanged.
+                auto getSlice(
+                    std::size_t const first,
+                    std::size_t const count) const
+                -> AffinityPolicy
+                {
+                    if(m_cpus.empty())
+                    {
+                        return *this;
+                    }
+                    AffinityPolicy policy;
+                    policy.m_kind = m_kind;
+                    for(std::size_t i(0u); i < count; ++i)
+                    {
+                        policy.m_cpus.push_back(m_cpus[(first + i) % m_cpus.size()]);
+                    }
+                    policy.updateCpuCount();
+                    return policy;
+                }
+
+            private:
+                //-----------------------------------------------------------------------------
+                AffinityPolicy(
+                    Kind const kind,
+                    std::vector<detail::CpuLocation> const & locations) :
+                        m_kind(kind),
+                        m_cpus(),
+                        m_cpuCount(0u)
+                {
+                    for(auto const & location : locations)
+                    {
+                        m_cpus.push_back(location.m_cpu);
+                    }
+                    updateCpuCount();
+                }
+                //-----------------------------------------------------------------------------
+                //! Counts the distinct CPUs. An explicit list can contain a CPU multiple times.
+                auto updateCpuCount()
+                -> void
+                {
+                    auto cpus(m_cpus);
+                    std::sort(cpus.begin(), cpus.end());
+                    m_cpuCount = static_cast<std::size_t>(std::distance(cpus.begin(), std::unique(cpus.begin(), cpus.end())));
+                }
+
+                Kind m_kind;
+                std::vector<std::uint32_t> m_cpus;
+                std::size_t m_cpuCount;
+            };
+
+            namespace detail
+            {
+                //-----------------------------------------------------------------------------
+                //! \return The affinity policy of the calling thread. It is owned by the queue executing on this thread, nullptr if there is none.
+                inline auto currentAffinityPolicy()
+                -> AffinityPolicy const * &
+                {
+                    thread_local AffinityPolicy const * pPolicy(nullptr);
+                    return pPolicy;
+                }
+#if BOOST_COMP_CLANG
+    #pragma clang diagnostic push
+    #pragma clang diagnostic ignored "-Wexit-time-destructors"
+#endif
+                //-----------------------------------------------------------------------------
+                //! \return The CPUs the calling thread has been pinned to by pinCurrentThread.
+                inline auto pinnedCpus()
+                -> std::vector<std::uint32_t> &
+                {
+                    thread_local std::vector<std::uint32_t> cpus;
+                    return cpus;
+                }
+                //-----------------------------------------------------------------------------
+                //! \return The CPUs the calling thread has been allowed to run on before it has been pinned by pinCurrentThread.
+                inline auto originalCpus()
+                -> std::vector<std::uint32_t> &
+                {
+                    thread_local std::vector<std::uint32_t> cpus;
+                    return cpus;
+                }
+#if BOOST_COMP_CLANG
+    #pragma clang diagnostic pop
+#endif
+            }
+
+            //-----------------------------------------------------------------------------
+            //! \return The affinity policy for the workers started by the calling thread, e.g. the block threads of the kernels executed by a queue.
+            inline auto getCurrentAffinityPolicy()
+            -> AffinityPolicy const &
+            {
+#if BOOST_COMP_CLANG
+    #pragma clang diagnostic push
+    #pragma clang diagnostic ignored "-Wexit-time-destructors"
+#endif
+                static AffinityPolicy const inheritPolicy;
+#if BOOST_COMP_CLANG
+    #pragma clang diagnostic pop
+#endif
+                auto const pPolicy(detail::currentAffinityPolicy());
+                return pPolicy ? *pPolicy : inheritPolicy;
+            }
+
+            namespace detail
+            {
+                //-----------------------------------------------------------------------------
+                //! Pins the calling thread to the given CPUs.
+                //!
+                //! The system call is skipped if the thread is already pinned to these CPUs.
+                //! If the set is empty, a thread pinned before gets back the CPUs it has been allowed to run on before the first pin.
+                inline auto pinCurrentThread(
+                    std::vector<std::uint32_t> const & cpus)
+                -> void
+                {
+                    auto & pinnedCpus(detail::pinnedCpus());
+                    if(cpus == pinnedCpus)
+                    {
+                        return;
+                    }
+                    if(cpus.empty())
+                    {
+                        // The restore is not retried if it fails, e.g. because the original CPUs could not be queried.
+                        setCurrentThreadAffinity(detail::originalCpus());
+                        pinnedCpus.clear();
+                        return;
+                    }
+                    if(pinnedCpus.empty())
+                    {
+                        detail::originalCpus() = getCurrentThreadAffinity();
+                    }
+                    if(setCurrentThreadAffinity(cpus))
+                    {
+                        pinnedCpus = cpus;
+                    }
+                }
+                //-----------------------------------------------------------------------------
+                //! Pins the calling thread to the CPU the policy assigns to the worker with the given index or to the fallback CPUs if the policy assigns none.
+                //!
+                //! No CPU set is allocated if the thread is already pinned to the CPU of the worker.
+                inline auto pinCurrentThread(
+                    AffinityPolicy const & policy,
+                    std::size_t const workerIdx,
+                    std::vector<std::uint32_t> const & fallbackCpus)
+                -> void
+                {
+                    auto const & policyCpus(policy.getCpus());
+                    if(policyCpus.empty())
+                    {
+                        detail::pinCurrentThread(fallbackCpus);
+                        return;
+                    }
+                    auto const cpu(policyCpus[workerIdx % policyCpus.size()]);
+                    auto const & pinnedCpus(detail::pinnedCpus());
+                    if((pinnedCpus.size() == 1u) && (pinnedCpus.front() == cpu))
+                    {
+                        return;
+                    }
+                    detail::pinCurrentThread(std::vector<std::uint32_t>{cpu});
+                }
+            }
+
+            //-----------------------------------------------------------------------------
+            //! Pins the calling thread to the CPUs the policy assigns to the worker with the given index.
+            //!
+            //! The system call is skipped if the thread is already pinned to these CPUs, so this is cheap to call repeatedly.
+            //! If the policy leaves the affinity of the worker unchanged, a thread pinned before gets back the CPUs it has been allowed to run on before the first pin.
+            inline auto pinCurrentThread(
+                AffinityPolicy const & policy,
+                std::size_t const workerIdx)
+            -> void
+            {
+#if BOOST_COMP_CLANG
+    #pragma clang diagnostic push
+    #pragma clang diagnostic ignored "-Wexit-time-destructors"
+#endif
+                static std::vector<std::uint32_t> const noCpus;
+#if BOOST_COMP_CLANG
+    #pragma clang diagnostic pop
+#endif
+                detail::pinCurrentThread(policy, workerIdx, noCpus);
+            }
+            //-----------------------------------------------------------------------------
+            //! Pins the calling thread to the CPUs the policy assigns to the worker with the given index or to the inherited CPUs if the policy assigns none.
+            //!
+            //! This is used by workers which are reused by multiple launching threads, e.g. pooled threads, so that they are restricted like threads newly created by the current launching thread.
+            //! \param inheritedCpus The CPUs of the launching thread as returned by getInheritedCpus.
+            inline auto pinCurrentThread(
+                AffinityPolicy const & policy,
+                std::size_t const workerIdx,
+                std::vector<std::uint32_t> const & inheritedCpus)
+            -> void
+            {
+                detail::pinCurrentThread(policy, workerIdx, inheritedCpus);
+            }
+            namespace detail
+            {
+                //#############################################################################
+                //! The affinity of a thread queried at a version of its affinity.
+                struct CachedThreadAffinity
+                {
+                    bool m_bValid = false;
+                    std::uint32_t m_version = 0u;
+                    std::vector<std::uint32_t> m_cpus;
+                };
+#if BOOST_COMP_CLANG
+    #pragma clang diagnostic push
+    #pragma clang diagnostic ignored "-Wexit-time-destructors"
+#endif
+                //-----------------------------------------------------------------------------
+                //! \return The affinity of the calling thread queried by getInheritedCpus.
+                inline auto cachedThreadAffinity()
+                -> CachedThreadAffinity &
+                {
+                    thread_local CachedThreadAffinity affinity;
+                    return affinity;
+                }
+#if BOOST_COMP_CLANG
+    #pragma clang diagnostic pop
+#endif
+            }
+
+            //-----------------------------------------------------------------------------
+            //! \return The CPUs the workers started by the calling thread inherit if the policy assigns them no CPUs.
+            //! These are the CPUs the calling thread may run on, e.g. the CPUs of the NUMA node of the device its queue belongs to.
+            //! Empty if the policy assigns CPUs to the workers, so that the affinity of the calling thread is only queried when it is required.
+            //!
+            //! The affinity is only queried again after it has been changed by setCurrentThreadAffinity, so this is cheap to call on each kernel launch.
+            //! Changes of the affinity made by other means are not detected.
+            //! The returned set is owned by the calling thread and is valid until its affinity is changed.
+            inline auto getInheritedCpus(
+                AffinityPolicy const & policy)
+            -> std::vector<std::uint32_t> const &
+            {
+#if BOOST_COMP_CLANG
+    #pragma clang diagnostic push
+    #pragma clang diagnostic ignored "-Wexit-time-destructors"
+#endif
+                static std::vector<std::uint32_t> const noCpus;
+#if BOOST_COMP_CLANG
+    #pragma clang diagnostic pop
+#endif
+                if(!policy.getCpus().empty())
+                {
+                    return noCpus;
+                }
+
+                auto & cachedAffinity(detail::cachedThreadAffinity());
+                auto const version(detail::currentThreadAffinityVersion());
+                if(!cachedAffinity.m_bValid || (cachedAffinity.m_version != version))
+                {
+                    cachedAffinity.m_cpus = getCurrentThreadAffinity();
+                    cachedAffinity.m_version = version;
+                    cachedAffinity.m_bValid = true;
+                }
+                return cachedAffinity.m_cpus;
+            }
+
+            //#############################################################################
+            //! Sets the affinity policy of the calling thread for the lifetime of the object.
+            //!
+            //! The policy is referenced and has to outlive the object.
+            class ScopedAffinityPolicy final
+            {
+            public:
+                //-----------------------------------------------------------------------------
+                explicit ScopedAffinityPolicy(
+                    AffinityPolicy const & policy) :
+                        m_pPreviousPolicy(detail::currentAffinityPolicy())
+                {
+                    detail::currentAffinityPolicy() = &policy;
+                }
+                //-----------------------------------------------------------------------------
+                ScopedAffinityPolicy(ScopedAffinityPolicy const &) = delete;
+                //-----------------------------------------------------------------------------
+                ScopedAffinityPolicy(ScopedAffinityPolicy &&) = delete;
+                //-----------------------------------------------------------------------------
+                auto operator=(ScopedAffinityPolicy const &) -> ScopedAffinityPolicy & = delete;
+                //-----------------------------------------------------------------------------
+                auto operator=(ScopedAffinityPolicy &&) -> ScopedAffinityPolicy & = delete;
+                //-----------------------------------------------------------------------------
+                ~ScopedAffinityPolicy()
+                {
+                    detail::currentAffinityPolicy() = m_pPreviousPolicy;
+                }
+
+            private:
+                AffinityPolicy const * m_pPreviousPolicy;
+            };
+
+            namespace detail
+            {
+                //-----------------------------------------------------------------------------
+                //! \return The number of threads of the calling thread's queue which may execute tasks concurrently.
+                inline auto currentConcurrentWorkerCount()
+                -> std::size_t &
+                {
+                    thread_local std::size_t workerCount(1u);
+                    return workerCount;
+                }
+            }
+
+            //-----------------------------------------------------------------------------
+            //! \return The number of hardware threads available to the workers started by the calling thread, e.g. the block threads of a kernel.
+            //!
+            //! These are the CPUs the current affinity policy assigns to the workers or, if it assigns none, the CPUs the calling thread may run on,
+            //! e.g. the CPUs of the NUMA node of the device its queue belongs to.
+            //! All hardware threads of the system are only used if the affinity is not supported on this system.
+            //! If the calling thread is one of multiple workers of a queue executing tasks concurrently, the hardware threads are divided between them.
+            //! Otherwise concurrently executed kernels would each start as many threads as there are hardware threads.
+            inline auto getCurrentHardwareThreadCount()
+            -> std::size_t
+            {
+                auto const & policy(getCurrentAffinityPolicy());
+                auto hardwareThreadCount(policy.getCpuCount());
+                if(hardwareThreadCount == 0u)
+                {
+                    hardwareThreadCount = getInheritedCpus(policy).size();
+                }
+                if(hardwareThreadCount == 0u)
+                {
+                    // std::thread::hardware_concurrency can return 0. It is queried only once because it does not change.
+                    static std::size_t const hardwareConcurrency(
+                        std::max(
+                            static_cast<std::size_t>(std::thread::hardware_concurrency()),
+                            static_cast<std::size_t>(1u)));
+                    hardwareThreadCount = hardwareConcurrency;
+                }
+                return std::max(hardwareThreadCount / detail::currentConcurrentWorkerCount(), static_cast<std::size_t>(1u));
+            }
+
+            //#############################################################################
+            //! Sets the number of workers of the queue executing on the calling thread for the lifetime of the object.
+            //!
+            //! \see getCurrentHardwareThreadCount
+            class ScopedConcurrentWorkerCount final
+            {
+            public:
+                //-----------------------------------------------------------------------------
+                explicit ScopedConcurrentWorkerCount(
+                    std::size_t const workerCount) :
+                        m_previousWorkerCount(detail::currentConcurrentWorkerCount())
+                {
+                    detail::currentConcurrentWorkerCount() = std::max(workerCount, static_cast<std::size_t>(1u));
+                }
+                //-----------------------------------------------------------------------------
+                ScopedConcurrentWorkerCount(ScopedConcurrentWorkerCount const &) = delete;
+                //-----------------------------------------------------------------------------
+                ScopedConcurrentWorkerCount(ScopedConcurrentWorkerCount &&) = delete;
+                //-----------------------------------------------------------------------------
+                auto operator=(ScopedConcurrentWorkerCount const &) -> ScopedConcurrentWorkerCount & = delete;
+                //-----------------------------------------------------------------------------
+                auto operator=(ScopedConcurrentWorkerCount &&) -> ScopedConcurrentWorkerCount & = delete;
+                //-----------------------------------------------------------------------------
+                ~ScopedConcurrentWorkerCount()
+                {
+                    detail::currentConcurrentWorkerCount() = m_previousWorkerCount;
+                }
+
+            private:
+                std::size_t m_previousWorkerCount;
+            };
+        }
+    }
+}
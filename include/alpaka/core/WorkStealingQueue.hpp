@@ -0,0 +1,607 @@
+/* Copyright 2019 Benjamin Worpitz
+ *
+ * This file is part of Alpaka.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <alpaka/core/Common.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace alpaka
+{
+    namespace core
+    {
+        namespace detail
+        {
+            //#############################################################################
+            //! A Chase-Lev work-stealing deque.
+            //!
+            //! The owner pushes and pops at the bottom (LIFO) while any other thread can steal from the top (FIFO).
+            //! Pushing and popping by the owner is wait-free unless the last element is contended.
+            //! The memory orderings follow "Correct and Efficient Work-Stealing for Weak Memory Models" (Le et al., 2013).
+            //!
+            //! \tparam T The element type. It has to be a scalar type (e.g. a pointer) because elements are stored in atomics.
+            template<
+                typename T>
+            class ChaseLevDeque final
+            {
+                static_assert(
+                    std::is_scalar<T>::value,
+                    "The elements of a ChaseLevDeque have to be of scalar type!");
+
+                //#############################################################################
+                //! The circular buffer holding the elements.
+                class CircularArray final
+                {
+                public:
+                    //-----------------------------------------------------------------------------
+                    explicit CircularArray(
+                        std::size_t const capacity) :
+                            m_capacity(capacity),
+                            m_mask(capacity - 1u),
+                            m_elements(new std::atomic<T>[capacity])
+                    {}
+
+                    //-----------------------------------------------------------------------------
+                    auto capacity() const
+                    -> std::size_t
+                    {
+                        return m_capacity;
+                    }
+                    //-----------------------------------------------------------------------------
+                    auto get(
+                        std::int64_t const i) const
+                    -> T
+                    {
+                        return m_elements[static_cast<std::size_t>(i) & m_mask].load(std::memory_order_relaxed);
+                    }
+                    //-----------------------------------------------------------------------------
+                    auto put(
+                        std::int64_t const i,
+                        T const & t)
+                    -> void
+                    {
+                        m_elements[static_cast<std::size_t>(i) & m_mask].store(t, std::memory_order_relaxed);
+                    }
+
+                private:
+                    std::size_t const m_capacity;
+                    std::size_t const m_mask;
+                    std::unique_ptr<std::atomic<T>[]> m_elements;
+                };
+
+            public:
+                //-----------------------------------------------------------------------------
+                //! \param capacity The initial capacity. Has to be a power of two. The deque grows on demand.
+                explicit ChaseLevDeque(
+                    std::size_t const capacity = 64u) :
+                        m_top(0),
+                        m_bottom(0),
+                        m_array(nullptr),
+                        m_arrays()
+                {
+                    m_arrays.emplace_back(new CircularArray(capacity));
+                    m_array.store(m_arrays.back().get(), std::memory_order_relaxed);
+                }
+                //-----------------------------------------------------------------------------
+                ChaseLevDeque(ChaseLevDeque const &) = delete;
+                //-----------------------------------------------------------------------------
+                ChaseLevDeque(ChaseLevDeque &&) = delete;
+                //-----------------------------------------------------------------------------
+                auto operator=(ChaseLevDeque const &) -> ChaseLevDeque & = delete;
+                //-----------------------------------------------------------------------------
+                auto operator=(ChaseLevDeque &&) -> ChaseLevDeque & = delete;
+
+                //-----------------------------------------------------------------------------
+                //! \return If the deque is empty. This is only a snapshot when called concurrently.
+                auto empty() const
+                -> bool
+                {
+                    auto const b(m_bottom.load(std::memory_order_acquire));
+                    auto const t(m_top.load(std::memory_order_acquire));
+                    return b <= t;
+                }
+                //-----------------------------------------------------------------------------
+                //! Pushes the given value onto the bottom of the deque.
+                //! Must only be called by the owner.
+                auto push(
+                    T const & t)
+                -> void
+                {
+                    auto const b(m_bottom.load(std::memory_order_relaxed));
+                    auto const top(m_top.load(std::memory_order_acquire));
+                    auto * a(m_array.load(std::memory_order_relaxed));
+                    if(static_cast<std::size_t>(b - top) >= a->capacity())
+                    {
+                        a = grow(a, top, b);
+                    }
+                    a->put(b, t);
+                    std::atomic_thread_fence(std::memory_order_release);
+                    m_bottom.store(b + 1, std::memory_order_relaxed);
+                }
+                //-----------------------------------------------------------------------------
+                //! Pops a value from the bottom of the deque.
+                //! Must only be called by the owner.
+                auto pop(
+                    T & t)
+                -> bool
+                {
+                    auto const b(m_bottom.load(std::memory_order_relaxed) - 1);
+                    auto * const a(m_array.load(std::memory_order_relaxed));
+                    m_bottom.store(b, std::memory_order_relaxed);
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                    auto top(m_top.load(std::memory_order_relaxed));
+
+                    if(top > b)
+                    {
+                        // The deque was empty.
+                        m_bottom.store(b + 1, std::memory_order_relaxed);
+                        return false;
+                    }
+
+                    t = a->get(b);
+                    if(top == b)
+                    {
+                        // This is the last element. Race against the thieves.
+                        bool const won(
+                            m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed));
+                        m_bottom.store(b + 1, std::memory_order_relaxed);
+                        return won;
+                    }
+                    return true;
+                }
+                //-----------------------------------------------------------------------------
+                //! Steals a value from the top of the deque.
+                //! Can be called by any thread.
+                auto steal(
+                    T & t)
+                -> bool
+                {
+                    auto top(m_top.load(std::memory_order_acquire));
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                    auto const b(m_bottom.load(std::memory_order_acquire));
+
+                    if(top < b)
+                    {
+                        auto const * const a(m_array.load(std::memory_order_acquire));
+                        T const value(a->get(top));
+                        if(m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                        {
+                            t = value;
+                            return true;
+                        }
+                    }
+                    return false;
+                }
+
+            private:
+                //-----------------------------------------------------------------------------
+                //! Replaces the circular array by one with twice the capacity.
+                //! The old array is kept alive because thieves may still read from it.
+                auto grow(
+                    CircularArray const * const a,
+                    std::int64_t const top,
+                    std::int64_t const b)
+                -> CircularArray *
+                {
+                    m_arrays.emplace_back(new CircularArray(a->capacity() * 2u));
+                    auto * const aNew(m_arrays.back().get());
+                    for(auto i(top); i < b; ++i)
+                    {
+                        aNew->put(i, a->get(i));
+                    }
+                    m_array.store(aNew, std::memory_order_release);
+                    return aNew;
+                }
+
+            private:
+                std::atomic<std::int64_t> m_top;
+                std::atomic<std::int64_t> m_bottom;
+                std::atomic<CircularArray *> m_array;
+                std::vector<std::unique_ptr<CircularArray>> m_arrays;
+            };
+
+            //#############################################################################
+            //! A bounded lock-free multi-producer multi-consumer FIFO queue.
+            //!
+            //! Each cell carries a sequence number telling producers and consumers whose turn it is.
+            //! The algorithm follows the bounded MPMC queue by Dmitry Vyukov.
+            //!
+            //! \tparam T The element type. It has to be a scalar type (e.g. a pointer).
+            template<
+                typename T>
+            class BoundedMpmcQueue final
+            {
+                static_assert(
+                    std::is_scalar<T>::value,
+                    "The elements of a BoundedMpmcQueue have to be of scalar type!");
+
+                //#############################################################################
+                struct Cell
+                {
+                    std::atomic<std::size_t> m_sequence;
+                    T m_value;
+                };
+
+            public:
+                //-----------------------------------------------------------------------------
+                //! \param capacity The capacity. Has to be a power of two.
+                explicit BoundedMpmcQueue(
+                    std::size_t const capacity) :
+                        m_mask(capacity - 1u),
+                        m_cells(new Cell[capacity]),
+                        m_enqueuePos(0u),
+                        m_dequeuePos(0u)
+                {
+                    for(std::size_t i(0u); i < capacity; ++i)
+                    {
+                        m_cells[i].m_sequence.store(i, std::memory_order_relaxed);
+                    }
+                }
+                //-----------------------------------------------------------------------------
+                BoundedMpmcQueue(BoundedMpmcQueue const &) = delete;
+                //-----------------------------------------------------------------------------
+                BoundedMpmcQueue(BoundedMpmcQueue &&) = delete;
+                //-----------------------------------------------------------------------------
+                auto operator=(BoundedMpmcQueue const &) -> BoundedMpmcQueue & = delete;
+                //-----------------------------------------------------------------------------
+                auto operator=(BoundedMpmcQueue &&) -> BoundedMpmcQueue & = delete;
+
+                //-----------------------------------------------------------------------------
+                //! \return If the queue is empty. This is only a snapshot when called concurrently.
+                //! A value counts as enqueued as soon as its cell has been reserved, even if it can not be dequeued yet.
+                auto empty() const
+                -> bool
+                {
+                    return m_dequeuePos.load(std::memory_order_acquire) == m_enqueuePos.load(std::memory_order_acquire);
+                }
+                //-----------------------------------------------------------------------------
+                //! Pushes the given value. Can be called by any thread.
+                //! \return If the value has been pushed. False if the queue is full.
+                auto push(
+                    T const & t)
+                -> bool
+                {
+                    auto pos(m_enqueuePos.load(std::memory_order_relaxed));
+                    Cell * pCell(nullptr);
+                    for(;;)
+                    {
+                        pCell = &m_cells[pos & m_mask];
+                        auto const sequence(pCell->m_sequence.load(std::memory_order_acquire));
+                        auto const diff(static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos));
+                        if(diff == 0)
+                        {
+                            if(m_enqueuePos.compare_exchange_weak(pos, pos + 1u, std::memory_order_relaxed))
+                            {
+                                break;
+                            }
+                        }
+                        else if(diff < 0)
+                        {
+                            return false;
+                        }
+                        else
+                        {
+                            pos = m_enqueuePos.load(std::memory_order_relaxed);
+                        }
+                    }
+                    pCell->m_value = t;
+                    pCell->m_sequence.store(pos + 1u, std::memory_order_release);
+                    return true;
+                }
+                //-----------------------------------------------------------------------------
+                //! Pops the oldest value. Can be called by any thread.
+                //! \return If a value has been popped.
+                auto pop(
+                    T & t)
+                -> bool
+                {
+                    auto pos(m_dequeuePos.load(std::memory_order_relaxed));
+                    Cell * pCell(nullptr);
+                    for(;;)
+                    {
+                        pCell = &m_cells[pos & m_mask];
+                        auto const sequence(pCell->m_sequence.load(std::memory_order_acquire));
+                        auto const diff(static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos + 1u));
+                        if(diff == 0)
+                        {
+                            if(m_dequeuePos.compare_exchange_weak(pos, pos + 1u, std::memory_order_relaxed))
+                            {
+                                break;
+                            }
+                        }
+                        else if(diff < 0)
+                        {
+                            return false;
+                        }
+                        else
+                        {
+                            pos = m_dequeuePos.load(std::memory_order_relaxed);
+                        }
+                    }
+                    t = pCell->m_value;
+                    pCell->m_sequence.store(pos + m_mask + 1u, std::memory_order_release);
+                    return true;
+                }
+
+            private:
+                std::size_t const m_mask;
+                std::unique_ptr<Cell[]> m_cells;
+                std::atomic<std::size_t> m_enqueuePos;
+                std::atomic<std::size_t> m_dequeuePos;
+            };
+
+            //#############################################################################
+            //! A work-stealing task queue.
+            //!
+            //! Each worker owns a Chase-Lev deque and a lock-free inbox.
+            //! Values pushed from outside of the workers are distributed round-robin over the inboxes, so concurrent pushes do not share a lock.
+            //! A worker looking for work first pops from its own deque, then moves a batch from its inbox into its deque
+            //! and finally steals from the deques and inboxes of the other workers.
+            //! Only if all inboxes are full, values go into an overflow queue protected by a mutex.
+            //! The queue counts the pushed and the popped values, so values being moved from an inbox into a deque are never reported as missing by empty().
+            //! In contrast to ThreadSafeQueue the values are not strictly processed in FIFO order.
+            //!
+            //! \tparam T The element type. It has to be a scalar type (e.g. a pointer).
+            template<
+                typename T>
+            class WorkStealingQueue final
+            {
+                using Deque = ChaseLevDeque<T>;
+                using Inbox = BoundedMpmcQueue<T>;
+
+                //#############################################################################
+                //! The values owned by a single worker.
+                struct Worker
+                {
+                    Worker() :
+                        m_deque(),
+                        m_inbox(inboxCapacity)
+                    {}
+
+                    Deque m_deque;
+                    Inbox m_inbox;
+                };
+                using WorkerTable = std::vector<Worker *>;
+
+            public:
+                //-----------------------------------------------------------------------------
+                WorkStealingQueue() :
+                    m_workers(),
+                    m_workerTables(),
+                    m_workerTable(nullptr),
+                    m_mtxOverflow(),
+                    m_qOverflow(),
+                    m_overflowCount(0u),
+                    m_pushCount(0u),
+                    m_popCount(0u),
+                    m_stealCount(0u)
+                {
+                    m_workerTables.emplace_back(new WorkerTable());
+                    m_workerTable.store(m_workerTables.back().get(), std::memory_order_relaxed);
+                }
+                //-----------------------------------------------------------------------------
+                WorkStealingQueue(WorkStealingQueue const &) = delete;
+                //-----------------------------------------------------------------------------
+                WorkStealingQueue(WorkStealingQueue &&) = delete;
+                //-----------------------------------------------------------------------------
+                auto operator=(WorkStealingQueue const &) -> WorkStealingQueue & = delete;
+                //-----------------------------------------------------------------------------
+                auto operator=(WorkStealingQueue &&) -> WorkStealingQueue & = delete;
+
+                //-----------------------------------------------------------------------------
+                //! Creates the deques and inboxes for the given number of workers.
+                //! Has to be called before the workers with the new indices start popping and before the first push.
+                //!
+                //! NOTE: This must not be called concurrently with itself.
+                auto ensureWorkerCount(
+                    std::size_t const workerCount)
+                -> void
+                {
+                    if(workerCount <= m_workers.size())
+                    {
+                        return;
+                    }
+
+                    while(m_workers.size() < workerCount)
+                    {
+                        m_workers.emplace_back(new Worker());
+                    }
+
+                    // The table currently read by the pushing and stealing threads stays alive until the queue is destroyed.
+                    std::unique_ptr<WorkerTable> upWorkerTable(new WorkerTable());
+                    upWorkerTable->reserve(m_workers.size());
+                    for(auto const & upWorker : m_workers)
+                    {
+                        upWorkerTable->push_back(upWorker.get());
+                    }
+                    m_workerTables.emplace_back(std::move(upWorkerTable));
+                    m_workerTable.store(m_workerTables.back().get(), std::memory_order_release);
+                }
+                //-----------------------------------------------------------------------------
+                //! \return If the queue is empty. This is only a snapshot when called concurrently.
+                //! Values which have been pushed are counted until they are returned by pop, even while they are moved between the containers.
+                auto empty() const
+                -> bool
+                {
+                    // A value is counted as pushed before it becomes visible, so the pop count can never exceed the push count read afterwards.
+                    auto const popCount(m_popCount.load(std::memory_order_acquire));
+                    return popCount == m_pushCount.load(std::memory_order_acquire);
+                }
+                //-----------------------------------------------------------------------------
+                //! Pushes the given value into the inbox of the next worker. Can be called by any thread.
+                //! The push count of the queue selects the first inbox to try, so the values are distributed round-robin.
+                auto push(
+                    T && t)
+                -> void
+                {
+                    auto const & workerTable(*m_workerTable.load(std::memory_order_acquire));
+                    auto const workerCount(workerTable.size());
+                    auto const firstWorkerIdx(m_pushCount.fetch_add(1u, std::memory_order_acq_rel));
+
+                    for(std::size_t i(0u); i < workerCount; ++i)
+                    {
+                        auto const workerIdx((firstWorkerIdx + i) % workerCount);
+                        if(workerTable[workerIdx]->m_inbox.push(t))
+                        {
+                            return;
+                        }
+                    }
+
+                    std::lock_guard<std::mutex> lk(m_mtxOverflow);
+
+                    m_qOverflow.push_back(std::forward<T>(t));
+                    m_overflowCount.fetch_add(1u, std::memory_order_release);
+                }
+                //-----------------------------------------------------------------------------
+                //! Pops a value for the given worker.
+                //! Must only be called by the worker with the given index or when no worker is running.
+                auto pop(
+                    std::size_t const workerIdx,
+                    T & t)
+                -> bool
+                {
+                    if(popImpl(workerIdx, t))
+                    {
+                        m_popCount.fetch_add(1u, std::memory_order_acq_rel);
+                        return true;
+                    }
+                    return false;
+                }
+                //-----------------------------------------------------------------------------
+                //! \return The number of values a worker has taken from the deque or inbox of another worker.
+                auto getStealCount() const
+                -> std::size_t
+                {
+                    return m_stealCount.load(std::memory_order_relaxed);
+                }
+
+            private:
+                //-----------------------------------------------------------------------------
+                //! Pops a value for the given worker from its own containers, the overflow queue or the other workers.
+                auto popImpl(
+                    std::size_t const workerIdx,
+                    T & t)
+                -> bool
+                {
+                    auto const & workerTable(*m_workerTable.load(std::memory_order_acquire));
+                    auto & worker(*workerTable[workerIdx]);
+
+                    if(worker.m_deque.pop(t))
+                    {
+                        return true;
+                    }
+                    if(popInbox(worker, t))
+                    {
+                        return true;
+                    }
+                    if(popOverflow(t))
+                    {
+                        return true;
+                    }
+                    for(std::size_t i(1u); i < workerTable.size(); ++i)
+                    {
+                        auto & victim(*workerTable[(workerIdx + i) % workerTable.size()]);
+                        if(victim.m_deque.steal(t) || victim.m_inbox.pop(t))
+                        {
+                            m_stealCount.fetch_add(1u, std::memory_order_relaxed);
+                            return true;
+                        }
+                    }
+                    return false;
+                }
+                //-----------------------------------------------------------------------------
+                //! Pops a value from the inbox of the worker.
+                //! Additionally moves a batch of the following values into the deque of the worker,
+                //! so that they are popped without touching the inbox and can be stolen from the deque.
+                auto popInbox(
+                    Worker & worker,
+                    T & t)
+                -> bool
+                {
+                    if(!worker.m_inbox.pop(t))
+                    {
+                        return false;
+                    }
+
+                    std::array<T, maxBatchSize> batch;
+                    std::size_t batchSize(0u);
+                    while((batchSize < maxBatchSize) && worker.m_inbox.pop(batch[batchSize]))
+                    {
+                        ++batchSize;
+                    }
+                    // The deque is popped in LIFO order. Pushing the batch in reverse keeps the values in FIFO order.
+                    for(std::size_t i(batchSize); i > 0u; --i)
+                    {
+                        worker.m_deque.push(batch[i - 1u]);
+                    }
+
+                    return true;
+                }
+                //-----------------------------------------------------------------------------
+                //! Pops a value from the overflow queue.
+                auto popOverflow(
+                    T & t)
+                -> bool
+                {
+                    if(m_overflowCount.load(std::memory_order_acquire) == 0u)
+                    {
+                        return false;
+                    }
+
+                    std::lock_guard<std::mutex> lk(m_mtxOverflow);
+
+                    if(m_qOverflow.empty())
+                    {
+                        return false;
+                    }
+
+                    t = std::move(m_qOverflow.front());
+                    m_qOverflow.pop_front();
+                    m_overflowCount.fetch_sub(1u, std::memory_order_release);
+
+                    return true;
+                }
+
+            private:
+                static constexpr std::size_t inboxCapacity = 256u;
+                static constexpr std::size_t maxBatchSize = 32u;
+
+                std::vector<std::unique_ptr<Worker>> m_workers;
+                std::vector<std::unique_ptr<WorkerTable>> m_workerTables;
+                std::atomic<WorkerTable const *> m_workerTable;
+
+                std::mutex m_mtxOverflow;
+                std::deque<T> m_qOverflow;
+                std::atomic<std::size_t> m_overflowCount;
+
+                std::atomic<std::size_t> m_pushCount;           //!< The number of values pushed. Also selects the inbox of the next push.
+                std::atomic<std::size_t> m_popCount;            //!< The number of values returned by pop.
+
+                std::atomic<std::size_t> m_stealCount;
+            };
+
+            template<
+                typename T>
+            constexpr std::size_t WorkStealingQueue<T>::inboxCapacity;
+            template<
+                typename T>
+            constexpr std::size_t WorkStealingQueue<T>::maxBatchSize;
+        }
+    }
+}
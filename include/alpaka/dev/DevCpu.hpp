@@ -14,12 +14,17 @@
 #include <alpaka/pltf/Traits.hpp>
 
 #include <alpaka/queue/cpu/ICpuQueue.hpp>
+#include <alpaka/core/ThreadAffinity.hpp>
 #include <alpaka/core/Unused.hpp>
+#include <alpaka/dev/cpu/Numa.hpp>
 #include <alpaka/dev/cpu/SysInfo.hpp>
 
+#include <cstdint>
 #include <map>
 #include <mutex>
 #include <memory>
+#include <string>
+#include <utility>
 #include <vector>
 #include <algorithm>
 
@@ -91,7 +96,22 @@ namespace alpaka
 
                 public:
                     //-----------------------------------------------------------------------------
-                    DevCpuImpl() = default;
+                    DevCpuImpl() :
+                        m_bNumaNode(false),
+                        m_numaNodeIdx(0u),
+                        m_cpus(),
+                        m_affinityPolicy()
+                    {}
+                    //-----------------------------------------------------------------------------
+                    //! Constructs a device bound to the given NUMA node.
+                    DevCpuImpl(
+                        std::uint32_t const numaNodeIdx,
+                        std::vector<std::uint32_t> cpus) :
+                            m_bNumaNode(true),
+                            m_numaNodeIdx(numaNodeIdx),
+                            m_cpus(std::move(cpus)),
+                            m_affinityPolicy()
+                    {}
                     //-----------------------------------------------------------------------------
                     DevCpuImpl(DevCpuImpl const &) = delete;
                     //-----------------------------------------------------------------------------
@@ -117,13 +137,72 @@ namespace alpaka
                     {
                         std::lock_guard<std::mutex> lk(m_Mutex);
 
+                        // The device lives as long as the process, so the queues destroyed in the meantime are removed here.
+                        // Otherwise their storage would be kept alive by the weak pointers.
+                        m_queues.erase(
+                            std::remove_if(
+                                m_queues.begin(),
+                                m_queues.end(),
+                                [](std::weak_ptr<queue::cpu::ICpuQueue> const & wpQueue)
+                                {
+                                    return wpQueue.expired();
+                                }),
+                            m_queues.end());
+
                         // Register this queue on the device.
                         m_queues.push_back(spQueue);
                     }
 
+                    //-----------------------------------------------------------------------------
+                    //! \return If the device is bound to a NUMA node.
+                    ALPAKA_FN_HOST auto isNumaNode() const
+                    -> bool
+                    {
+                        return m_bNumaNode;
+                    }
+                    //-----------------------------------------------------------------------------
+                    //! \return The NUMA node the device is bound to. Only valid if isNumaNode() is true.
+                    ALPAKA_FN_HOST auto getNumaNodeIdx() const
+                    -> std::uint32_t
+                    {
+                        return m_numaNodeIdx;
+                    }
+                    //-----------------------------------------------------------------------------
+                    //! \return The logical CPUs of the NUMA node the device is bound to. Empty if the device is not bound to a NUMA node.
+                    ALPAKA_FN_HOST auto getCpuSet() const
+                    -> std::vector<std::uint32_t> const &
+                    {
+                        return m_cpus;
+                    }
+                    //-----------------------------------------------------------------------------
+                    //! \return The affinity policy of the queues created for this device afterwards.
+                    ALPAKA_FN_HOST auto getAffinityPolicy() const
+                    -> core::threads::AffinityPolicy
+                    {
+                        std::lock_guard<std::mutex> lk(m_Mutex);
+
+                        return m_affinityPolicy;
+                    }
+                    //-----------------------------------------------------------------------------
+                    //! Sets the affinity policy of the queues created for this device afterwards.
+                    ALPAKA_FN_HOST auto setAffinityPolicy(
+                        core::threads::AffinityPolicy const & affinityPolicy)
+                    -> void
+                    {
+                        std::lock_guard<std::mutex> lk(m_Mutex);
+
+                        m_affinityPolicy = affinityPolicy;
+                    }
+
                 private:
                     std::mutex mutable m_Mutex;
                     std::vector<std::weak_ptr<queue::cpu::ICpuQueue>> mutable m_queues;
+
+                    bool const m_bNumaNode;
+                    std::uint32_t const m_numaNodeIdx;
+                    std::vector<std::uint32_t> const m_cpus;
+
+                    core::threads::AffinityPolicy m_affinityPolicy;
                 };
             }
         }
@@ -138,6 +217,11 @@ namespace alpaka
             DevCpu() :
                 m_spDevCpuImpl(std::make_shared<cpu::detail::DevCpuImpl>())
             {}
+            //-----------------------------------------------------------------------------
+            DevCpu(
+                cpu::detail::NumaNode const & numaNode) :
+                    m_spDevCpuImpl(std::make_shared<cpu::detail::DevCpuImpl>(numaNode.m_nodeIdx, numaNode.m_cpus))
+            {}
         public:
             //-----------------------------------------------------------------------------
             DevCpu(DevCpu const &) = default;
@@ -148,10 +232,12 @@ namespace alpaka
             //-----------------------------------------------------------------------------
             auto operator=(DevCpu &&) -> DevCpu & = default;
             //-----------------------------------------------------------------------------
-            auto operator==(DevCpu const &) const
+            auto operator==(DevCpu const & rhs) const
             -> bool
             {
-                return true;
+                // Devices are equal if they are bound to the same NUMA node or both are not bound to any.
+                return (m_spDevCpuImpl->isNumaNode() == rhs.m_spDevCpuImpl->isNumaNode())
+                    && (m_spDevCpuImpl->getNumaNodeIdx() == rhs.m_spDevCpuImpl->getNumaNodeIdx());
             }
             //-----------------------------------------------------------------------------
             auto operator!=(DevCpu const & rhs) const
@@ -167,6 +253,62 @@ namespace alpaka
         };
     }
 
+    namespace dev
+    {
+        namespace cpu
+        {
+            //-----------------------------------------------------------------------------
+            //! \return The logical CPUs of the device. These are the CPUs of its NUMA node or the CPUs the calling thread may run on if it is not bound to a node.
+            ALPAKA_FN_HOST inline auto getCpuSet(
+                DevCpu const & dev)
+            -> std::vector<std::uint32_t>
+            {
+                auto const & cpus(dev.m_spDevCpuImpl->getCpuSet());
+                return cpus.empty() ? core::threads::getCurrentThreadAffinity() : cpus;
+            }
+            //-----------------------------------------------------------------------------
+            //! \return The affinity policy of the queues created for the device.
+            ALPAKA_FN_HOST inline auto getAffinityPolicy(
+                DevCpu const & dev)
+            -> core::threads::AffinityPolicy
+            {
+                return dev.m_spDevCpuImpl->getAffinityPolicy();
+            }
+            //-----------------------------------------------------------------------------
+            //! Sets the affinity policy of the queues created for the device afterwards.
+            //!
+            //! Queues created before keep their policy.
+            //! The policy is stored in the device implementation the platform keeps for every device index.
+            //! It is therefore visible through every handle returned by pltf::getDevByIdx for the same index, as long as the NUMA aware mode is not switched.
+            ALPAKA_FN_HOST inline auto setAffinityPolicy(
+                DevCpu const & dev,
+                core::threads::AffinityPolicy const & affinityPolicy)
+            -> void
+            {
+                dev.m_spDevCpuImpl->setAffinityPolicy(affinityPolicy);
+            }
+
+            namespace detail
+            {
+                //-----------------------------------------------------------------------------
+                //! \return The logical CPUs a queue worker executing with the given policy is restricted to.
+                //! This is the CPU of the first worker of the policy.
+                //! The block threads of its kernels start on the same CPU because the queue worker only waits for them meanwhile.
+                //! For the inherit policy the worker is only restricted to the NUMA node of the device if it is bound to one.
+                ALPAKA_FN_HOST inline auto getQueueWorkerCpus(
+                    DevCpu const & dev,
+                    core::threads::AffinityPolicy const & affinityPolicy)
+                -> std::vector<std::uint32_t>
+                {
+                    if(affinityPolicy.getKind() == core::threads::AffinityPolicy::Kind::Inherit)
+                    {
+                        return dev.m_spDevCpuImpl->getCpuSet();
+                    }
+                    return affinityPolicy.getWorkerCpus(0u);
+                }
+            }
+        }
+    }
     namespace dev
     {
         namespace traits
@@ -182,7 +324,10 @@ namespace alpaka
                     dev::DevCpu const & dev)
                 -> std::string
                 {
-                    alpaka::ignore_unused(dev);
+                    if(dev.m_spDevCpuImpl->isNumaNode())
+                    {
+                        return dev::cpu::detail::getCpuName() + " (NUMA node " + std::to_string(dev.m_spDevCpuImpl->getNumaNodeIdx()) + ")";
+                    }
 
                     return dev::cpu::detail::getCpuName();
                 }
@@ -199,7 +344,14 @@ namespace alpaka
                     dev::DevCpu const & dev)
                 -> std::size_t
                 {
-                    alpaka::ignore_unused(dev);
+                    if(dev.m_spDevCpuImpl->isNumaNode())
+                    {
+                        auto const memBytes(dev::cpu::detail::getNumaNodeMemInfoBytes(dev.m_spDevCpuImpl->getNumaNodeIdx(), "MemTotal"));
+                        if(memBytes > 0u)
+                        {
+                            return memBytes;
+                        }
+                    }
 
                     return dev::cpu::detail::getTotalGlobalMemSizeBytes();
                 }
@@ -216,7 +368,14 @@ namespace alpaka
                     dev::DevCpu const & dev)
                 -> std::size_t
                 {
-                    alpaka::ignore_unused(dev);
+                    if(dev.m_spDevCpuImpl->isNumaNode())
+                    {
+                        auto const memBytes(dev::cpu::detail::getNumaNodeMemInfoBytes(dev.m_spDevCpuImpl->getNumaNodeIdx(), "MemFree"));
+                        if(memBytes > 0u)
+                        {
+                            return memBytes;
+                        }
+                    }
 
                     return dev::cpu::detail::getFreeGlobalMemSizeBytes();
                 }
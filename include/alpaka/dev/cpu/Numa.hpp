@@ -0,0 +1,210 @@
+/* Copyright 2019 Benjamin Worpitz
+ *
+ * This file is part of Alpaka.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <alpaka/core/BoostPredef.hpp>
+#include <alpaka/core/Unused.hpp>
+
+#if BOOST_OS_LINUX
+    #include <sys/syscall.h>
+    #include <unistd.h>
+    #include <fstream>
+#endif
+
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace alpaka
+{
+    namespace dev
+    {
+        namespace cpu
+        {
+            namespace detail
+            {
+                //#############################################################################
+                //! A NUMA node with its logical CPUs.
+                struct NumaNode
+                {
+                    std::uint32_t m_nodeIdx;
+                    std::vector<std::uint32_t> m_cpus;
+                };
+
+                //-----------------------------------------------------------------------------
+                //! Parses a list of indices in the format used by the Linux kernel (e.g. "0-3,8,10-11").
+                //! \return The indices in ascending order if the list is sorted.
+                inline auto parseIdxList(
+                    std::string const & idxList)
+                -> std::vector<std::uint32_t>
+                {
+                    std::vector<std::uint32_t> indices;
+
+                    std::stringstream ssList(idxList);
+                    std::string range;
+                    while(std::getline(ssList, range, ','))
+                    {
+                        std::stringstream ssRange(range);
+                        std::uint32_t first(0u);
+                        if(!(ssRange >> first))
+                        {
+                            continue;
+                        }
+                        std::uint32_t last(first);
+                        char separator('\0');
+                        if(ssRange >> separator)
+                        {
+                            if((separator != '-') || !(ssRange >> last))
+                            {
+                                continue;
+                            }
+                        }
+                        for(std::uint32_t idx(first); idx <= last; ++idx)
+                        {
+                            indices.push_back(idx);
+                        }
+                    }
+
+                    return indices;
+                }
+
+#if BOOST_OS_LINUX
+                //-----------------------------------------------------------------------------
+                //! \return The first line of the given file or an empty string if it can not be read.
+                inline auto readFirstLine(
+                    std::string const & fileName)
+                -> std::string
+                {
+                    std::string line;
+                    std::ifstream file(fileName);
+                    if(file)
+                    {
+                        std::getline(file, line);
+                    }
+                    return line;
+                }
+#endif
+
+                //-----------------------------------------------------------------------------
+                //! Reads the NUMA nodes having CPUs from /sys/devices/system/node.
+                //! \return The NUMA nodes or an empty vector if the topology is not available.
+                inline auto readNumaNodes()
+                -> std::vector<NumaNode>
+                {
+                    std::vector<NumaNode> numaNodes;
+#if BOOST_OS_LINUX
+                    for(auto const nodeIdx : parseIdxList(readFirstLine("/sys/devices/system/node/online")))
+                    {
+                        auto cpus(parseIdxList(readFirstLine("/sys/devices/system/node/node" + std::to_string(nodeIdx) + "/cpulist")));
+                        // Nodes only providing memory can not execute kernels.
+                        if(!cpus.empty())
+                        {
+                            numaNodes.push_back(NumaNode{nodeIdx, std::move(cpus)});
+                        }
+                    }
+#endif
+                    return numaNodes;
+                }
+
+                //-----------------------------------------------------------------------------
+                //! \return The NUMA nodes having CPUs. The topology is read only once.
+                inline auto getNumaNodes()
+                -> std::vector<NumaNode> const &
+                {
+#if BOOST_COMP_CLANG
+    #pragma clang diagnostic push
+    #pragma clang diagnostic ignored "-Wexit-time-destructors"
+#endif
+                    static std::vector<NumaNode> const numaNodes(readNumaNodes());
+#if BOOST_COMP_CLANG
+    #pragma clang diagnostic pop
+#endif
+                    return numaNodes;
+                }
+
+                //-----------------------------------------------------------------------------
+                //! \return The value of the given entry of /sys/devices/system/node/node<nodeIdx>/meminfo in bytes or 0 if it is not available.
+                inline auto getNumaNodeMemInfoBytes(
+                    std::uint32_t const nodeIdx,
+                    std::string const & entry)
+                -> std::size_t
+                {
+#if BOOST_OS_LINUX
+                    // The lines have the format "Node 0 MemTotal:       16314640 kB".
+                    std::ifstream file("/sys/devices/system/node/node" + std::to_string(nodeIdx) + "/meminfo");
+                    std::string line;
+                    while(std::getline(file, line))
+                    {
+                        std::stringstream ssLine(line);
+                        std::string node;
+                        std::uint32_t idx(0u);
+                        std::string token;
+                        std::size_t valueKiB(0u);
+                        if((ssLine >> node >> idx >> token >> valueKiB) && (token == entry + ":"))
+                        {
+                            return valueKiB * std::size_t(1024);
+                        }
+                    }
+#else
+                    alpaka::ignore_unused(nodeIdx, entry);
+#endif
+                    return 0u;
+                }
+
+                //-----------------------------------------------------------------------------
+                //! Sets the given NUMA node as the preferred node of the pages completely within the given memory range.
+                //!
+                //! The pages are only allocated on the node when they are touched first. They are allocated on other nodes if the node is out of memory.
+                //! The memory may come from the heap or a cache and the policy stays with the pages after they have been freed.
+                //! Therefore, the node is only preferred instead of strictly bound, so that later allocations reusing the pages can never fail because of it.
+                //! Pages only partially within the range may be shared with other allocations and are therefore left unchanged.
+                //! This is best effort. Errors (e.g. because the kernel does not support NUMA) are ignored.
+                inline auto bindMemToNumaNode(
+                    void * const pMem,
+                    std::size_t const sizeBytes,
+                    std::uint32_t const nodeIdx)
+                -> void
+                {
+#if BOOST_OS_LINUX && defined(SYS_mbind)
+                    auto const pageSize(static_cast<std::uintptr_t>(sysconf(_SC_PAGESIZE)));
+                    auto const begin(reinterpret_cast<std::uintptr_t>(pMem));
+                    auto const beginPage((begin + pageSize - 1u) / pageSize * pageSize);
+                    auto const endPage((begin + sizeBytes) / pageSize * pageSize);
+                    if(endPage <= beginPage)
+                    {
+                        return;
+                    }
+
+                    // The node mask is an array of unsigned long with one bit per node.
+                    std::size_t const bitsPerWord(sizeof(unsigned long) * 8u);
+                    std::vector<unsigned long> nodeMask(nodeIdx / bitsPerWord + 1u, 0ul);
+                    nodeMask[nodeIdx / bitsPerWord] |= 1ul << (nodeIdx % bitsPerWord);
+
+                    // MPOL_PREFERRED from <linux/mempolicy.h> which is not included to avoid the dependency on the kernel headers.
+                    int const mpolPreferred(1);
+                    ::syscall(
+                        SYS_mbind,
+                        beginPage,
+                        endPage - beginPage,
+                        mpolPreferred,
+                        nodeMask.data(),
+                        nodeMask.size() * bitsPerWord + 1u,
+                        0u);
+#else
+                    alpaka::ignore_unused(pMem, sizeBytes, nodeIdx);
+#endif
+                }
+            }
+        }
+    }
+}
@@ -9,7 +9,7 @@
 
 #pragma once
 
-#include <alpaka/core/Assert.hpp>
+#include <alpaka/core/Futex.hpp>
 #include <alpaka/core/Unused.hpp>
 #include <alpaka/dev/DevCpu.hpp>
 #include <alpaka/queue/QueueCpuNonBlocking.hpp>
@@ -20,9 +20,16 @@
 #include <alpaka/wait/Traits.hpp>
 #include <alpaka/dev/Traits.hpp>
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <mutex>
-#include <condition_variable>
-#include <future>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
 #if ALPAKA_DEBUG >= ALPAKA_DEBUG_MINIMAL
     #include <iostream>
 #endif
@@ -37,16 +44,30 @@ namespace alpaka
             {
                 //#############################################################################
                 //! The CPU device event implementation.
+                //!
+                //! The state is a single atomic word containing the number of times the event has been enqueued and the number of the latest enqueue that has been completed.
+                //! Testing the event is a single atomic load. The queue worker completing an enqueue only takes a lock to record the completion time.
+                //! Threads waiting for the event are parked on a futex which is only signaled if there are waiters.
+                //! Queues waiting for the event register continuations which are executed by the queue that completes the enqueue, so that no thread is blocked while waiting.
                 class EventCpuImpl final
                 {
+                    //! The enqueue count is stored in the upper and the ready count in the lower 32 bits of the state.
+                    static constexpr std::uint64_t enqueueCountOne = std::uint64_t(1u) << 32u;
+                    static constexpr std::uint64_t enqueueCountMask = ~(enqueueCountOne - 1u);
+
                 public:
                     //-----------------------------------------------------------------------------
                     EventCpuImpl(
                         dev::DevCpu const & dev) noexcept :
                             m_dev(dev),
-                            m_mutex(),
-                            m_enqueueCount(0u),
-                            m_LastReadyEnqueueCount(0u)
+                            m_state(0u),
+                            m_readySignal(0u),
+                            m_mtxReadyTime(),
+                            m_readyTimeCount(0u),
+                            m_readyTimeNs(0),
+                            m_mtxContinuations(),
+                            m_continuations(),
+                            m_continuationCount(0u)
                     {}
                     //-----------------------------------------------------------------------------
                     EventCpuImpl(EventCpuImpl const &) = delete;
@@ -60,34 +81,226 @@ namespace alpaka
                     ~EventCpuImpl() noexcept = default;
 
                     //-----------------------------------------------------------------------------
-                    auto isReady() noexcept -> bool
+                    //! Marks the event as enqueued once more.
+                    //! \return The enqueue count identifying this enqueue.
+                    auto enqueue() noexcept -> std::uint32_t
+                    {
+                        return getEnqueueCount(m_state.fetch_add(enqueueCountOne, std::memory_order_acq_rel) + enqueueCountOne);
+                    }
+
+                    //-----------------------------------------------------------------------------
+                    //! Reverts the enqueue with the given enqueue count because it has not been passed to a queue.
+                    //!
+                    //! Only the latest enqueue is reverted. An earlier one is covered by the completion of the later enqueues.
+                    auto cancelEnqueue(std::uint32_t const enqueueCount) noexcept -> void
+                    {
+                        auto state(m_state.load(std::memory_order_relaxed));
+                        while(getEnqueueCount(state) == enqueueCount)
+                        {
+                            if(m_state.compare_exchange_weak(state, state - enqueueCountOne, std::memory_order_acq_rel, std::memory_order_relaxed))
+                            {
+                                return;
+                            }
+                        }
+                    }
+
+                    //-----------------------------------------------------------------------------
+                    //! \return The enqueue count of the latest enqueue.
+                    auto getEnqueueCount() const noexcept -> std::uint32_t
+                    {
+                        return getEnqueueCount(m_state.load(std::memory_order_acquire));
+                    }
+
+                    //-----------------------------------------------------------------------------
+                    //! \return If the event is not waiting within a queue (not enqueued or already completed).
+                    auto isReady() const noexcept -> bool
+                    {
+                        auto const state(m_state.load(std::memory_order_acquire));
+                        return getEnqueueCount(state) == getReadyCount(state);
+                    }
+
+                    //-----------------------------------------------------------------------------
+                    //! \return If the enqueue with the given enqueue count has been completed.
+                    auto isReady(std::uint32_t const enqueueCount) const noexcept -> bool
+                    {
+                        return isReached(getReadyCount(m_state.load(std::memory_order_acquire)), enqueueCount);
+                    }
+
+                    //-----------------------------------------------------------------------------
+                    //! Blocks the calling thread until the enqueue with the given enqueue count has been completed.
+                    auto wait(std::uint32_t const enqueueCount) noexcept -> void
+                    {
+                        while(true)
+                        {
+                            auto const signal(m_readySignal.load());
+                            if(isReady(enqueueCount))
+                            {
+                                return;
+                            }
+                            m_readySignal.wait(signal);
+                        }
+                    }
+
+                    //-----------------------------------------------------------------------------
+                    //! Registers a function object which is called as soon as the enqueue with the given enqueue count has been completed.
+                    //!
+                    //! The function object is called by the thread completing the enqueue and therefore has to be short and must not block.
+                    //! \return If the function object has been registered. If the enqueue has already been completed, it is not registered and the caller has to handle this itself.
+                    template<
+                        typename TFnObj>
+                    auto addContinuation(
+                        std::uint32_t const enqueueCount,
+                        TFnObj && continuation)
+                    -> bool
+                    {
+                        std::lock_guard<std::mutex> lk(m_mtxContinuations);
+
+                        // The count has to be incremented before the state is checked so that a concurrent setReady either sees the continuation or the continuation sees the new state.
+                        m_continuationCount.fetch_add(1u, std::memory_order_seq_cst);
+                        if(isReached(getReadyCount(m_state.load(std::memory_order_seq_cst)), enqueueCount))
+                        {
+                            m_continuationCount.fetch_sub(1u, std::memory_order_relaxed);
+                            return false;
+                        }
+
+                        m_continuations.emplace_back(enqueueCount, std::forward<TFnObj>(continuation));
+                        return true;
+                    }
+
+                    //-----------------------------------------------------------------------------
+                    //! Marks the enqueue with the given enqueue count as completed, wakes up the waiting threads and calls the continuations that are ready.
+                    //!
+                    //! An enqueue which is completed after a later one (in a different queue) does not change the state anymore.
+                    auto setReady(std::uint32_t const enqueueCount) -> void
+                    {
+                        auto const readyTimeNs(getTimeNs());
+
+                        auto state(m_state.load(std::memory_order_relaxed));
+                        while(true)
+                        {
+                            if(isReached(getReadyCount(state), enqueueCount))
+                            {
+                                return;
+                            }
+                            if(m_state.compare_exchange_weak(state, (state & enqueueCountMask) | enqueueCount, std::memory_order_seq_cst, std::memory_order_relaxed))
+                            {
+                                break;
+                            }
+                        }
+
+                        // Only the enqueue which has set the ready count records its time.
+                        // A later enqueue completed in between (in a different queue) has already recorded the newer time, which is kept.
+                        {
+                            std::lock_guard<std::mutex> lk(m_mtxReadyTime);
+                            if(isReached(enqueueCount, m_readyTimeCount))
+                            {
+                                m_readyTimeCount = enqueueCount;
+                                m_readyTimeNs = readyTimeNs;
+                            }
+                        }
+
+                        m_readySignal.fetchAdd(1u);
+                        m_readySignal.notifyAll();
+
+                        if(m_continuationCount.load(std::memory_order_seq_cst) != 0u)
+                        {
+                            callContinuations(enqueueCount);
+                        }
+                    }
+
+                    //-----------------------------------------------------------------------------
+                    //! \return The time of the completion of the latest completed enqueue in nanoseconds of the steady clock.
+                    //!
+                    //! The time is recorded by the completing queue directly after the ready count has been set.
+                    //! If it has not been recorded yet, this waits for the completing queue, which does not block in between.
+                    auto getReadyTimeNs() const -> std::int64_t
                     {
-                        return (m_LastReadyEnqueueCount == m_enqueueCount);
+                        while(true)
+                        {
+                            auto const readyCount(getReadyCount(m_state.load(std::memory_order_acquire)));
+                            {
+                                std::lock_guard<std::mutex> lk(m_mtxReadyTime);
+                                if(m_readyTimeCount == readyCount)
+                                {
+                                    return m_readyTimeNs;
+                                }
+                            }
+                            std::this_thread::yield();
+                        }
                     }
 
                     //-----------------------------------------------------------------------------
-                    auto wait(std::size_t const & enqueueCount, std::unique_lock<std::mutex>& lk) noexcept -> void
+                    //! \return The current time in nanoseconds of the steady clock.
+                    static auto getTimeNs() noexcept -> std::int64_t
                     {
-                        ALPAKA_ASSERT(enqueueCount <= m_enqueueCount);
+                        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+                    }
 
-                        while(enqueueCount > m_LastReadyEnqueueCount)
+                private:
+                    //-----------------------------------------------------------------------------
+                    //! Calls and removes all continuations of enqueues which have been completed together with the given one.
+                    auto callContinuations(std::uint32_t const readyCount) -> void
+                    {
+                        std::vector<std::function<void()>> readyContinuations;
                         {
-                            auto future = m_future;
-                            lk.unlock();
-                            future.get();
-                            lk.lock();
+                            std::lock_guard<std::mutex> lk(m_mtxContinuations);
+
+                            auto itKeep(m_continuations.begin());
+                            for(auto it(m_continuations.begin()); it != m_continuations.end(); ++it)
+                            {
+                                if(isReached(readyCount, it->first))
+                                {
+                                    readyContinuations.emplace_back(std::move(it->second));
+                                }
+                                else
+                                {
+                                    if(itKeep != it)
+                                    {
+                                        *itKeep = std::move(*it);
+                                    }
+                                    ++itKeep;
+                                }
+                            }
+                            m_continuations.erase(itKeep, m_continuations.end());
+                            m_continuationCount.fetch_sub(static_cast<std::uint32_t>(readyContinuations.size()), std::memory_order_relaxed);
+                        }
+
+                        // The continuations are called without holding the lock so that they are allowed to register further continuations.
+                        for(auto const & continuation : readyContinuations)
+                        {
+                            continuation();
                         }
                     }
+                    //-----------------------------------------------------------------------------
+                    static auto getEnqueueCount(std::uint64_t const state) noexcept -> std::uint32_t
+                    {
+                        return static_cast<std::uint32_t>(state >> 32u);
+                    }
+                    //-----------------------------------------------------------------------------
+                    static auto getReadyCount(std::uint64_t const state) noexcept -> std::uint32_t
+                    {
+                        return static_cast<std::uint32_t>(state);
+                    }
+                    //-----------------------------------------------------------------------------
+                    //! \return If the count has reached the target count. The counts are allowed to wrap around.
+                    static auto isReached(std::uint32_t const count, std::uint32_t const targetCount) noexcept -> bool
+                    {
+                        return (count - targetCount) < 0x80000000u;
+                    }
 
                 public:
                     dev::DevCpu const m_dev;                                //!< The device this event is bound to.
 
-                    std::mutex mutable m_mutex;                             //!< The mutex used to synchronize access to the event.
-                    std::shared_future<void> m_future;                      //!< The future signaling the event completion.
-                    std::size_t m_enqueueCount;                             //!< The number of times this event has been enqueued.
-                    std::size_t m_LastReadyEnqueueCount;                    //!< The time this event has been ready the last time.
-                                                                            //!< Ready means that the event was not waiting within a queue (not enqueued or already completed).
-                                                                            //!< If m_enqueueCount == m_LastReadyEnqueueCount, the event is currently not enqueued
+                private:
+                    std::atomic<std::uint64_t> m_state;                     //!< The enqueue count and the ready count.
+                    core::threads::Futex m_readySignal;                     //!< Incremented after each change of the ready count.
+                    mutable std::mutex m_mtxReadyTime;
+                    std::uint32_t m_readyTimeCount;                         //!< The ready count m_readyTimeNs belongs to.
+                    std::int64_t m_readyTimeNs;                             //!< The time the latest completed enqueue has been passed by the queue.
+
+                    std::mutex m_mtxContinuations;
+                    std::vector<std::pair<std::uint32_t, std::function<void()>>> m_continuations;   //!< The enqueue counts and the continuations waiting for them.
+                    std::atomic<std::uint32_t> m_continuationCount;         //!< The number of registered continuations. setReady only takes the lock if it is not zero.
                 };
             }
         }
@@ -170,15 +383,129 @@ namespace alpaka
                     event::EventCpu const & event)
                 -> bool
                 {
-                    std::lock_guard<std::mutex> lk(event.m_spEventImpl->m_mutex);
-
                     return event.m_spEventImpl->isReady();
                 }
             };
+            //#############################################################################
+            //! The CPU device event elapsed time trait specialization.
+            template<>
+            struct ElapsedTime<
+                event::EventCpu>
+            {
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST static auto elapsedTime(
+                    event::EventCpu const & eventStart,
+                    event::EventCpu const & eventEnd)
+                -> double
+                {
+                    auto const & eventImplStart(*eventStart.m_spEventImpl);
+                    auto const & eventImplEnd(*eventEnd.m_spEventImpl);
+
+                    if((eventImplStart.getEnqueueCount() == 0u) || (eventImplEnd.getEnqueueCount() == 0u))
+                    {
+                        throw std::runtime_error("The elapsed time can only be measured between events that have been enqueued!");
+                    }
+                    if(!eventImplStart.isReady() || !eventImplEnd.isReady())
+                    {
+                        throw std::runtime_error("The elapsed time can only be measured between events that have been completed!");
+                    }
+
+                    return static_cast<double>(eventImplEnd.getReadyTimeNs() - eventImplStart.getReadyTimeNs()) * 1.0e-6;
+                }
+            };
         }
     }
     namespace queue
     {
+        namespace cpu
+        {
+            namespace detail
+            {
+                //#############################################################################
+                //! The task ring function object conversion trait specialization for events.
+                //!
+                //! The event is marked as enqueued and the returned function object marks this enqueue as completed when it is executed by the queue worker.
+                //! If the function object is destroyed without having been executed, e.g. because the task ring could not store it, the enqueue is reverted.
+                template<>
+                struct MakeTaskRingFnObj<
+                    event::EventCpu>
+                {
+                    //#############################################################################
+                    class type final
+                    {
+                    public:
+                        //-----------------------------------------------------------------------------
+                        type(
+                            std::shared_ptr<event::cpu::detail::EventCpuImpl> const & spEventImpl,
+                            std::uint32_t const & enqueueCount) :
+                                m_spEventImpl(spEventImpl),
+                                m_enqueueCount(enqueueCount),
+                                m_bPending(true)
+                        {}
+                        //-----------------------------------------------------------------------------
+                        type(type const &) = delete;
+                        //-----------------------------------------------------------------------------
+                        type(type && other) noexcept :
+                            m_spEventImpl(std::move(other.m_spEventImpl)),
+                            m_enqueueCount(other.m_enqueueCount),
+                            m_bPending(other.m_bPending)
+                        {
+                            other.m_bPending = false;
+                        }
+                        //-----------------------------------------------------------------------------
+                        auto operator=(type const &) -> type & = delete;
+                        //-----------------------------------------------------------------------------
+                        auto operator=(type &&) -> type & = delete;
+                        //-----------------------------------------------------------------------------
+                        ~type()
+                        {
+                            cancel();
+                        }
+
+                        //-----------------------------------------------------------------------------
+                        auto operator()() const
+                        -> void
+                        {
+                            m_bPending = false;
+                            m_spEventImpl->setReady(m_enqueueCount);
+                        }
+                        //-----------------------------------------------------------------------------
+                        //! Reverts the enqueue if the function object has neither been executed nor moved.
+                        auto cancel() noexcept
+                        -> void
+                        {
+                            if(m_bPending)
+                            {
+                                m_bPending = false;
+                                m_spEventImpl->cancelEnqueue(m_enqueueCount);
+                            }
+                        }
+
+                    private:
+                        // The shared pointer ensures that the event implementation is alive as long as it is enqueued.
+                        std::shared_ptr<event::cpu::detail::EventCpuImpl> m_spEventImpl;
+                        std::uint32_t m_enqueueCount;
+                        bool mutable m_bPending;
+                    };
+
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST static auto makeTaskRingFnObj(
+                        QueueCpuNonBlockingImpl &,
+                        event::EventCpu const & event)
+                    -> type
+                    {
+                        return type(event.m_spEventImpl, event.m_spEventImpl->enqueue());
+                    }
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST static auto cancelTaskRingFnObj(
+                        type & fnObj) noexcept
+                    -> void
+                    {
+                        fnObj.cancel();
+                    }
+                };
+            }
+        }
         namespace traits
         {
             //#############################################################################
@@ -200,31 +527,17 @@ namespace alpaka
                 {
                     ALPAKA_DEBUG_MINIMAL_LOG_SCOPE;
 
-                    // Copy the shared pointer of the event implementation.
-                    // This is forwarded to the lambda that is enqueued into the queue to ensure that the event implementation is alive as long as it is enqueued.
-                    auto spEventImpl(event.m_spEventImpl);
-
-                    // Setting the event state and enqueuing it has to be atomic.
-                    std::lock_guard<std::mutex> lk(spEventImpl->m_mutex);
-
-                    ++spEventImpl->m_enqueueCount;
-
 // Workaround: Clang can not support this when natively compiling device code. See ConcurrentExecPool.hpp.
 #if !(BOOST_COMP_CLANG_CUDA && BOOST_ARCH_PTX)
-                    auto const enqueueCount = spEventImpl->m_enqueueCount;
-
-                    // Enqueue a task that only resets the events flag if it is completed.
-                    spEventImpl->m_future = queueImpl.m_workerThread.enqueueTask(
-                        [spEventImpl, enqueueCount]()
-                        {
-                            std::unique_lock<std::mutex> lk2(spEventImpl->m_mutex);
+                    {
+                        std::lock_guard<std::mutex> lk(queueImpl.m_mutex);
+                        graph::cpu::detail::throwIfCapturing(queueImpl.m_spCapturedGraph);
+                    }
 
-                            // Nothing to do if it has been re-enqueued to a later position in the queue.
-                            if(enqueueCount == spEventImpl->m_enqueueCount)
-                            {
-                                spEventImpl->m_LastReadyEnqueueCount = spEventImpl->m_enqueueCount;
-                            }
-                        });
+                    queueImpl.m_taskRing.enqueue(
+                        queue::cpu::detail::MakeTaskRingFnObj<event::EventCpu>::makeTaskRingFnObj(queueImpl, event));
+#else
+                    alpaka::ignore_unused(event);
 #endif
                 }
             };
@@ -261,28 +574,18 @@ namespace alpaka
                 {
                     ALPAKA_DEBUG_MINIMAL_LOG_SCOPE;
 
-                    std::promise<void> promise;
-                    {
-                        std::lock_guard<std::mutex> lk(queueImpl.m_mutex);
-
-                        queueImpl.m_bCurrentlyExecutingTask = true;
+                    std::lock_guard<std::mutex> lk(queueImpl.m_mutex);
 
-                        auto spEventImpl(event.m_spEventImpl);
+                    graph::cpu::detail::throwIfCapturing(queueImpl.m_spCapturedGraph);
 
-                        {
-                            // Setting the event state and enqueuing it has to be atomic.
-                            std::lock_guard<std::mutex> evLk(spEventImpl->m_mutex);
+                    queueImpl.m_bCurrentlyExecutingTask = true;
 
-                            ++spEventImpl->m_enqueueCount;
-                            // NOTE: Difference to non-blocking version: directly set the event state instead of enqueuing.
-                            spEventImpl->m_LastReadyEnqueueCount = spEventImpl->m_enqueueCount;
+                    auto & eventImpl(*event.m_spEventImpl);
 
-                            spEventImpl->m_future = promise.get_future();
-                        }
+                    // NOTE: Difference to non-blocking version: directly set the event state instead of enqueuing.
+                    eventImpl.setReady(eventImpl.enqueue());
 
-                        queueImpl.m_bCurrentlyExecutingTask = false;
-                    }
-                    promise.set_value();
+                    queueImpl.m_bCurrentlyExecutingTask = false;
                 }
             };
             //#############################################################################
@@ -342,10 +645,7 @@ namespace alpaka
                     std::shared_ptr<event::cpu::detail::EventCpuImpl> const & spEventImpl)
                 -> void
                 {
-                    std::unique_lock<std::mutex> lk(spEventImpl->m_mutex);
-
-                    auto const enqueueCount = spEventImpl->m_enqueueCount;
-                    spEventImpl->wait(enqueueCount, lk);
+                    spEventImpl->wait(spEventImpl->getEnqueueCount());
                 }
             };
             //#############################################################################
@@ -365,25 +665,32 @@ namespace alpaka
                     event::EventCpu const & event)
                 -> void
                 {
+// Workaround: Clang can not support this when natively compiling device code. See ConcurrentExecPool.hpp.
+#if !(BOOST_COMP_CLANG_CUDA && BOOST_ARCH_PTX)
+                    {
+                        std::lock_guard<std::mutex> lk(queueImpl.m_mutex);
+                        graph::cpu::detail::throwIfCapturing(queueImpl.m_spCapturedGraph);
+                    }
+#endif
+
                     // Copy the shared pointer of the event implementation.
                     // This is forwarded to the lambda that is enqueued into the queue to ensure that the event implementation is alive as long as it is enqueued.
                     auto spEventImpl(event.m_spEventImpl);
 
-                    std::lock_guard<std::mutex> lk(spEventImpl->m_mutex);
+                    auto const enqueueCount(spEventImpl->getEnqueueCount());
 
-                    if(!spEventImpl->isReady())
+                    if(!spEventImpl->isReady(enqueueCount))
                     {
 // Workaround: Clang can not support this when natively compiling device code. See ConcurrentExecPool.hpp.
 #if !(BOOST_COMP_CLANG_CUDA && BOOST_ARCH_PTX)
-                        auto const enqueueCount = spEventImpl->m_enqueueCount;
 
-                        // Enqueue a task that waits for the given event.
-                        queueImpl.m_workerThread.enqueueTask(
-                            [spEventImpl, enqueueCount]()
-                            {
-                                std::unique_lock<std::mutex> lk2(spEventImpl->m_mutex);
-                                spEventImpl->wait(enqueueCount, lk2);
-                            });
+                        // Park the tasks enqueued afterwards behind a gate which is opened by the queue completing the event.
+                        // No thread is blocked while waiting. The worker is idle until the gate is opened.
+                        auto const gate(queueImpl.m_taskRing.enqueueGate());
+                        if(!spEventImpl->addContinuation(enqueueCount, gate))
+                        {
+                            gate();
+                        }
 #endif
                     }
                 }
@@ -417,7 +724,7 @@ namespace alpaka
                     event::EventCpu const & event)
                 -> void
                 {
-                    alpaka::ignore_unused(queueImpl);
+                    graph::cpu::detail::throwIfCapturing(queueImpl.m_spCapturedGraph);
 
                     // Copy the shared pointer of the event implementation.
                     // This is forwarded to the lambda that is enqueued into the queue to ensure that the event implementation is alive as long as it is enqueued.
@@ -470,29 +777,6 @@ namespace alpaka
                     }
                 }
             };
-
-            //#############################################################################
-            //! The CPU non-blocking device queue thread wait trait specialization.
-            //!
-            //! Blocks execution of the calling thread until the queue has finished processing all previously requested tasks (kernels, data copies, ...)
-            template<>
-            struct CurrentThreadWaitFor<
-                queue::QueueCpuNonBlocking>
-            {
-                //-----------------------------------------------------------------------------
-                ALPAKA_FN_HOST static auto currentThreadWaitFor(
-                    queue::QueueCpuNonBlocking const & queue)
-                -> void
-                {
-                    event::EventCpu event(
-                        dev::getDev(queue));
-                    queue::enqueue(
-                        const_cast<queue::QueueCpuNonBlocking &>(queue),
-                        event);
-                    wait::wait(
-                        event);
-                }
-            };
         }
     }
 }
@@ -36,6 +36,13 @@ namespace alpaka
                 typename TEvent,
                 typename TSfinae = void>
             struct Test;
+
+            //#############################################################################
+            //! The event elapsed time trait.
+            template<
+                typename TEvent,
+                typename TSfinae = void>
+            struct ElapsedTime;
         }
 
         //#############################################################################
@@ -58,5 +65,24 @@ namespace alpaka
                 ::test(
                     event);
         }
+
+        //-----------------------------------------------------------------------------
+        //! \return The time in milliseconds elapsed between the completion of the two events.
+        //!
+        //! Both events have to be completed. The time is taken when the queue passes the event, so it does not require waiting for the queue.
+        template<
+            typename TEvent>
+        ALPAKA_FN_HOST auto elapsedTime(
+            TEvent const & eventStart,
+            TEvent const & eventEnd)
+        -> double
+        {
+            return
+                traits::ElapsedTime<
+                    TEvent>
+                ::elapsedTime(
+                    eventStart,
+                    eventEnd);
+        }
     }
 }
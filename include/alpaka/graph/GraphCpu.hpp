@@ -0,0 +1,173 @@
+/* Copyright 2019 Benjamin Worpitz
+ *
+ * This file is part of Alpaka.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <alpaka/core/Common.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace alpaka
+{
+    namespace graph
+    {
+        namespace cpu
+        {
+            namespace detail
+            {
+                //#############################################################################
+                //! The CPU graph implementation.
+                class GraphCpuImpl final
+                {
+                public:
+                    //-----------------------------------------------------------------------------
+                    GraphCpuImpl() = default;
+                    //-----------------------------------------------------------------------------
+                    GraphCpuImpl(GraphCpuImpl const &) = delete;
+                    //-----------------------------------------------------------------------------
+                    GraphCpuImpl(GraphCpuImpl &&) = delete;
+                    //-----------------------------------------------------------------------------
+                    auto operator=(GraphCpuImpl const &) -> GraphCpuImpl & = delete;
+                    //-----------------------------------------------------------------------------
+                    auto operator=(GraphCpuImpl &&) -> GraphCpuImpl & = delete;
+                    //-----------------------------------------------------------------------------
+                    ~GraphCpuImpl() = default;
+
+                    //-----------------------------------------------------------------------------
+                    //! Records a copy of the task.
+                    template<
+                        typename TTask>
+                    auto record(
+                        TTask const & task)
+                    -> void
+                    {
+                        m_tasks.emplace_back(task);
+                    }
+
+                public:
+                    std::vector<std::function<void()>> m_tasks;     //!< The recorded tasks in the order they have been enqueued.
+                };
+            }
+        }
+
+        //#############################################################################
+        //! The CPU graph.
+        //!
+        //! The kernel tasks, copies and sets are recorded including their work divisions and arguments.
+        //! Therefore a launch is a single enqueue which neither validates the work divisions nor creates the tasks again.
+        //! Executing a recorded kernel task still runs the per-launch setup of its back-end, e.g. creating the accelerator and its shared memory.
+        //! Copies of a graph share the recorded tasks, so copying it into a queue is cheap.
+        //! The recorded tasks only reference the memory they operate on, so the buffers have to outlive all launches of the graph.
+        class GraphCpu final
+        {
+        public:
+            //-----------------------------------------------------------------------------
+            GraphCpu(
+                std::shared_ptr<cpu::detail::GraphCpuImpl const> spGraphImpl) :
+                    m_spGraphImpl(std::move(spGraphImpl))
+            {}
+            //-----------------------------------------------------------------------------
+            GraphCpu(GraphCpu const &) = default;
+            //-----------------------------------------------------------------------------
+            GraphCpu(GraphCpu &&) = default;
+            //-----------------------------------------------------------------------------
+            auto operator=(GraphCpu const &) -> GraphCpu & = default;
+            //-----------------------------------------------------------------------------
+            auto operator=(GraphCpu &&) -> GraphCpu & = default;
+            //-----------------------------------------------------------------------------
+            auto operator==(GraphCpu const & rhs) const
+            -> bool
+            {
+                return (m_spGraphImpl == rhs.m_spGraphImpl);
+            }
+            //-----------------------------------------------------------------------------
+            auto operator!=(GraphCpu const & rhs) const
+            -> bool
+            {
+                return !((*this) == rhs);
+            }
+            //-----------------------------------------------------------------------------
+            ~GraphCpu() = default;
+
+            //-----------------------------------------------------------------------------
+            //! Executes all recorded tasks in order.
+            ALPAKA_FN_HOST auto operator()() const
+            -> void
+            {
+                for(auto const & task : m_spGraphImpl->m_tasks)
+                {
+                    task();
+                }
+            }
+            //-----------------------------------------------------------------------------
+            //! \return The number of recorded tasks.
+            ALPAKA_FN_HOST auto getTaskCount() const
+            -> std::size_t
+            {
+                return m_spGraphImpl->m_tasks.size();
+            }
+
+        public:
+            std::shared_ptr<cpu::detail::GraphCpuImpl const> m_spGraphImpl;
+        };
+
+        namespace cpu
+        {
+            namespace detail
+            {
+                //-----------------------------------------------------------------------------
+                //! Starts recording into a new graph.
+                //! \param spCapturedGraph The graph a CPU queue is recording into.
+                ALPAKA_FN_HOST inline auto beginCapture(
+                    std::shared_ptr<GraphCpuImpl> & spCapturedGraph)
+                -> void
+                {
+                    if(spCapturedGraph)
+                    {
+                        throw std::runtime_error("The queue is already capturing!");
+                    }
+                    spCapturedGraph = std::make_shared<GraphCpuImpl>();
+                }
+                //-----------------------------------------------------------------------------
+                //! Stops recording.
+                //! \param spCapturedGraph The graph a CPU queue is recording into.
+                //! \return The recorded graph.
+                ALPAKA_FN_HOST inline auto endCapture(
+                    std::shared_ptr<GraphCpuImpl> & spCapturedGraph)
+                -> GraphCpu
+                {
+                    if(!spCapturedGraph)
+                    {
+                        throw std::runtime_error("The queue is not capturing!");
+                    }
+                    GraphCpu graph(std::move(spCapturedGraph));
+                    spCapturedGraph.reset();
+                    return graph;
+                }
+                //-----------------------------------------------------------------------------
+                //! Throws if the queue is capturing because the operation can not be recorded into a graph.
+                //! \param spCapturedGraph The graph a CPU queue is recording into.
+                ALPAKA_FN_HOST inline auto throwIfCapturing(
+                    std::shared_ptr<GraphCpuImpl> const & spCapturedGraph)
+                -> void
+                {
+                    if(spCapturedGraph)
+                    {
+                        throw std::runtime_error("Events can not be recorded into a graph!");
+                    }
+                }
+            }
+        }
+    }
+}
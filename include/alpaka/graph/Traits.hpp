@@ -0,0 +1,89 @@
+/* Copyright 2019 Benjamin Worpitz
+ *
+ * This file is part of Alpaka.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <alpaka/core/Common.hpp>
+
+namespace alpaka
+{
+    //-----------------------------------------------------------------------------
+    //! The graph specifics.
+    //!
+    //! A graph is a recorded sequence of tasks which can be launched repeatedly by enqueuing it into a queue.
+    namespace graph
+    {
+        //-----------------------------------------------------------------------------
+        //! The graph traits.
+        namespace traits
+        {
+            //#############################################################################
+            //! The graph type trait.
+            template<
+                typename TQueue,
+                typename TSfinae = void>
+            struct GraphType;
+
+            //#############################################################################
+            //! The graph capture begin trait.
+            template<
+                typename TQueue,
+                typename TSfinae = void>
+            struct BeginCapture;
+
+            //#############################################################################
+            //! The graph capture end trait.
+            template<
+                typename TQueue,
+                typename TSfinae = void>
+            struct EndCapture;
+        }
+
+        //#############################################################################
+        //! The graph type trait alias template to remove the ::type.
+        template<
+            typename TQueue>
+        using Graph = typename traits::GraphType<TQueue>::type;
+
+        //-----------------------------------------------------------------------------
+        //! Starts recording the tasks enqueued into the given queue.
+        //!
+        //! While the queue is capturing, the enqueued tasks are not executed but recorded into a graph.
+        //! Only the thread which started the capture is allowed to enqueue tasks into the queue until the capture is ended.
+        template<
+            typename TQueue>
+        ALPAKA_FN_HOST auto beginCapture(
+            TQueue & queue)
+        -> void
+        {
+            traits::BeginCapture<
+                TQueue>
+            ::beginCapture(
+                queue);
+        }
+
+        //-----------------------------------------------------------------------------
+        //! Stops recording the tasks enqueued into the given queue.
+        //!
+        //! \return The graph containing all tasks enqueued since the capture has been started.
+        //! It can be launched repeatedly by enqueuing it into a queue of the same type.
+        template<
+            typename TQueue>
+        ALPAKA_FN_HOST auto endCapture(
+            TQueue & queue)
+        -> Graph<TQueue>
+        {
+            return
+                traits::EndCapture<
+                    TQueue>
+                ::endCapture(
+                    queue);
+        }
+    }
+}
@@ -0,0 +1,177 @@
+/* Copyright 2019 Axel Huebl, Benjamin Worpitz, Matthias Werner
+ *
+ * This file is part of Alpaka.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#ifdef ALPAKA_ACC_CPU_B_SEQ_T_FIBERS_ENABLED
+
+#include <alpaka/idx/Traits.hpp>
+
+#include <alpaka/core/Assert.hpp>
+#include <alpaka/core/BoostPredef.hpp>
+#include <alpaka/core/Fibers.hpp>
+#include <alpaka/core/Positioning.hpp>
+#include <alpaka/core/Unused.hpp>
+#include <alpaka/vec/Vec.hpp>
+
+#include <boost/fiber/fss.hpp>
+
+namespace alpaka
+{
+    namespace idx
+    {
+        namespace bt
+        {
+            //#############################################################################
+            //! The fibers accelerator index provider.
+            //!
+            //! All fibers of a block run on the same thread, so a thread local slot can not be used.
+            //! Each block thread stores a pointer to its index in fiber specific storage before it executes the kernel.
+            //! The index query does not require any locking because the fiber specific storage is private to each fiber.
+            template<
+                typename TDim,
+                typename TIdx>
+            class IdxBtFiberLocal
+            {
+            public:
+                using IdxBtBase = IdxBtFiberLocal;
+
+                // The fiber specific storage does not support const types. The index is never modified through the slot.
+                using BlockThreadIdxSlot = boost::fibers::fiber_specific_ptr<vec::Vec<TDim, TIdx>>;
+
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST IdxBtFiberLocal() = default;
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST IdxBtFiberLocal(IdxBtFiberLocal const &) = delete;
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST IdxBtFiberLocal(IdxBtFiberLocal &&) = delete;
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST auto operator=(IdxBtFiberLocal const &) -> IdxBtFiberLocal & = delete;
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST auto operator=(IdxBtFiberLocal &&) -> IdxBtFiberLocal & = delete;
+                //-----------------------------------------------------------------------------
+                /*virtual*/ ~IdxBtFiberLocal() = default;
+
+                //-----------------------------------------------------------------------------
+                //! \return The slot holding the index of the block thread executed by the calling fiber.
+                //!
+                //! The referenced index is not owned by the slot.
+                //! It has to stay valid until the calling fiber has finished the kernel execution.
+                ALPAKA_FN_HOST static auto blockThreadIdxSlot()
+                -> BlockThreadIdxSlot &
+                {
+#if BOOST_COMP_CLANG
+    #pragma clang diagnostic push
+    #pragma clang diagnostic ignored "-Wexit-time-destructors"
+#endif
+                    static BlockThreadIdxSlot blockThreadIdxSlot(
+                        [](vec::Vec<TDim, TIdx> *){});
+#if BOOST_COMP_CLANG
+    #pragma clang diagnostic pop
+#endif
+                    return blockThreadIdxSlot;
+                }
+
+                //#############################################################################
+                //! Publishes the index of a block thread in the slot of the calling fiber for the lifetime of this object.
+                //! The slot is cleared even if the kernel throws, so it never refers to the index of a finished block thread.
+                class ScopedBlockThreadIdx final
+                {
+                public:
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST explicit ScopedBlockThreadIdx(
+                        vec::Vec<TDim, TIdx> const & blockThreadIdx)
+                    {
+                        blockThreadIdxSlot().reset(const_cast<vec::Vec<TDim, TIdx> *>(&blockThreadIdx));
+                    }
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST ScopedBlockThreadIdx(ScopedBlockThreadIdx const &) = delete;
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST ScopedBlockThreadIdx(ScopedBlockThreadIdx &&) = delete;
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST auto operator=(ScopedBlockThreadIdx const &) -> ScopedBlockThreadIdx & = delete;
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST auto operator=(ScopedBlockThreadIdx &&) -> ScopedBlockThreadIdx & = delete;
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST ~ScopedBlockThreadIdx()
+                    {
+                        blockThreadIdxSlot().reset(nullptr);
+                    }
+                };
+            };
+        }
+    }
+
+    namespace dim
+    {
+        namespace traits
+        {
+            //#############################################################################
+            //! The CPU fibers accelerator index dimension get trait specialization.
+            template<
+                typename TDim,
+                typename TIdx>
+            struct DimType<
+                idx::bt::IdxBtFiberLocal<TDim, TIdx>>
+            {
+                using type = TDim;
+            };
+        }
+    }
+    namespace idx
+    {
+        namespace traits
+        {
+            //#############################################################################
+            //! The CPU fibers accelerator block thread index get trait specialization.
+            template<
+                typename TDim,
+                typename TIdx>
+            struct GetIdx<
+                idx::bt::IdxBtFiberLocal<TDim, TIdx>,
+                origin::Block,
+                unit::Threads>
+            {
+                //-----------------------------------------------------------------------------
+                //! \return The index of the current thread in the block.
+                template<
+                    typename TWorkDiv>
+                ALPAKA_FN_HOST static auto getIdx(
+                    idx::bt::IdxBtFiberLocal<TDim, TIdx> const & idx,
+                    TWorkDiv const & workDiv)
+                -> vec::Vec<TDim, TIdx>
+                {
+                    alpaka::ignore_unused(idx);
+                    alpaka::ignore_unused(workDiv);
+                    auto const * const pBlockThreadIdx(idx::bt::IdxBtFiberLocal<TDim, TIdx>::blockThreadIdxSlot().get());
+                    ALPAKA_ASSERT(pBlockThreadIdx != nullptr);
+                    return *pBlockThreadIdx;
+                }
+            };
+        }
+    }
+    namespace idx
+    {
+        namespace traits
+        {
+            //#############################################################################
+            //! The CPU fibers accelerator block thread index idx type trait specialization.
+            template<
+                typename TDim,
+                typename TIdx>
+            struct IdxType<
+                idx::bt::IdxBtFiberLocal<TDim, TIdx>>
+            {
+                using type = TIdx;
+            };
+        }
+    }
+}
+
+#endif
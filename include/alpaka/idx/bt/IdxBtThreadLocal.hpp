@@ -0,0 +1,164 @@
+/* Copyright 2019 Axel Huebl, Benjamin Worpitz, Matthias Werner
+ *
+ * This file is part of Alpaka.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#ifdef ALPAKA_ACC_CPU_B_SEQ_T_THREADS_ENABLED
+
+#include <alpaka/idx/Traits.hpp>
+
+#include <alpaka/core/Assert.hpp>
+#include <alpaka/core/BoostPredef.hpp>
+#include <alpaka/core/Positioning.hpp>
+#include <alpaka/core/Unused.hpp>
+#include <alpaka/vec/Vec.hpp>
+
+
+namespace alpaka
+{
+    namespace idx
+    {
+        namespace bt
+        {
+            //#############################################################################
+            //! The threads accelerator index provider.
+            //!
+            //! Each block thread stores a pointer to its index in a thread local slot before it executes the kernel.
+            //! The index query is a single thread local load without any locking or searching.
+            //! A thread only ever executes one block thread at a time, so one slot per thread is sufficient.
+            template<
+                typename TDim,
+                typename TIdx>
+            class IdxBtThreadLocal
+            {
+            public:
+                using IdxBtBase = IdxBtThreadLocal;
+
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST IdxBtThreadLocal() = default;
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST IdxBtThreadLocal(IdxBtThreadLocal const &) = delete;
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST IdxBtThreadLocal(IdxBtThreadLocal &&) = delete;
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST auto operator=(IdxBtThreadLocal const &) -> IdxBtThreadLocal & = delete;
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST auto operator=(IdxBtThreadLocal &&) -> IdxBtThreadLocal & = delete;
+                //-----------------------------------------------------------------------------
+                /*virtual*/ ~IdxBtThreadLocal() = default;
+
+                //-----------------------------------------------------------------------------
+                //! \return The slot holding the index of the block thread executed by the calling thread.
+                //!
+                //! The referenced index has to stay valid until the calling thread has finished the kernel execution.
+                ALPAKA_FN_HOST static auto blockThreadIdxSlot()
+                -> vec::Vec<TDim, TIdx> const * &
+                {
+                    // A trivially constructible thread local does not require a guard on each access.
+                    thread_local vec::Vec<TDim, TIdx> const * pBlockThreadIdx(nullptr);
+                    return pBlockThreadIdx;
+                }
+
+                //#############################################################################
+                //! Publishes the index of a block thread in the slot of the calling thread for the lifetime of this object.
+                //! The slot is cleared even if the kernel throws, so it never refers to the index of a finished block thread.
+                class ScopedBlockThreadIdx final
+                {
+                public:
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST explicit ScopedBlockThreadIdx(
+                        vec::Vec<TDim, TIdx> const & blockThreadIdx)
+                    {
+                        blockThreadIdxSlot() = &blockThreadIdx;
+                    }
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST ScopedBlockThreadIdx(ScopedBlockThreadIdx const &) = delete;
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST ScopedBlockThreadIdx(ScopedBlockThreadIdx &&) = delete;
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST auto operator=(ScopedBlockThreadIdx const &) -> ScopedBlockThreadIdx & = delete;
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST auto operator=(ScopedBlockThreadIdx &&) -> ScopedBlockThreadIdx & = delete;
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST ~ScopedBlockThreadIdx()
+                    {
+                        blockThreadIdxSlot() = nullptr;
+                    }
+                };
+            };
+        }
+    }
+
+    namespace dim
+    {
+        namespace traits
+        {
+            //#############################################################################
+            //! The CPU threads accelerator index dimension get trait specialization.
+            template<
+                typename TDim,
+                typename TIdx>
+            struct DimType<
+                idx::bt::IdxBtThreadLocal<TDim, TIdx>>
+            {
+                using type = TDim;
+            };
+        }
+    }
+    namespace idx
+    {
+        namespace traits
+        {
+            //#############################################################################
+            //! The CPU threads accelerator block thread index get trait specialization.
+            template<
+                typename TDim,
+                typename TIdx>
+            struct GetIdx<
+                idx::bt::IdxBtThreadLocal<TDim, TIdx>,
+                origin::Block,
+                unit::Threads>
+            {
+                //-----------------------------------------------------------------------------
+                //! \return The index of the current thread in the block.
+                template<
+                    typename TWorkDiv>
+                ALPAKA_FN_HOST static auto getIdx(
+                    idx::bt::IdxBtThreadLocal<TDim, TIdx> const & idx,
+                    TWorkDiv const & workDiv)
+                -> vec::Vec<TDim, TIdx>
+                {
+                    alpaka::ignore_unused(idx);
+                    alpaka::ignore_unused(workDiv);
+                    auto const * const pBlockThreadIdx(idx::bt::IdxBtThreadLocal<TDim, TIdx>::blockThreadIdxSlot());
+                    ALPAKA_ASSERT(pBlockThreadIdx != nullptr);
+                    return *pBlockThreadIdx;
+                }
+            };
+        }
+    }
+    namespace idx
+    {
+        namespace traits
+        {
+            //#############################################################################
+            //! The CPU threads accelerator block thread index idx type trait specialization.
+            template<
+                typename TDim,
+                typename TIdx>
+            struct IdxType<
+                idx::bt::IdxBtThreadLocal<TDim, TIdx>>
+            {
+                using type = TIdx;
+            };
+        }
+    }
+}
+
+#endif
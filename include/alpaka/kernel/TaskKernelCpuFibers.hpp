@@ -75,7 +75,8 @@ namespace alpaka
                 FiberPoolYield,                     // The type yielding the current concurrent execution.
                 boost::fibers::mutex,               // The mutex type to use. Only required if TisYielding is true.
                 boost::fibers::condition_variable,  // The condition variable type to use. Only required if TisYielding is true.
-                false>;                             // If the threads should yield.
+                false,                              // If the threads should yield.
+                alpaka::core::detail::ThreadSafeQueue>; // The task queue policy. All fibers run on the same thread so stealing would not help.
 
         public:
             //-----------------------------------------------------------------------------
@@ -216,8 +217,6 @@ namespace alpaka
                 // Clean up.
                 futuresInBlock.clear();
 
-                acc.m_fibersToIndices.clear();
-
                 // After a block has been processed, the shared memory has to be deleted.
                 block::shared::st::freeMem(acc);
             }
@@ -268,28 +267,14 @@ namespace alpaka
                 TArgs const & ... args)
             -> void
             {
-                // We have to store the fiber data before the kernel is calling any of the methods of this class depending on them.
-                auto const fiberId(boost::this_fiber::get_id());
-
-                // Set the master thread id.
-                if(blockThreadIdx.sum() == 0)
-                {
-                    acc.m_masterFiberId = fiberId;
-                }
-
-                // Save the fiber id, and index.
-                acc.m_fibersToIndices.emplace(fiberId, blockThreadIdx);
-
-                // Sync all threads so that the maps with thread id's are complete and not changed after here.
-                syncBlockThreads(acc);
+                // Publish the index of the block thread for the kernel index queries on this fiber.
+                // The blockThreadIdx outlives the kernel execution because it is owned by the enqueued task.
+                typename idx::bt::IdxBtFiberLocal<TDim, TIdx>::ScopedBlockThreadIdx const scopedBlockThreadIdx(blockThreadIdx);
 
                 // Execute the kernel itself.
                 kernelFnObj(
                     const_cast<acc::AccCpuFibers<TDim, TIdx> const &>(acc),
                     args...);
-
-                // We have to sync all fibers here because if a fiber would finish before all fibers have been started, the new fiber could get a recycled (then duplicate) fiber id!
-                syncBlockThreads(acc);
             }
 
             TKernelFnObj m_kernelFnObj;
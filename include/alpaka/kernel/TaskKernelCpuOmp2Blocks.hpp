@@ -24,6 +24,7 @@
 
 // Implementation details.
 #include <alpaka/acc/AccCpuOmp2Blocks.hpp>
+#include <alpaka/core/ThreadAffinity.hpp>
 #include <alpaka/dev/DevCpu.hpp>
 #include <alpaka/idx/MapIdx.hpp>
 #include <alpaka/kernel/Traits.hpp>
@@ -33,9 +34,11 @@
 
 #include <omp.h>
 
+#include <cstdint>
 #include <stdexcept>
 #include <tuple>
 #include <type_traits>
+#include <vector>
 #if ALPAKA_DEBUG >= ALPAKA_DEBUG_MINIMAL
     #include <iostream>
 #endif
@@ -141,23 +144,32 @@ namespace alpaka
 #if ALPAKA_DEBUG >= ALPAKA_DEBUG_FULL
                     std::cout << __func__ << " already within a parallel region." << std::endl;
 #endif
+                    // The threads of the enclosing parallel region are not owned by this kernel, so they are not pinned.
                     parallelFn(
                         boundKernelFnObj,
                         blockSharedMemDynSizeBytes,
                         numBlocksInGrid,
-                        gridBlockExtent);
+                        gridBlockExtent,
+                        nullptr,
+                        std::vector<std::uint32_t>());
                 }
                 else
                 {
 #if ALPAKA_DEBUG >= ALPAKA_DEBUG_FULL
                     std::cout << __func__ << " opening new parallel region." << std::endl;
 #endif
+                    // The OpenMP threads are reused by all launching threads, so the ones without CPUs assigned by the policy are restricted like the current launching thread.
+                    auto const & affinityPolicy(core::threads::getCurrentAffinityPolicy());
+                    // The inherited CPUs are cached by the launching thread, so this does not query its affinity on each launch.
+                    auto const & inheritedCpus(core::threads::getInheritedCpus(affinityPolicy));
                     #pragma omp parallel
                     parallelFn(
                         boundKernelFnObj,
                         blockSharedMemDynSizeBytes,
                         numBlocksInGrid,
-                        gridBlockExtent);
+                        gridBlockExtent,
+                        &affinityPolicy,
+                        inheritedCpus);
                 }
             }
 
@@ -168,9 +180,18 @@ namespace alpaka
                 FnObj const & boundKernelFnObj,
                 TIdx const & blockSharedMemDynSizeBytes,
                 TIdx const & numBlocksInGrid,
-                vec::Vec<TDim, TIdx> const & gridBlockExtent) const
+                vec::Vec<TDim, TIdx> const & gridBlockExtent,
+                core::threads::AffinityPolicy const * const pAffinityPolicy,
+                std::vector<std::uint32_t> const & inheritedCpus) const
             -> void
             {
+                // The master thread is the queue worker which has already been pinned by the queue.
+                int const ompThreadNum(::omp_get_thread_num());
+                if(pAffinityPolicy && (ompThreadNum != 0))
+                {
+                    core::threads::pinCurrentThread(*pAffinityPolicy, static_cast<std::size_t>(ompThreadNum), inheritedCpus);
+                }
+
                 #pragma omp single nowait
                 {
                     // The OpenMP runtime does not create a parallel region when only one thread is required in the num_threads clause.
@@ -24,6 +24,7 @@
 
 // Implementation details.
 #include <alpaka/acc/AccCpuOmp2Threads.hpp>
+#include <alpaka/core/ThreadAffinity.hpp>
 #include <alpaka/core/Unused.hpp>
 #include <alpaka/dev/DevCpu.hpp>
 #include <alpaka/kernel/Traits.hpp>
@@ -142,10 +143,31 @@ namespace alpaka
                     throw std::runtime_error("The OpenMP 2.0 thread backend can not be used within an existing parallel region!");
                 }
 
+                // The block threads are pinned according to the policy of the queue executing the kernel.
+                // The OpenMP threads are reused by all launching threads, so the ones without CPUs assigned by the policy are restricted like the current launching thread.
+                auto const & affinityPolicy(core::threads::getCurrentAffinityPolicy());
+                // The inherited CPUs are cached by the launching thread, so this does not query its affinity on each launch.
+                auto const & inheritedCpus(core::threads::getInheritedCpus(affinityPolicy));
+
                 // Force the environment to use the given number of threads.
                 int const ompIsDynamic(::omp_get_dynamic());
                 ::omp_set_dynamic(0);
 
+                // The block threads are pinned once per launch instead of once per block.
+                // The OpenMP runtime reuses the threads of this team for the parallel regions of the blocks because they request the same number of threads.
+                if(iBlockThreadCount > 1)
+                {
+                    #pragma omp parallel num_threads(iBlockThreadCount)
+                    {
+                        // The master thread is the queue worker which has already been pinned by the queue.
+                        int const ompThreadNum(::omp_get_thread_num());
+                        if(ompThreadNum != 0)
+                        {
+                            core::threads::pinCurrentThread(affinityPolicy, static_cast<std::size_t>(ompThreadNum), inheritedCpus);
+                        }
+                    }
+                }
+
                 // Execute the blocks serially.
                 meta::ndLoopIncIdx(
                     gridBlockExtent,
@@ -9,6 +9,9 @@
 
 #pragma once
 
+// Uncomment this to execute the grid blocks one after another instead of concurrently.
+//#define ALPAKA_CPU_THREADS_DISABLE_CONCURRENT_BLOCKS
+
 #ifdef ALPAKA_ACC_CPU_B_SEQ_T_THREADS_ENABLED
 
 // Specialized traits.
@@ -25,16 +28,24 @@
 #include <alpaka/workdiv/WorkDivMembers.hpp>
 
 #include <alpaka/core/BoostPredef.hpp>
+#include <alpaka/core/ClipCast.hpp>
 #include <alpaka/core/ConcurrentExecPool.hpp>
+#include <alpaka/core/ThreadAffinity.hpp>
+#include <alpaka/core/Unused.hpp>
 #include <alpaka/meta/NdLoop.hpp>
 #include <alpaka/meta/ApplyTuple.hpp>
 
 #include <algorithm>
+#include <cstdint>
 #include <thread>
 #include <vector>
 #include <tuple>
 #include <type_traits>
 #include <future>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
 #if ALPAKA_DEBUG >= ALPAKA_DEBUG_MINIMAL
     #include <iostream>
 #endif
@@ -43,6 +54,163 @@ namespace alpaka
 {
     namespace kernel
     {
+        namespace threads
+        {
+            namespace detail
+            {
+                //#############################################################################
+                // The pool outlives the kernel launches, so idle threads have to go to sleep instead of yielding.
+                // Otherwise they would keep all cores busy in between two kernel launches.
+                // Yielding within the pool is not required for fast block synchronization because syncBlockThreads uses its own barrier.
+                // All threads of a block are enqueued at once. With many threads per block a single shared task queue
+                // is heavily contended, therefore the threads take their tasks from work-stealing deques.
+                using ThreadPool = alpaka::core::detail::ConcurrentExecPool<
+                    std::size_t,
+                    std::thread,                // The concurrent execution type.
+                    std::promise,               // The promise type.
+                    void,                       // The type yielding the current concurrent execution.
+                    std::mutex,                 // The mutex type to use. Only required if TisYielding is true.
+                    std::condition_variable,    // The condition variable type to use. Only required if TisYielding is true.
+                    false,                      // If the threads should yield.
+                    alpaka::core::detail::WorkStealingQueue>; // The task queue policy.
+
+                //#############################################################################
+                //! The latch used to wait for all threads of a block.
+                //! It replaces one future per block thread so that launching a block does not allocate.
+                using BlockLatch = alpaka::core::detail::TaskLatch<
+                    std::mutex,
+                    std::condition_variable>;
+
+                //-----------------------------------------------------------------------------
+                //! \return The block thread pool of the calling thread grown to at least the given number of threads.
+                //!
+                //! Creating and joining all the block threads on each kernel launch is more expensive than many small kernels themselves.
+                //! Therefore, the pool is created on the first launch and reused by all subsequent launches from the same thread.
+                //! There is one pool per launching thread (e.g. the worker of a non-blocking queue) instead of one per process.
+                //! Kernels running concurrently in different queues would otherwise compete for the same threads and
+                //! the threads of a block could not be guaranteed to be executed concurrently which would deadlock syncBlockThreads.
+                ALPAKA_FN_HOST inline auto getThreadPool(
+                    std::size_t const threadCount)
+                -> ThreadPool &
+                {
+#if BOOST_COMP_CLANG
+    #pragma clang diagnostic push
+    #pragma clang diagnostic ignored "-Wexit-time-destructors"
+#endif
+                    thread_local ThreadPool threadPool(threadCount);
+#if BOOST_COMP_CLANG
+    #pragma clang diagnostic pop
+#endif
+                    threadPool.ensureConcurrentExecutionCount(threadCount);
+                    return threadPool;
+                }
+
+                //-----------------------------------------------------------------------------
+                //! Passes the affinity policy of the calling thread to its block thread pool.
+                //!
+                //! The pool threads are pinned according to the policy of the queue executing the kernel.
+                //! Threads without CPUs assigned by the policy are restricted like the launching thread, because the pool may have been used for another device before.
+                //! Setting the policy locks the pool, so it is skipped if neither the policy nor the affinity of the calling thread changed since the last launch.
+                ALPAKA_FN_HOST inline auto updateThreadPoolAffinity(
+                    ThreadPool & threadPool)
+                -> void
+                {
+#if BOOST_COMP_CLANG
+    #pragma clang diagnostic push
+    #pragma clang diagnostic ignored "-Wexit-time-destructors"
+#endif
+                    thread_local bool bPolicySet(false);
+                    thread_local core::threads::AffinityPolicy lastAffinityPolicy;
+                    thread_local std::uint32_t lastAffinityVersion(0u);
+#if BOOST_COMP_CLANG
+    #pragma clang diagnostic pop
+#endif
+                    auto const & affinityPolicy(core::threads::getCurrentAffinityPolicy());
+                    auto const affinityVersion(core::threads::detail::currentThreadAffinityVersion());
+                    if(bPolicySet && (affinityVersion == lastAffinityVersion) && (affinityPolicy == lastAffinityPolicy))
+                    {
+                        return;
+                    }
+
+                    threadPool.setAffinityPolicy(affinityPolicy, core::threads::getInheritedCpus(affinityPolicy));
+                    bPolicySet = true;
+                    lastAffinityPolicy = affinityPolicy;
+                    lastAffinityVersion = affinityVersion;
+                }
+
+                //#############################################################################
+                //! The state of one of the concurrently executed blocks.
+                //! Each block needs its own accelerator because it holds the block index, the block shared memory and the barrier.
+                template<
+                    typename TDim,
+                    typename TIdx>
+                struct BlockSlot
+                {
+                    std::unique_ptr<acc::AccCpuThreads<TDim, TIdx>> m_upAcc;
+                    TIdx m_blockSharedMemDynSizeBytes = static_cast<TIdx>(0u);  //!< The dynamic shared memory size the accelerator has been created with.
+                    BlockLatch m_latch;
+                    bool m_bBlockRunning = false;
+                };
+
+                //-----------------------------------------------------------------------------
+                //! \return The block slots of the calling thread.
+                //!
+                //! Like the thread pool, the slots are kept from one launch to the next so that launching a kernel does not allocate them.
+                //! The slots only grow. A launch uses as many of them as it executes blocks concurrently.
+                template<
+                    typename TDim,
+                    typename TIdx>
+                ALPAKA_FN_HOST auto getBlockSlots()
+                -> std::vector<std::unique_ptr<BlockSlot<TDim, TIdx>>> &
+                {
+                    // The accelerators of the slots return their block shared dynamic memory to the cache of this thread when they are destroyed at thread exit.
+                    // Thread local variables are destroyed in the reverse order of their construction, so the cache has to be constructed before the slots.
+                    block::shared::dyn::detail::getBlockSharedMemDynCache();
+#if BOOST_COMP_CLANG
+    #pragma clang diagnostic push
+    #pragma clang diagnostic ignored "-Wexit-time-destructors"
+#endif
+                    thread_local std::vector<std::unique_ptr<BlockSlot<TDim, TIdx>>> blockSlots;
+#if BOOST_COMP_CLANG
+    #pragma clang diagnostic pop
+#endif
+                    return blockSlots;
+                }
+
+                //-----------------------------------------------------------------------------
+                //! \return The number of grid blocks executed concurrently.
+                //!
+                //! All threads of a block have to run concurrently because of syncBlockThreads.
+                //! Therefore, the hardware threads available to the launching thread are divided between the blocks instead of oversubscribing them.
+                //! If a block has at least as many threads as there are hardware threads, the blocks are executed one after another.
+                template<
+                    typename TIdx>
+                ALPAKA_FN_HOST auto getConcurrentBlockCount(
+                    TIdx const & gridBlockCount,
+                    TIdx const & blockThreadCount)
+                -> TIdx
+                {
+#ifdef ALPAKA_CPU_THREADS_DISABLE_CONCURRENT_BLOCKS
+                    alpaka::ignore_unused(gridBlockCount);
+                    alpaka::ignore_unused(blockThreadCount);
+                    return static_cast<TIdx>(1u);
+#else
+                    // The hardware threads are shared with the other workers of a concurrent queue.
+                    auto const hardwareThreadCount(
+                        std::max(
+                            static_cast<TIdx>(1u),
+                            alpaka::core::clipCast<TIdx>(core::threads::getCurrentHardwareThreadCount())));
+                    return
+                        std::max(
+                            static_cast<TIdx>(1u),
+                            std::min(
+                                gridBlockCount,
+                                static_cast<TIdx>(hardwareThreadCount / blockThreadCount)));
+#endif
+                }
+            }
+        }
+
         //#############################################################################
         //! The CPU threads execution task.
         template<
@@ -54,27 +222,9 @@ namespace alpaka
             public workdiv::WorkDivMembers<TDim, TIdx>
         {
         private:
-            //#############################################################################
-            //! The type given to the ConcurrentExecPool for yielding the current thread.
-            struct ThreadPoolYield
-            {
-                //-----------------------------------------------------------------------------
-                //! Yields the current thread.
-                ALPAKA_FN_HOST static auto yield()
-                -> void
-                {
-                    std::this_thread::yield();
-                }
-            };
-            //#############################################################################
-            // When using the thread pool the threads are yielding because this is faster.
-            // Using condition variables and going to sleep is very costly for real threads.
-            // Especially when the time to wait is really short (syncBlockThreads) yielding is much faster.
-            using ThreadPool = alpaka::core::detail::ConcurrentExecPool<
-                TIdx,
-                std::thread,        // The concurrent execution type.
-                std::promise,       // The promise type.
-                ThreadPoolYield>;   // The type yielding the current concurrent execution.
+            using ThreadPool = threads::detail::ThreadPool;
+            using BlockLatch = threads::detail::BlockLatch;
+            using BlockSlot = threads::detail::BlockSlot<TDim, TIdx>;
 
         public:
             //-----------------------------------------------------------------------------
@@ -136,22 +286,51 @@ namespace alpaka
                 std::cout << __func__
                     << " blockSharedMemDynSizeBytes: " << blockSharedMemDynSizeBytes << " B" << std::endl;
 #endif
-                acc::AccCpuThreads<TDim, TIdx> acc(
-                    *static_cast<workdiv::WorkDivMembers<TDim, TIdx> const *>(this),
-                    blockSharedMemDynSizeBytes);
-
                 auto const blockThreadCount(blockThreadExtent.prod());
-                ThreadPool threadPool(blockThreadCount);
+                auto const concurrentBlockCount(
+                    threads::detail::getConcurrentBlockCount(
+                        gridBlockExtent.prod(),
+                        blockThreadCount));
+
+                // The accelerators of the slots are only recreated if the work division or the dynamic shared memory size changed since the last launch.
+                auto & blockSlots(threads::detail::getBlockSlots<TDim, TIdx>());
+                auto const blockSlotCount(static_cast<std::size_t>(concurrentBlockCount));
+                while(blockSlots.size() < blockSlotCount)
+                {
+                    blockSlots.emplace_back(new BlockSlot());
+                }
+                for(std::size_t i(0u); i < blockSlotCount; ++i)
+                {
+                    auto & blockSlot(*blockSlots[i]);
+                    if(!blockSlot.m_upAcc
+                        || (blockSlot.m_blockSharedMemDynSizeBytes != blockSharedMemDynSizeBytes)
+                        || (workdiv::getWorkDiv<Grid, Blocks>(*blockSlot.m_upAcc) != gridBlockExtent)
+                        || (workdiv::getWorkDiv<Block, Threads>(*blockSlot.m_upAcc) != blockThreadExtent)
+                        || (workdiv::getWorkDiv<Thread, Elems>(*blockSlot.m_upAcc) != threadElemExtent))
+                    {
+                        blockSlot.m_upAcc.reset(
+                            new acc::AccCpuThreads<TDim, TIdx>(
+                                *static_cast<workdiv::WorkDivMembers<TDim, TIdx> const *>(this),
+                                blockSharedMemDynSizeBytes));
+                        blockSlot.m_blockSharedMemDynSizeBytes = blockSharedMemDynSizeBytes;
+                    }
+                }
+                std::size_t blockSlotIdx(0u);
+
+                ThreadPool & threadPool(threads::detail::getThreadPool(static_cast<std::size_t>(concurrentBlockCount * blockThreadCount)));
+                threads::detail::updateThreadPoolAffinity(threadPool);
 
                 // Bind the kernel and its arguments to the grid block function.
                 auto const boundGridBlockExecHost(
                     meta::apply(
-                        [this, &acc, &blockThreadExtent, &threadPool](TArgs const & ... args)
+                        [this, &blockSlots, &blockSlotCount, &blockSlotIdx, &blockThreadExtent, &threadPool](TArgs const & ... args)
                         {
                             return
                                 std::bind(
                                     &TaskKernelCpuThreads<TDim, TIdx, TKernelFnObj, TArgs...>::gridBlockExecHost,
-                                    std::ref(acc),
+                                    std::ref(blockSlots),
+                                    std::ref(blockSlotCount),
+                                    std::ref(blockSlotIdx),
                                     std::placeholders::_1,
                                     std::ref(blockThreadExtent),
                                     std::ref(threadPool),
@@ -160,17 +339,44 @@ namespace alpaka
                         },
                         m_args));
 
-                // Execute the blocks serially.
+                // Execute up to concurrentBlockCount blocks concurrently.
                 meta::ndLoopIncIdx(
                     gridBlockExtent,
                     boundGridBlockExecHost);
+
+                // Wait for the blocks still running.
+                for(std::size_t i(0u); i < blockSlotCount; ++i)
+                {
+                    gridBlockWaitHost(*blockSlots[i]);
+                }
+// Workaround: Clang can not support this when natively compiling device code. See ConcurrentExecPool.hpp.
+#if !(BOOST_COMP_CLANG_CUDA && BOOST_ARCH_PTX)
+                // The exceptions are only rethrown after all blocks have completed because the running ones still use the kernel arguments.
+                // All latches are cleared so that the slots reused by the next kernel do not report an old exception.
+                std::exception_ptr exceptPtr;
+                for(std::size_t i(0u); i < blockSlotCount; ++i)
+                {
+                    auto blockExceptPtr(blockSlots[i]->m_latch.takeException());
+                    if(!exceptPtr)
+                    {
+                        exceptPtr = blockExceptPtr;
+                    }
+                }
+                if(exceptPtr)
+                {
+                    std::rethrow_exception(exceptPtr);
+                }
+#endif
             }
 
         private:
             //-----------------------------------------------------------------------------
             //! The function executed for each grid block.
+            //! It starts the block in the next block slot without waiting for its completion.
             ALPAKA_FN_HOST static auto gridBlockExecHost(
-                acc::AccCpuThreads<TDim, TIdx> & acc,
+                std::vector<std::unique_ptr<BlockSlot>> const & blockSlots,
+                std::size_t const & blockSlotCount,
+                std::size_t & blockSlotIdx,
                 vec::Vec<TDim, TIdx> const & gridBlockIdx,
                 vec::Vec<TDim, TIdx> const & blockThreadExtent,
                 ThreadPool & threadPool,
@@ -178,17 +384,23 @@ namespace alpaka
                 TArgs const & ... args)
             -> void
             {
-                    // The futures of the threads in the current block.
-                std::vector<std::future<void>> futuresInBlock;
+                // The block slots are used round-robin.
+                // The block started the longest time ago in this slot has to be completed first.
+                auto & blockSlot(*blockSlots[blockSlotIdx]);
+                blockSlotIdx = (blockSlotIdx + 1u) % blockSlotCount;
+                gridBlockWaitHost(blockSlot);
+
+                auto & acc(*blockSlot.m_upAcc);
 
                 // Set the index of the current block
                 acc.m_gridBlockIdx = gridBlockIdx;
+                blockSlot.m_bBlockRunning = true;
 
                 // Bind the kernel and its arguments to the host block thread execution function.
                 auto boundBlockThreadExecHost(std::bind(
                     &TaskKernelCpuThreads<TDim, TIdx, TKernelFnObj, TArgs...>::blockThreadExecHost,
                     std::ref(acc),
-                    std::ref(futuresInBlock),
+                    std::ref(blockSlot.m_latch),
                     std::placeholders::_1,
                     std::ref(threadPool),
                     std::ref(kernelFnObj),
@@ -197,36 +409,39 @@ namespace alpaka
                 meta::ndLoopIncIdx(
                     blockThreadExtent,
                     boundBlockThreadExecHost);
+            }
+            //-----------------------------------------------------------------------------
+            //! Waits for the completion of the block running in the given slot and cleans up after it.
+            ALPAKA_FN_HOST static auto gridBlockWaitHost(
+                BlockSlot & blockSlot)
+            -> void
+            {
+                if(!blockSlot.m_bBlockRunning)
+                {
+                    return;
+                }
+
+                auto & acc(*blockSlot.m_upAcc);
 // Workaround: Clang can not support this when natively compiling device code. See ConcurrentExecPool.hpp.
 #if !(BOOST_COMP_CLANG_CUDA && BOOST_ARCH_PTX)
                 // Wait for the completion of the block thread kernels.
-                std::for_each(
-                    futuresInBlock.begin(),
-                    futuresInBlock.end(),
-                    [](std::future<void> & t)
-                    {
-                        t.wait();
-                    }
-                );
+                blockSlot.m_latch.wait();
 #endif
-                // Clean up.
-                futuresInBlock.clear();
-
-                acc.m_threadToIndexMap.clear();
-
                 // After a block has been processed, the shared memory has to be deleted.
                 block::shared::st::freeMem(acc);
+
+                blockSlot.m_bBlockRunning = false;
             }
             //-----------------------------------------------------------------------------
             //! The function executed for each block thread on the host.
             ALPAKA_FN_HOST static auto blockThreadExecHost(
                 acc::AccCpuThreads<TDim, TIdx> & acc,
 #if !(BOOST_COMP_CLANG_CUDA && BOOST_ARCH_PTX)
-                std::vector<std::future<void>> & futuresInBlock,
+                BlockLatch & latchBlock,
                 vec::Vec<TDim, TIdx> const & blockThreadIdx,
                 ThreadPool & threadPool,
 #else
-                std::vector<std::future<void>> &,
+                BlockLatch &,
                 vec::Vec<TDim, TIdx> const & blockThreadIdx,
                 ThreadPool &,
 #endif
@@ -248,9 +463,9 @@ namespace alpaka
                 // Add the bound function to the block thread pool.
 // Workaround: Clang can not support this when natively compiling device code. See ConcurrentExecPool.hpp.
 #if !(BOOST_COMP_CLANG_CUDA && BOOST_ARCH_PTX)
-                futuresInBlock.emplace_back(
-                    threadPool.enqueueTask(
-                        boundBlockThreadExecAcc));
+                threadPool.enqueueTaskWithLatch(
+                    latchBlock,
+                    boundBlockThreadExecAcc);
 #else
                 (void)boundBlockThreadExecAcc;
 #endif
@@ -264,34 +479,14 @@ namespace alpaka
                 TArgs const & ... args)
             -> void
             {
-                // We have to store the thread data before the kernel is calling any of the methods of this class depending on them.
-                auto const threadId(std::this_thread::get_id());
-
-                // Set the master thread id.
-                if(blockThreadIdx.sum() == 0)
-                {
-                    acc.m_idMasterThread = threadId;
-                }
-
-                {
-                    // The insertion of elements has to be done one thread at a time.
-                    std::lock_guard<std::mutex> lock(acc.m_mtxMapInsert);
-
-                    // Save the thread id, and index.
-                    acc.m_threadToIndexMap.emplace(threadId, blockThreadIdx);
-                }
-
-                // Sync all threads so that the maps with thread id's are complete and not changed after here.
-                syncBlockThreads(acc);
+                // Publish the index of the block thread for the kernel index queries on this thread.
+                // The blockThreadIdx outlives the kernel execution because it is owned by the enqueued task.
+                typename idx::bt::IdxBtThreadLocal<TDim, TIdx>::ScopedBlockThreadIdx const scopedBlockThreadIdx(blockThreadIdx);
 
                 // Execute the kernel itself.
                 kernelFnObj(
                     const_cast<acc::AccCpuThreads<TDim, TIdx> const &>(acc),
                     args...);
-
-                // We have to sync all threads here because if a thread would finish before all threads have been started,
-                // a new thread could get the recycled (then duplicate) thread id!
-                syncBlockThreads(acc);
             }
 
             TKernelFnObj m_kernelFnObj;
@@ -0,0 +1,439 @@
+/* Copyright 2019 Benjamin Worpitz
+ *
+ * This file is part of Alpaka.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <alpaka/core/BoostPredef.hpp>
+#include <alpaka/core/Common.hpp>
+
+#include <boost/align.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace alpaka
+{
+    namespace mem
+    {
+        namespace alloc
+        {
+            //#############################################################################
+            //! The statistics of the caching CPU allocator.
+            struct AllocCpuCachingStats
+            {
+                std::size_t m_allocCount;       //!< The number of allocations.
+                std::size_t m_cacheHitCount;    //!< The number of allocations served from a cache.
+                std::size_t m_freeCount;        //!< The number of frees.
+                std::size_t m_releaseCount;     //!< The number of blocks returned to the system.
+                std::size_t m_usedBytes;        //!< The size of the blocks currently in use.
+                std::size_t m_cachedBytes;      //!< The size of the blocks currently held in the caches.
+            };
+
+            //#############################################################################
+            //! The caching CPU allocator.
+            //!
+            //! The sizes are rounded up to size classes with four classes per power of two, so at most a quarter of a block is wasted.
+            //! Freed blocks are kept in bins per size class and reused by later allocations of the same class.
+            //! Small blocks are first cached per thread without any locking, all other blocks are cached in a global pool.
+            //! If the cached bytes would exceed the release threshold, freed blocks are returned to the system instead.
+            //!
+            //! Blocks are additionally distinguished by a tag, e.g. the NUMA node they are bound to, and only reused for the same tag.
+            class AllocCpuCaching final
+            {
+            public:
+                //! The alignment of all blocks. It is at least core::vectorization::defaultAlignment.
+                static constexpr std::size_t alignment = 64u;
+                //! The smallest size class.
+                static constexpr std::size_t minClassBytes = 64u;
+                //! The largest block cached per thread.
+                static constexpr std::size_t maxThreadCacheBlockBytes = std::size_t(1u) << 20u;
+                //! The maximum number of blocks cached per thread.
+                static constexpr std::size_t maxThreadCacheBlockCount = 16u;
+
+                //-----------------------------------------------------------------------------
+                //! \return The process wide caching allocator.
+                ALPAKA_FN_HOST static auto get()
+                -> AllocCpuCaching &
+                {
+                    // The allocator is never destroyed because the thread caches are flushed into it when threads exit,
+                    // which can happen after the destruction of static objects.
+                    static AllocCpuCaching * const pAlloc(new AllocCpuCaching());
+                    return *pAlloc;
+                }
+
+                //-----------------------------------------------------------------------------
+                AllocCpuCaching(AllocCpuCaching const &) = delete;
+                //-----------------------------------------------------------------------------
+                AllocCpuCaching(AllocCpuCaching &&) = delete;
+                //-----------------------------------------------------------------------------
+                auto operator=(AllocCpuCaching const &) -> AllocCpuCaching & = delete;
+                //-----------------------------------------------------------------------------
+                auto operator=(AllocCpuCaching &&) -> AllocCpuCaching & = delete;
+
+                //-----------------------------------------------------------------------------
+                //! \return The size of the size class the given size belongs to or 0 if it is not representable.
+                ALPAKA_FN_HOST static auto getClassBytes(
+                    std::size_t const sizeBytes)
+                -> std::size_t
+                {
+                    if(sizeBytes <= minClassBytes)
+                    {
+                        return minClassBytes;
+                    }
+                    // Find the power of two with pow2 < sizeBytes <= 2 * pow2 and divide the range into four classes.
+                    std::size_t pow2(minClassBytes);
+                    while(pow2 < sizeBytes - pow2)
+                    {
+                        pow2 *= 2u;
+                    }
+                    auto const step(pow2 / 4u);
+                    if(sizeBytes > std::numeric_limits<std::size_t>::max() - (step - 1u))
+                    {
+                        return 0u;
+                    }
+                    return (sizeBytes + step - 1u) / step * step;
+                }
+
+                //-----------------------------------------------------------------------------
+                //! \return A block of at least the given size aligned to alignment or nullptr if the allocation failed.
+                ALPAKA_FN_HOST auto alloc(
+                    std::size_t const sizeBytes,
+                    std::uint32_t const tag)
+                -> void *
+                {
+                    auto const classBytes(getClassBytes(sizeBytes));
+                    if(classBytes == 0u)
+                    {
+                        return nullptr;
+                    }
+                    auto & counters(getThreadCache().m_counters);
+                    addRelaxed(counters.m_allocCount, 1u);
+                    addRelaxed(counters.m_usedBytes, classBytes);
+
+                    void * p(popCachedBlock(classBytes, tag));
+                    if(p)
+                    {
+                        addRelaxed(counters.m_cacheHitCount, 1u);
+                        m_cachedBytes.fetch_sub(classBytes, std::memory_order_relaxed);
+                        return p;
+                    }
+
+                    p = boost::alignment::aligned_alloc(alignment, classBytes);
+                    if(!p)
+                    {
+                        // The cached blocks may be what is missing.
+                        release();
+                        p = boost::alignment::aligned_alloc(alignment, classBytes);
+                    }
+                    if(!p)
+                    {
+                        addRelaxed(counters.m_usedBytes, std::size_t(0u) - classBytes);
+                    }
+                    return p;
+                }
+
+                //-----------------------------------------------------------------------------
+                //! Returns the block to the cache.
+                //!
+                //! \param sizeBytes The size the block has been allocated with.
+                //! \param tag The tag the block has been allocated with.
+                ALPAKA_FN_HOST auto free(
+                    void * const p,
+                    std::size_t const sizeBytes,
+                    std::uint32_t const tag)
+                -> void
+                {
+                    if(!p)
+                    {
+                        return;
+                    }
+
+                    auto const classBytes(getClassBytes(sizeBytes));
+                    auto & counters(getThreadCache().m_counters);
+                    addRelaxed(counters.m_freeCount, 1u);
+                    addRelaxed(counters.m_usedBytes, std::size_t(0u) - classBytes);
+
+                    // The threshold is only a limit for the memory kept, so a slightly outdated value of the cached bytes is fine.
+                    if(m_cachedBytes.load(std::memory_order_relaxed) + classBytes > m_releaseThresholdBytes.load(std::memory_order_relaxed))
+                    {
+                        addRelaxed(counters.m_releaseCount, 1u);
+                        boost::alignment::aligned_free(p);
+                        return;
+                    }
+
+                    m_cachedBytes.fetch_add(classBytes, std::memory_order_relaxed);
+                    pushCachedBlock(Block{p, classBytes, tag});
+                }
+
+                //-----------------------------------------------------------------------------
+                //! Returns all blocks cached in the global pool and in the cache of the calling thread to the system.
+                //! The caches of other threads are kept.
+                ALPAKA_FN_HOST auto release()
+                -> void
+                {
+                    auto & threadCache(getThreadCache());
+                    std::vector<Block> blocks;
+                    threadCache.m_blocks.swap(blocks);
+                    {
+                        std::lock_guard<std::mutex> lk(m_mtx);
+                        for(auto & bin : m_bins)
+                        {
+                            for(auto const p : bin.second)
+                            {
+                                blocks.push_back(Block{p, bin.first.second, bin.first.first});
+                            }
+                        }
+                        m_bins.clear();
+                    }
+                    for(auto const & block : blocks)
+                    {
+                        addRelaxed(threadCache.m_counters.m_releaseCount, 1u);
+                        m_cachedBytes.fetch_sub(block.m_classBytes, std::memory_order_relaxed);
+                        boost::alignment::aligned_free(block.m_p);
+                    }
+                }
+
+                //-----------------------------------------------------------------------------
+                //! Sets the maximum number of bytes held in the caches.
+                //! Already cached blocks are kept even if they exceed the new threshold.
+                ALPAKA_FN_HOST auto setReleaseThreshold(
+                    std::size_t const releaseThresholdBytes)
+                -> void
+                {
+                    m_releaseThresholdBytes = releaseThresholdBytes;
+                }
+                //-----------------------------------------------------------------------------
+                //! \return The maximum number of bytes held in the caches.
+                ALPAKA_FN_HOST auto getReleaseThreshold() const
+                -> std::size_t
+                {
+                    return m_releaseThresholdBytes;
+                }
+
+                //-----------------------------------------------------------------------------
+                //! \return A snapshot of the statistics. The counters are updated without synchronization among each other.
+                //!
+                //! The counters are kept per thread so that allocating does not write shared cache lines. They are summed up here.
+                ALPAKA_FN_HOST auto getStats() const
+                -> AllocCpuCachingStats
+                {
+                    // Creates the counters of the calling thread so that its own allocations are always included.
+                    getThreadCache();
+
+                    std::lock_guard<std::mutex> lk(m_mtxCounters);
+                    Counters sum;
+                    sum.add(m_exitedThreadCounters);
+                    for(auto const pCounters : m_threadCounters)
+                    {
+                        sum.add(*pCounters);
+                    }
+                    return
+                        AllocCpuCachingStats{
+                            sum.m_allocCount.load(std::memory_order_relaxed),
+                            sum.m_cacheHitCount.load(std::memory_order_relaxed),
+                            sum.m_freeCount.load(std::memory_order_relaxed),
+                            sum.m_releaseCount.load(std::memory_order_relaxed),
+                            sum.m_usedBytes.load(std::memory_order_relaxed),
+                            m_cachedBytes.load(std::memory_order_relaxed)};
+                }
+
+            private:
+                //#############################################################################
+                //! A cached block.
+                struct Block
+                {
+                    void * m_p;
+                    std::size_t m_classBytes;
+                    std::uint32_t m_tag;
+                };
+
+                //#############################################################################
+                //! The statistics counters of a single thread.
+                //!
+                //! They are only written by their thread, so they are incremented by a relaxed load and store instead of a read-modify-write.
+                //! Subtractions wrap around, so the sum over all threads is correct even if a block is freed by another thread than the one allocating it.
+                struct Counters
+                {
+                    //-----------------------------------------------------------------------------
+                    //! Adds the values of the other counters.
+                    auto add(
+                        Counters const & other)
+                    -> void
+                    {
+                        addRelaxed(m_allocCount, other.m_allocCount.load(std::memory_order_relaxed));
+                        addRelaxed(m_cacheHitCount, other.m_cacheHitCount.load(std::memory_order_relaxed));
+                        addRelaxed(m_freeCount, other.m_freeCount.load(std::memory_order_relaxed));
+                        addRelaxed(m_releaseCount, other.m_releaseCount.load(std::memory_order_relaxed));
+                        addRelaxed(m_usedBytes, other.m_usedBytes.load(std::memory_order_relaxed));
+                    }
+
+                    std::atomic<std::size_t> m_allocCount{0u};
+                    std::atomic<std::size_t> m_cacheHitCount{0u};
+                    std::atomic<std::size_t> m_freeCount{0u};
+                    std::atomic<std::size_t> m_releaseCount{0u};
+                    std::atomic<std::size_t> m_usedBytes{0u};
+                };
+
+                //#############################################################################
+                //! The blocks cached by a single thread and its statistics counters.
+                struct ThreadCache
+                {
+                    //-----------------------------------------------------------------------------
+                    ThreadCache()
+                    {
+                        auto & alloc(AllocCpuCaching::get());
+                        std::lock_guard<std::mutex> lk(alloc.m_mtxCounters);
+                        alloc.m_threadCounters.push_back(&m_counters);
+                    }
+                    //-----------------------------------------------------------------------------
+                    ThreadCache(ThreadCache const &) = delete;
+                    //-----------------------------------------------------------------------------
+                    ThreadCache(ThreadCache &&) = delete;
+                    //-----------------------------------------------------------------------------
+                    auto operator=(ThreadCache const &) -> ThreadCache & = delete;
+                    //-----------------------------------------------------------------------------
+                    auto operator=(ThreadCache &&) -> ThreadCache & = delete;
+                    //-----------------------------------------------------------------------------
+                    //! Hands the blocks over to the global pool and the counters to the allocator when the thread exits.
+                    ~ThreadCache()
+                    {
+                        auto & alloc(AllocCpuCaching::get());
+                        for(auto const & block : m_blocks)
+                        {
+                            alloc.pushGlobalBlock(block);
+                        }
+
+                        std::lock_guard<std::mutex> lk(alloc.m_mtxCounters);
+                        alloc.m_exitedThreadCounters.add(m_counters);
+                        alloc.m_threadCounters.erase(std::find(alloc.m_threadCounters.begin(), alloc.m_threadCounters.end(), &m_counters));
+                    }
+
+                    std::vector<Block> m_blocks;
+                    Counters m_counters;
+                };
+
+                //-----------------------------------------------------------------------------
+                AllocCpuCaching() :
+                    m_mtx(),
+                    m_bins(),
+                    m_releaseThresholdBytes(std::size_t(1u) << 30u),
+                    m_cachedBytes(0u),
+                    m_mtxCounters(),
+                    m_threadCounters(),
+                    m_exitedThreadCounters()
+                {}
+                //-----------------------------------------------------------------------------
+                ~AllocCpuCaching() = default;
+
+                //-----------------------------------------------------------------------------
+                //! Adds the value to the counter which is only written by the calling thread.
+                ALPAKA_FN_HOST static auto addRelaxed(
+                    std::atomic<std::size_t> & counter,
+                    std::size_t const value)
+                -> void
+                {
+                    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+                }
+
+                //-----------------------------------------------------------------------------
+                //! \return The cache of the calling thread.
+                ALPAKA_FN_HOST static auto getThreadCache()
+                -> ThreadCache &
+                {
+#if BOOST_COMP_CLANG
+    #pragma clang diagnostic push
+    #pragma clang diagnostic ignored "-Wexit-time-destructors"
+#endif
+                    thread_local ThreadCache threadCache;
+#if BOOST_COMP_CLANG
+    #pragma clang diagnostic pop
+#endif
+                    return threadCache;
+                }
+
+                //-----------------------------------------------------------------------------
+                //! \return A cached block of the given class and tag or nullptr if there is none.
+                ALPAKA_FN_HOST auto popCachedBlock(
+                    std::size_t const classBytes,
+                    std::uint32_t const tag)
+                -> void *
+                {
+                    if(classBytes <= maxThreadCacheBlockBytes)
+                    {
+                        auto & blocks(getThreadCache().m_blocks);
+                        // The most recently freed block is the most likely one to still be in the caches of the processor.
+                        for(auto it(blocks.rbegin()); it != blocks.rend(); ++it)
+                        {
+                            if((it->m_classBytes == classBytes) && (it->m_tag == tag))
+                            {
+                                auto const p(it->m_p);
+                                blocks.erase(std::next(it).base());
+                                return p;
+                            }
+                        }
+                    }
+
+                    std::lock_guard<std::mutex> lk(m_mtx);
+                    auto const itBin(m_bins.find(std::make_pair(tag, classBytes)));
+                    if((itBin == m_bins.end()) || itBin->second.empty())
+                    {
+                        return nullptr;
+                    }
+                    auto const p(itBin->second.back());
+                    itBin->second.pop_back();
+                    return p;
+                }
+                //-----------------------------------------------------------------------------
+                //! Caches the block in the cache of the calling thread if possible and in the global pool else.
+                ALPAKA_FN_HOST auto pushCachedBlock(
+                    Block const & block)
+                -> void
+                {
+                    if(block.m_classBytes <= maxThreadCacheBlockBytes)
+                    {
+                        auto & blocks(getThreadCache().m_blocks);
+                        if(blocks.size() < maxThreadCacheBlockCount)
+                        {
+                            blocks.push_back(block);
+                            return;
+                        }
+                    }
+                    pushGlobalBlock(block);
+                }
+                //-----------------------------------------------------------------------------
+                //! Caches the block in the global pool.
+                ALPAKA_FN_HOST auto pushGlobalBlock(
+                    Block const & block)
+                -> void
+                {
+                    std::lock_guard<std::mutex> lk(m_mtx);
+                    m_bins[std::make_pair(block.m_tag, block.m_classBytes)].push_back(block.m_p);
+                }
+
+                std::mutex m_mtx;
+                std::map<std::pair<std::uint32_t, std::size_t>, std::vector<void *>> m_bins;   //!< The global pool. The blocks are binned by tag and size class.
+
+                std::atomic<std::size_t> m_releaseThresholdBytes;
+                std::atomic<std::size_t> m_cachedBytes;     //!< The size of the blocks held in all caches. It is shared because the release threshold applies to all of them.
+
+                std::mutex mutable m_mtxCounters;
+                std::vector<Counters const *> m_threadCounters; //!< The counters of the threads currently running. Guarded by m_mtxCounters.
+                Counters m_exitedThreadCounters;                //!< The sum of the counters of the exited threads. Guarded by m_mtxCounters.
+            };
+        }
+    }
+}
@@ -0,0 +1,143 @@
+/* Copyright 2019 Benjamin Worpitz
+ *
+ * This file is part of Alpaka.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <alpaka/core/BoostPredef.hpp>
+#include <alpaka/core/Common.hpp>
+#include <alpaka/core/Unused.hpp>
+
+#if BOOST_OS_LINUX
+    #include <sys/mman.h>
+#else
+    #include <boost/align.hpp>
+#endif
+
+#include <cstddef>
+#include <cstdint>
+
+namespace alpaka
+{
+    namespace mem
+    {
+        namespace alloc
+        {
+            //#############################################################################
+            //! The huge page backing of a CPU allocation.
+            enum class HugePages
+            {
+                Disabled,       //!< The memory is backed by the default pages.
+                Transparent,    //!< The memory is aligned to huge pages and advised to be backed by transparent huge pages.
+                HugeTlb         //!< The memory is backed by pages reserved in the hugetlbfs pool. Falls back to Transparent if the pool is exhausted.
+            };
+
+            //#############################################################################
+            //! The CPU huge page allocator.
+            //!
+            //! The blocks are aligned to and padded to multiples of the huge page size, so that no block shares a huge page with other data.
+            //! On systems without huge page support the blocks are only aligned.
+            class AllocCpuHugePages final
+            {
+            public:
+                //! The size and alignment of a huge page.
+                static constexpr std::size_t pageBytes = std::size_t(2u) << 20u;
+
+                //-----------------------------------------------------------------------------
+                //! \return The size of the block allocated for the given size.
+                ALPAKA_FN_HOST static auto getAllocBytes(
+                    std::size_t const sizeBytes)
+                -> std::size_t
+                {
+                    return (sizeBytes + pageBytes - 1u) / pageBytes * pageBytes;
+                }
+
+                //-----------------------------------------------------------------------------
+                //! \return A block of at least the given size aligned to pageBytes or nullptr if the allocation failed or the size is zero.
+                ALPAKA_FN_HOST static auto alloc(
+                    std::size_t const sizeBytes,
+                    HugePages const hugePages)
+                -> void *
+                {
+                    auto const allocBytes(getAllocBytes(sizeBytes));
+                    if(allocBytes == 0u)
+                    {
+                        return nullptr;
+                    }
+#if BOOST_OS_LINUX
+    #ifdef MAP_HUGETLB
+                    if(hugePages == HugePages::HugeTlb)
+                    {
+                        // The mapping is aligned to the huge page size by the kernel.
+                        void * const p(::mmap(nullptr, allocBytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0));
+                        if(p != MAP_FAILED)
+                        {
+                            return p;
+                        }
+                    }
+    #endif
+                    // Map one additional huge page and unmap the unaligned head and the remaining tail.
+                    auto const mapBytes(allocBytes + pageBytes);
+                    void * const pMap(::mmap(nullptr, mapBytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+                    if(pMap == MAP_FAILED)
+                    {
+                        return nullptr;
+                    }
+                    auto const mapBegin(reinterpret_cast<std::uintptr_t>(pMap));
+                    auto const mapEnd(mapBegin + mapBytes);
+                    auto const begin((mapBegin + pageBytes - 1u) / pageBytes * pageBytes);
+                    auto const end(begin + allocBytes);
+                    if(begin > mapBegin)
+                    {
+                        ::munmap(pMap, begin - mapBegin);
+                    }
+                    if(mapEnd > end)
+                    {
+                        ::munmap(reinterpret_cast<void *>(end), mapEnd - end);
+                    }
+                    void * const p(reinterpret_cast<void *>(begin));
+    #ifdef MADV_HUGEPAGE
+                    if(hugePages != HugePages::Disabled)
+                    {
+                        // The advice is best effort. It fails if the kernel does not support transparent huge pages.
+                        ::madvise(p, allocBytes, MADV_HUGEPAGE);
+                    }
+    #else
+                    alpaka::ignore_unused(hugePages);
+    #endif
+                    return p;
+#else
+                    alpaka::ignore_unused(hugePages);
+                    return boost::alignment::aligned_alloc(pageBytes, allocBytes);
+#endif
+                }
+
+                //-----------------------------------------------------------------------------
+                //! Frees the block.
+                //!
+                //! \param sizeBytes The size the block has been allocated with.
+                ALPAKA_FN_HOST static auto free(
+                    void * const p,
+                    std::size_t const sizeBytes)
+                -> void
+                {
+                    if(!p)
+                    {
+                        return;
+                    }
+#if BOOST_OS_LINUX
+                    ::munmap(p, getAllocBytes(sizeBytes));
+#else
+                    alpaka::ignore_unused(sizeBytes);
+                    boost::alignment::aligned_free(p);
+#endif
+                }
+            };
+        }
+    }
+}
@@ -12,6 +12,7 @@
 #include <alpaka/core/Vectorize.hpp>
 #include <alpaka/core/Unused.hpp>
 #include <alpaka/dev/DevCpu.hpp>
+#include <alpaka/dev/cpu/Numa.hpp>
 
 #include <alpaka/dev/Traits.hpp>
 #include <alpaka/mem/buf/Traits.hpp>
@@ -24,10 +25,17 @@
 #endif
 
 #include <alpaka/mem/alloc/AllocCpuBoostAligned.hpp>
+#include <alpaka/mem/alloc/AllocCpuCaching.hpp>
+#include <alpaka/mem/alloc/AllocCpuHugePages.hpp>
+#include <alpaka/mem/buf/cpu/FirstTouch.hpp>
 
 #include <alpaka/meta/DependentFalseType.hpp>
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <new>
 
 namespace alpaka
 {
@@ -37,6 +45,75 @@ namespace alpaka
         {
             namespace cpu
             {
+                namespace detail
+                {
+                    //-----------------------------------------------------------------------------
+                    //! \return The flag enabling the caching allocator for CPU buffers.
+                    inline auto cachingFlag()
+                    -> std::atomic<bool> &
+                    {
+                        static std::atomic<bool> bCaching(false);
+                        return bCaching;
+                    }
+                    //-----------------------------------------------------------------------------
+                    //! \return The huge page backing of CPU buffers reaching the huge page threshold.
+                    inline auto hugePagesFlag()
+                    -> std::atomic<mem::alloc::HugePages> &
+                    {
+                        static std::atomic<mem::alloc::HugePages> hugePages(mem::alloc::HugePages::Disabled);
+                        return hugePages;
+                    }
+                    //-----------------------------------------------------------------------------
+                    //! \return The minimum size of CPU buffers backed by huge pages.
+                    inline auto hugePagesThresholdBytes()
+                    -> std::atomic<std::size_t> &
+                    {
+                        static std::atomic<std::size_t> thresholdBytes(mem::alloc::AllocCpuHugePages::pageBytes);
+                        return thresholdBytes;
+                    }
+                }
+
+                //-----------------------------------------------------------------------------
+                //! Enables or disables the caching allocator for the CPU buffers allocated afterwards.
+                //!
+                //! With caching enabled, the memory of destroyed buffers is kept by mem::alloc::AllocCpuCaching and reused for later buffers of the same size class.
+                //! Buffers always return their memory to the allocator they have been allocated with.
+                ALPAKA_FN_HOST inline auto setCaching(
+                    bool const bCaching)
+                -> void
+                {
+                    detail::cachingFlag() = bCaching;
+                }
+                //-----------------------------------------------------------------------------
+                //! \return If the caching allocator is used for CPU buffers.
+                ALPAKA_FN_HOST inline auto isCaching()
+                -> bool
+                {
+                    return detail::cachingFlag();
+                }
+
+                //-----------------------------------------------------------------------------
+                //! Sets the huge page backing of the CPU buffers allocated afterwards with at least the given size.
+                //!
+                //! Smaller buffers would waste most of a huge page and therefore keep the default allocation.
+                //! The backing of single buffers can be selected explicitly with mem::buf::cpu::alloc.
+                ALPAKA_FN_HOST inline auto setHugePages(
+                    mem::alloc::HugePages const hugePages,
+                    std::size_t const thresholdBytes = mem::alloc::AllocCpuHugePages::pageBytes)
+                -> void
+                {
+                    detail::hugePagesThresholdBytes() = thresholdBytes;
+                    detail::hugePagesFlag() = hugePages;
+                }
+                //-----------------------------------------------------------------------------
+                //! \return The huge page backing of CPU buffers of the given size.
+                ALPAKA_FN_HOST inline auto getHugePages(
+                    std::size_t const sizeBytes)
+                -> mem::alloc::HugePages
+                {
+                    return (sizeBytes >= detail::hugePagesThresholdBytes()) ? detail::hugePagesFlag().load() : mem::alloc::HugePages::Disabled;
+                }
+
                 namespace detail
                 {
                     //#############################################################################
@@ -61,10 +138,24 @@ namespace alpaka
                         ALPAKA_FN_HOST BufCpuImpl(
                             dev::DevCpu const & dev,
                             TExtent const & extent) :
+                                BufCpuImpl(
+                                    dev,
+                                    extent,
+                                    cpu::getHugePages(static_cast<std::size_t>(computeElementCount(extent)) * sizeof(TElem)))
+                        {}
+                        //-----------------------------------------------------------------------------
+                        template<
+                            typename TExtent>
+                        ALPAKA_FN_HOST BufCpuImpl(
+                            dev::DevCpu const & dev,
+                            TExtent const & extent,
+                            mem::alloc::HugePages const hugePages) :
                                 mem::alloc::AllocCpuBoostAligned<std::integral_constant<std::size_t, core::vectorization::defaultAlignment>>(),
                                 m_dev(dev),
                                 m_extentElements(extent::getExtentVecEnd<TDim>(extent)),
-                                m_pMem(mem::alloc::alloc<TElem>(*this, static_cast<std::size_t>(computeElementCount(extent)))),
+                                m_hugePages(hugePages),
+                                m_bCached((hugePages == mem::alloc::HugePages::Disabled) && cpu::isCaching()),
+                                m_pMem(allocMem()),
                                 m_pitchBytes(static_cast<TIdx>(extent::getWidth(extent) * static_cast<TIdx>(sizeof(TElem))))
 #if defined(ALPAKA_ACC_GPU_CUDA_ENABLED) && BOOST_LANG_CUDA
                                 ,m_bPinned(false)
@@ -79,6 +170,29 @@ namespace alpaka
                                 std::is_same<TIdx, idx::Idx<TExtent>>::value,
                                 "The idx type of TExtent and the TIdx template parameter have to be identical!");
 
+                            // The destructor is not called if the constructor throws, so the memory is freed here.
+                            try
+                            {
+                                // Buffers of a device bound to a NUMA node are placed into the memory of the node.
+                                if(m_dev.m_spDevCpuImpl->isNumaNode())
+                                {
+                                    dev::cpu::detail::bindMemToNumaNode(
+                                        m_pMem,
+                                        static_cast<std::size_t>(computeElementCount(extent)) * sizeof(TElem),
+                                        m_dev.m_spDevCpuImpl->getNumaNodeIdx());
+                                }
+                                // The pages are placed by the thread touching them first, so they are touched by the CPUs executing the kernels.
+                                if(cpu::isFirstTouch())
+                                {
+                                    cpu::detail::touchPages(m_pMem, getSizeBytes(), cpu::detail::getFirstTouchPolicy(m_dev));
+                                }
+                            }
+                            catch(...)
+                            {
+                                freeMem();
+                                throw;
+                            }
+
 #if ALPAKA_DEBUG >= ALPAKA_DEBUG_FULL
                             std::cout << __func__
                                 << " e: " << m_extentElements
@@ -104,11 +218,70 @@ namespace alpaka
                             // Unpin this memory if it is currently pinned.
                             mem::buf::unpin(*this);
 #endif
-                            // NOTE: m_pMem is allowed to be a nullptr here.
-                            mem::alloc::free(*this, m_pMem);
+                            freeMem();
                         }
 
                     private:
+                        //-----------------------------------------------------------------------------
+                        //! \return The number of bytes of the buffer.
+                        ALPAKA_FN_HOST auto getSizeBytes() const
+                        -> std::size_t
+                        {
+                            return static_cast<std::size_t>(computeElementCount(m_extentElements)) * sizeof(TElem);
+                        }
+                        //-----------------------------------------------------------------------------
+                        //! \return The tag of the cached blocks which can be reused for this buffer.
+                        //! Blocks bound to a NUMA node are only reused for buffers of devices bound to the same node.
+                        ALPAKA_FN_HOST auto getCachingTag() const
+                        -> std::uint32_t
+                        {
+                            return m_dev.m_spDevCpuImpl->isNumaNode() ? m_dev.m_spDevCpuImpl->getNumaNodeIdx() + 1u : 0u;
+                        }
+                        //-----------------------------------------------------------------------------
+                        //! Returns the memory of the buffer to the allocator it has been allocated with.
+                        ALPAKA_FN_HOST auto freeMem()
+                        -> void
+                        {
+                            // NOTE: m_pMem is allowed to be a nullptr here.
+                            if(m_hugePages != mem::alloc::HugePages::Disabled)
+                            {
+                                mem::alloc::AllocCpuHugePages::free(m_pMem, getSizeBytes());
+                            }
+                            else if(m_bCached)
+                            {
+                                mem::alloc::AllocCpuCaching::get().free(m_pMem, getSizeBytes(), getCachingTag());
+                            }
+                            else
+                            {
+                                mem::alloc::free(*this, m_pMem);
+                            }
+                        }
+                        //-----------------------------------------------------------------------------
+                        //! \return The memory of the buffer.
+                        ALPAKA_FN_HOST auto allocMem() const
+                        -> TElem *
+                        {
+                            static_assert(
+                                core::vectorization::defaultAlignment <= mem::alloc::AllocCpuCaching::alignment,
+                                "The caching allocator does not provide the alignment required for CPU buffers!");
+
+                            if(m_hugePages != mem::alloc::HugePages::Disabled)
+                            {
+                                return reinterpret_cast<TElem *>(mem::alloc::AllocCpuHugePages::alloc(getSizeBytes(), m_hugePages));
+                            }
+                            if(m_bCached)
+                            {
+                                // The caching allocator always returns a block, so nullptr means the allocation failed or the size is not representable.
+                                auto const p(mem::alloc::AllocCpuCaching::get().alloc(getSizeBytes(), getCachingTag()));
+                                if(!p)
+                                {
+                                    throw std::bad_alloc();
+                                }
+                                return reinterpret_cast<TElem *>(p);
+                            }
+                            return mem::alloc::alloc<TElem>(*this, static_cast<std::size_t>(computeElementCount(m_extentElements)));
+                        }
+
                         //-----------------------------------------------------------------------------
                         //! \return The number of elements to allocate.
                         template<
@@ -125,6 +298,8 @@ namespace alpaka
                     public:
                         dev::DevCpu const m_dev;
                         vec::Vec<TDim, TIdx> const m_extentElements;
+                        mem::alloc::HugePages const m_hugePages;    //!< The huge page backing. Buffers backed by huge pages are not cached.
+                        bool const m_bCached;               //!< If the memory has been allocated by the caching allocator.
                         TElem * const m_pMem;
                         TIdx const m_pitchBytes;
 #if defined(ALPAKA_ACC_GPU_CUDA_ENABLED) && BOOST_LANG_CUDA
@@ -151,6 +326,15 @@ namespace alpaka
                         m_spBufCpuImpl(std::make_shared<cpu::detail::BufCpuImpl<TElem, TDim, TIdx>>(dev, extent))
                 {}
                 //-----------------------------------------------------------------------------
+                template<
+                    typename TExtent>
+                ALPAKA_FN_HOST BufCpu(
+                    dev::DevCpu const & dev,
+                    TExtent const & extent,
+                    mem::alloc::HugePages const hugePages) :
+                        m_spBufCpuImpl(std::make_shared<cpu::detail::BufCpuImpl<TElem, TDim, TIdx>>(dev, extent, hugePages))
+                {}
+                //-----------------------------------------------------------------------------
                 BufCpu(BufCpu const &) = default;
                 //-----------------------------------------------------------------------------
                 BufCpu(BufCpu &&) = default;
@@ -164,6 +348,24 @@ namespace alpaka
             public:
                 std::shared_ptr<cpu::detail::BufCpuImpl<TElem, TDim, TIdx>> m_spBufCpuImpl;
             };
+
+            namespace cpu
+            {
+                //-----------------------------------------------------------------------------
+                //! Allocates a CPU buffer with the given huge page backing independent of its size.
+                template<
+                    typename TElem,
+                    typename TIdx,
+                    typename TExtent>
+                ALPAKA_FN_HOST auto alloc(
+                    dev::DevCpu const & dev,
+                    TExtent const & extent,
+                    mem::alloc::HugePages const hugePages)
+                -> BufCpu<TElem, dim::Dim<TExtent>, TIdx>
+                {
+                    return BufCpu<TElem, dim::Dim<TExtent>, TIdx>(dev, extent, hugePages);
+                }
+            }
         }
     }
 
@@ -0,0 +1,170 @@
+/* Copyright 2019 Benjamin Worpitz
+ *
+ * This file is part of Alpaka.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <alpaka/core/BoostPredef.hpp>
+#include <alpaka/core/Common.hpp>
+#include <alpaka/core/ThreadAffinity.hpp>
+#include <alpaka/dev/DevCpu.hpp>
+
+#if BOOST_OS_LINUX
+    #include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace alpaka
+{
+    namespace mem
+    {
+        namespace buf
+        {
+            namespace cpu
+            {
+                namespace detail
+                {
+                    //-----------------------------------------------------------------------------
+                    //! \return The flag enabling the parallel first touch of new CPU buffers.
+                    inline auto firstTouchFlag()
+                    -> std::atomic<bool> &
+                    {
+                        static std::atomic<bool> bFirstTouch(false);
+                        return bFirstTouch;
+                    }
+
+                    //-----------------------------------------------------------------------------
+                    //! \return The size of the pages the memory is placed with.
+                    inline auto getPageBytes()
+                    -> std::size_t
+                    {
+#if BOOST_OS_LINUX
+                        return static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+#else
+                        return 4096u;
+#endif
+                    }
+
+                    //-----------------------------------------------------------------------------
+                    //! \return The policy the pages are touched with.
+                    //!
+                    //! This is the affinity policy of the device, so that the pages are placed where the block threads of its kernels run.
+                    //! If the block threads are not pinned, the pages are spread over all CPUs of the device.
+                    ALPAKA_FN_HOST inline auto getFirstTouchPolicy(
+                        dev::DevCpu const & dev)
+                    -> core::threads::AffinityPolicy
+                    {
+                        auto policy(dev::cpu::getAffinityPolicy(dev));
+                        if(policy.getKind() == core::threads::AffinityPolicy::Kind::Inherit)
+                        {
+                            policy = core::threads::AffinityPolicy::explicitCpus(dev::cpu::getCpuSet(dev));
+                        }
+                        return policy;
+                    }
+
+                    //-----------------------------------------------------------------------------
+                    //! Writes the first byte of each page within the given memory range so that the operating system places the page.
+                    //!
+                    //! The pages are statically partitioned into one contiguous range per CPU of the policy,
+                    //! like the iterations of an OpenMP schedule(static) loop.
+                    //! Worker i touches the i-th range while being pinned to the CPUs the policy assigns to worker i.
+                    //! The contents of the memory are undefined afterwards.
+                    ALPAKA_FN_HOST inline auto touchPages(
+                        void * const pMem,
+                        std::size_t const sizeBytes,
+                        core::threads::AffinityPolicy const & policy)
+                    -> void
+                    {
+                        if(!pMem || (sizeBytes == 0u))
+                        {
+                            return;
+                        }
+
+                        // The first byte of the range and the first byte of all further pages within the range.
+                        auto const pBytes(static_cast<std::uint8_t *>(pMem));
+                        auto const pageBytes(getPageBytes());
+                        auto const begin(reinterpret_cast<std::uintptr_t>(pMem));
+                        auto const firstPageOffset((begin / pageBytes + 1u) * pageBytes - begin);
+                        std::size_t const touchCount(1u + ((sizeBytes > firstPageOffset) ? (sizeBytes - firstPageOffset + pageBytes - 1u) / pageBytes : 0u));
+                        auto const touchRange(
+                            [pBytes, pageBytes, firstPageOffset](std::size_t const first, std::size_t const last)
+                            {
+                                for(std::size_t i(first); i < last; ++i)
+                                {
+                                    pBytes[(i == 0u) ? 0u : firstPageOffset + (i - 1u) * pageBytes] = 0u;
+                                }
+                            });
+
+                        // Each worker gets enough pages to amortize the creation of its thread.
+                        std::size_t const minTouchCountPerWorker(256u);
+                        auto const workerCount(std::min(policy.getCpus().size(), (touchCount + minTouchCountPerWorker - 1u) / minTouchCountPerWorker));
+                        if(workerCount <= 1u)
+                        {
+                            touchRange(0u, touchCount);
+                            return;
+                        }
+
+                        std::vector<std::thread> workers;
+                        workers.reserve(workerCount);
+                        try
+                        {
+                            for(std::size_t workerIdx(0u); workerIdx < workerCount; ++workerIdx)
+                            {
+                                workers.emplace_back(
+                                    [&policy, &touchRange, workerIdx, workerCount, touchCount]()
+                                    {
+                                        core::threads::pinCurrentThread(policy, workerIdx);
+                                        touchRange(touchCount * workerIdx / workerCount, touchCount * (workerIdx + 1u) / workerCount);
+                                    });
+                            }
+                        }
+                        catch(...)
+                        {
+                            for(auto & worker : workers)
+                            {
+                                worker.join();
+                            }
+                            throw;
+                        }
+                        for(auto & worker : workers)
+                        {
+                            worker.join();
+                        }
+                    }
+                }
+
+                //-----------------------------------------------------------------------------
+                //! Enables or disables the parallel first touch of the CPU buffers allocated afterwards.
+                //!
+                //! Pages are placed into the memory of the NUMA node of the CPU touching them first.
+                //! Without this, the first kernel or mem::view::set writing a buffer decides the placement, often from a single thread.
+                //! With this enabled, the pages of new buffers are touched by one thread per CPU of the device affinity policy,
+                //! so that the later kernels find their pages local.
+                ALPAKA_FN_HOST inline auto setFirstTouch(
+                    bool const bFirstTouch)
+                -> void
+                {
+                    detail::firstTouchFlag() = bFirstTouch;
+                }
+                //-----------------------------------------------------------------------------
+                //! \return If the pages of new CPU buffers are touched in parallel.
+                ALPAKA_FN_HOST inline auto isFirstTouch()
+                -> bool
+                {
+                    return detail::firstTouchFlag();
+                }
+            }
+        }
+    }
+}
@@ -10,8 +10,11 @@
 #pragma once
 
 #include <alpaka/pltf/Traits.hpp>
+#include <alpaka/core/BoostPredef.hpp>
 #include <alpaka/dev/DevCpu.hpp>
+#include <alpaka/dev/cpu/Numa.hpp>
 
+#include <atomic>
 #include <sstream>
 #include <vector>
 
@@ -27,6 +30,42 @@ namespace alpaka
             //-----------------------------------------------------------------------------
             ALPAKA_FN_HOST PltfCpu() = delete;
         };
+
+        namespace cpu
+        {
+            namespace detail
+            {
+                //-----------------------------------------------------------------------------
+                //! \return The flag enabling the NUMA aware mode of the CPU platform.
+                inline auto numaAwareFlag()
+                -> std::atomic<bool> &
+                {
+                    static std::atomic<bool> bNumaAware(false);
+                    return bNumaAware;
+                }
+            }
+
+            //-----------------------------------------------------------------------------
+            //! Enables or disables the NUMA aware mode of the CPU platform.
+            //!
+            //! In the NUMA aware mode the platform provides one device per NUMA node having CPUs.
+            //! Queues of such a device execute their tasks on the CPUs of the node and buffers allocated on it are preferably placed into the memory of the node.
+            //! If the NUMA topology is not available, the platform provides the single device spanning the whole system as in the default mode.
+            //! Devices that have been retrieved before keep their binding.
+            ALPAKA_FN_HOST inline auto setNumaAware(
+                bool const bNumaAware)
+            -> void
+            {
+                detail::numaAwareFlag() = bNumaAware;
+            }
+            //-----------------------------------------------------------------------------
+            //! \return If the NUMA aware mode of the CPU platform is enabled.
+            ALPAKA_FN_HOST inline auto isNumaAware()
+            -> bool
+            {
+                return detail::numaAwareFlag();
+            }
+        }
     }
 
     namespace dev
@@ -59,16 +98,42 @@ namespace alpaka
                 {
                     ALPAKA_DEBUG_FULL_LOG_SCOPE;
 
+                    if(pltf::cpu::isNumaAware())
+                    {
+                        auto const numaNodeCount(dev::cpu::detail::getNumaNodes().size());
+                        if(numaNodeCount > 0u)
+                        {
+                            return numaNodeCount;
+                        }
+                    }
+
                     return 1;
                 }
             };
 
             //#############################################################################
             //! The CPU platform device get trait specialization.
+            //!
+            //! All handles of a device share one implementation, so that its state, e.g. the affinity policy, is the same for every handle.
             template<>
             struct GetDevByIdx<
                 pltf::PltfCpu>
             {
+            private:
+                //-----------------------------------------------------------------------------
+                //! \return One device per NUMA node having CPUs.
+                ALPAKA_FN_HOST static auto createNumaNodeDevs()
+                -> std::vector<dev::DevCpu>
+                {
+                    std::vector<dev::DevCpu> devs;
+                    for(auto const & numaNode : dev::cpu::detail::getNumaNodes())
+                    {
+                        devs.push_back(dev::DevCpu(numaNode));
+                    }
+                    return devs;
+                }
+
+            public:
                 //-----------------------------------------------------------------------------
                 ALPAKA_FN_HOST static auto getDevByIdx(
                     std::size_t const & devIdx)
@@ -84,7 +149,24 @@ namespace alpaka
                         throw std::runtime_error(ssErr.str());
                     }
 
-                    return {};
+#if BOOST_COMP_CLANG
+    #pragma clang diagnostic push
+    #pragma clang diagnostic ignored "-Wexit-time-destructors"
+#endif
+                    if(pltf::cpu::isNumaAware())
+                    {
+                        static std::vector<dev::DevCpu> const numaNodeDevs(createNumaNodeDevs());
+                        if(!numaNodeDevs.empty())
+                        {
+                            return numaNodeDevs[devIdx];
+                        }
+                    }
+
+                    static dev::DevCpu const dev;
+#if BOOST_COMP_CLANG
+    #pragma clang diagnostic pop
+#endif
+                    return dev;
                 }
             };
         }
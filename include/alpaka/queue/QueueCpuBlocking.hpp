@@ -9,17 +9,26 @@
 
 #pragma once
 
+#include <alpaka/core/ThreadAffinity.hpp>
 #include <alpaka/core/Unused.hpp>
 #include <alpaka/dev/DevCpu.hpp>
+#include <alpaka/graph/GraphCpu.hpp>
+#include <alpaka/queue/cpu/HostFnTask.hpp>
 #include <alpaka/queue/cpu/ICpuQueue.hpp>
 
 #include <alpaka/dev/Traits.hpp>
 #include <alpaka/event/Traits.hpp>
+#include <alpaka/graph/Traits.hpp>
 #include <alpaka/queue/Traits.hpp>
 #include <alpaka/wait/Traits.hpp>
 
 #include <atomic>
+#include <cstdint>
+#include <memory>
 #include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
 
 namespace alpaka
 {
@@ -53,9 +62,13 @@ namespace alpaka
                 public:
                     //-----------------------------------------------------------------------------
                     QueueCpuBlockingImpl(
-                        dev::DevCpu const & dev) noexcept :
+                        dev::DevCpu const & dev,
+                        core::threads::AffinityPolicy const & affinityPolicy) :
                             m_dev(dev),
-                            m_bCurrentlyExecutingTask(false)
+                            m_affinityPolicy(affinityPolicy),
+                            m_workerCpus(dev::cpu::detail::getQueueWorkerCpus(dev, affinityPolicy)),
+                            m_bCurrentlyExecutingTask(false),
+                            m_spCapturedGraph()
                     {}
                     //-----------------------------------------------------------------------------
                     QueueCpuBlockingImpl(QueueCpuBlockingImpl const &) = delete;
@@ -80,8 +93,12 @@ namespace alpaka
 
                 public:
                     dev::DevCpu const m_dev;            //!< The device this queue is bound to.
+                    core::threads::AffinityPolicy const m_affinityPolicy;   //!< The affinity policy of the kernels executed by this queue.
+                    std::vector<std::uint32_t> const m_workerCpus;          //!< The CPUs the calling thread is restricted to while it executes a task.
                     std::mutex mutable m_mutex;
                     std::atomic<bool> m_bCurrentlyExecutingTask;
+
+                    std::shared_ptr<graph::cpu::detail::GraphCpuImpl> m_spCapturedGraph;    //!< The graph the enqueued tasks are recorded into while capturing, nullptr else.
                 };
             }
         }
@@ -94,7 +111,14 @@ namespace alpaka
             //-----------------------------------------------------------------------------
             QueueCpuBlocking(
                 dev::DevCpu const & dev) :
-                    m_spQueueImpl(std::make_shared<cpu::detail::QueueCpuBlockingImpl>(dev))
+                    QueueCpuBlocking(dev, dev::cpu::getAffinityPolicy(dev))
+            {}
+            //-----------------------------------------------------------------------------
+            //! Creates a queue using the given affinity policy instead of the one of the device.
+            QueueCpuBlocking(
+                dev::DevCpu const & dev,
+                core::threads::AffinityPolicy const & affinityPolicy) :
+                    m_spQueueImpl(std::make_shared<cpu::detail::QueueCpuBlockingImpl>(dev, affinityPolicy))
             {
                 dev.m_spDevCpuImpl->RegisterQueue(m_spQueueImpl);
             }
@@ -124,6 +148,18 @@ namespace alpaka
         public:
             std::shared_ptr<cpu::detail::QueueCpuBlockingImpl> m_spQueueImpl;
         };
+
+        namespace cpu
+        {
+            //-----------------------------------------------------------------------------
+            //! \return The affinity policy of the queue.
+            ALPAKA_FN_HOST inline auto getAffinityPolicy(
+                QueueCpuBlocking const & queue)
+            -> core::threads::AffinityPolicy const &
+            {
+                return queue.m_spQueueImpl->m_affinityPolicy;
+            }
+        }
     }
 
     namespace dev
@@ -189,9 +225,65 @@ namespace alpaka
                 {
                     std::lock_guard<std::mutex> lk(queue.m_spQueueImpl->m_mutex);
 
+                    if(queue.m_spQueueImpl->m_spCapturedGraph)
+                    {
+                        queue.m_spQueueImpl->m_spCapturedGraph->record(
+                            task);
+                        return;
+                    }
+
                     queue.m_spQueueImpl->m_bCurrentlyExecutingTask = true;
 
-                    task();
+                    {
+                        // The task is executed on the CPUs of the queue worker. Threads created by the task inherit the affinity.
+                        core::threads::ScopedThreadAffinity const affinity(queue.m_spQueueImpl->m_workerCpus);
+                        core::threads::ScopedAffinityPolicy const affinityPolicy(queue.m_spQueueImpl->m_affinityPolicy);
+                        task();
+                    }
+
+                    queue.m_spQueueImpl->m_bCurrentlyExecutingTask = false;
+                }
+            };
+            //#############################################################################
+            //! The CPU blocking device queue host function enqueue trait specialization.
+            //!
+            //! The function is directly called by the enqueuing thread with the arguments moved into it.
+            template<>
+            struct EnqueueHostFn<
+                queue::QueueCpuBlocking>
+            {
+                //-----------------------------------------------------------------------------
+                template<
+                    typename TFn,
+                    typename... TArgs>
+                ALPAKA_FN_HOST static auto enqueueHostFn(
+                    queue::QueueCpuBlocking & queue,
+                    TFn && fn,
+                    TArgs && ... args)
+                -> void
+                {
+                    // The arguments are decayed like in the non-blocking queue so that the function behaves the same in both queues.
+                    auto task(
+                        cpu::detail::makeHostFnTask(
+                            std::forward<TFn>(fn),
+                            std::forward<TArgs>(args)...));
+
+                    std::lock_guard<std::mutex> lk(queue.m_spQueueImpl->m_mutex);
+
+                    if(queue.m_spQueueImpl->m_spCapturedGraph)
+                    {
+                        // The arguments are moved into the function, so the task can not be launched repeatedly.
+                        throw std::runtime_error("Host functions can not be recorded into a graph!");
+                    }
+
+                    queue.m_spQueueImpl->m_bCurrentlyExecutingTask = true;
+
+                    {
+                        // The task is executed on the CPUs of the queue worker. Threads created by the task inherit the affinity.
+                        core::threads::ScopedThreadAffinity const affinity(queue.m_spQueueImpl->m_workerCpus);
+                        core::threads::ScopedAffinityPolicy const affinityPolicy(queue.m_spQueueImpl->m_affinityPolicy);
+                        task();
+                    }
 
                     queue.m_spQueueImpl->m_bCurrentlyExecutingTask = false;
                 }
@@ -213,6 +305,52 @@ namespace alpaka
         }
     }
 
+    namespace graph
+    {
+        namespace traits
+        {
+            //#############################################################################
+            //! The CPU blocking device queue graph type trait specialization.
+            template<>
+            struct GraphType<
+                queue::QueueCpuBlocking>
+            {
+                using type = graph::GraphCpu;
+            };
+            //#############################################################################
+            //! The CPU blocking device queue graph capture begin trait specialization.
+            template<>
+            struct BeginCapture<
+                queue::QueueCpuBlocking>
+            {
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST static auto beginCapture(
+                    queue::QueueCpuBlocking & queue)
+                -> void
+                {
+                    std::lock_guard<std::mutex> lk(queue.m_spQueueImpl->m_mutex);
+
+                    graph::cpu::detail::beginCapture(queue.m_spQueueImpl->m_spCapturedGraph);
+                }
+            };
+            //#############################################################################
+            //! The CPU blocking device queue graph capture end trait specialization.
+            template<>
+            struct EndCapture<
+                queue::QueueCpuBlocking>
+            {
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST static auto endCapture(
+                    queue::QueueCpuBlocking & queue)
+                -> graph::GraphCpu
+                {
+                    std::lock_guard<std::mutex> lk(queue.m_spQueueImpl->m_mutex);
+
+                    return graph::cpu::detail::endCapture(queue.m_spQueueImpl->m_spCapturedGraph);
+                }
+            };
+        }
+    }
     namespace wait
     {
         namespace traits
@@ -0,0 +1,811 @@
+/* Copyright 2019 Benjamin Worpitz
+ *
+ * This file is part of Alpaka.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <alpaka/core/ConcurrentExecPool.hpp>
+#include <alpaka/core/ThreadAffinity.hpp>
+#include <alpaka/dev/DevCpu.hpp>
+#include <alpaka/event/EventCpu.hpp>
+#include <alpaka/queue/cpu/HostFnTask.hpp>
+#include <alpaka/queue/cpu/ICpuQueue.hpp>
+
+#include <alpaka/dev/Traits.hpp>
+#include <alpaka/event/Traits.hpp>
+#include <alpaka/mem/view/Traits.hpp>
+#include <alpaka/queue/Traits.hpp>
+#include <alpaka/wait/Traits.hpp>
+
+#include <alpaka/core/Unused.hpp>
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace alpaka
+{
+    namespace queue
+    {
+        namespace cpu
+        {
+            //#############################################################################
+            //! A range of bytes [begin, end) accessed by a task.
+            struct MemRange
+            {
+                std::uintptr_t m_begin;
+                std::uintptr_t m_end;
+
+                //-----------------------------------------------------------------------------
+                auto overlaps(
+                    MemRange const & other) const
+                -> bool
+                {
+                    return (m_begin < other.m_end) && (other.m_begin < m_end);
+                }
+            };
+
+            //-----------------------------------------------------------------------------
+            //! \return The range of bytes covered by the given view.
+            //! For views with pitched rows the padding is included, so the range may be larger than the accessed memory but never smaller.
+            template<
+                typename TView>
+            ALPAKA_FN_HOST auto getMemRange(
+                TView const & view)
+            -> MemRange
+            {
+                auto const begin(reinterpret_cast<std::uintptr_t>(mem::view::getPtrNative(view)));
+                return MemRange{begin, begin + static_cast<std::uintptr_t>(mem::view::getPitchBytes<0u>(view))};
+            }
+
+            //#############################################################################
+            //! The memory ranges read by a task.
+            struct ReadSet
+            {
+                std::vector<MemRange> m_ranges;
+            };
+            //#############################################################################
+            //! The memory ranges written by a task.
+            struct WriteSet
+            {
+                std::vector<MemRange> m_ranges;
+            };
+
+            //-----------------------------------------------------------------------------
+            //! \return The set of memory ranges covered by the given views which are read by a task.
+            template<
+                typename... TViews>
+            ALPAKA_FN_HOST auto reads(
+                TViews const & ... views)
+            -> ReadSet
+            {
+                return ReadSet{std::vector<MemRange>{getMemRange(views)...}};
+            }
+            //-----------------------------------------------------------------------------
+            //! \return The set of memory ranges covered by the given views which are written by a task.
+            template<
+                typename... TViews>
+            ALPAKA_FN_HOST auto writes(
+                TViews const & ... views)
+            -> WriteSet
+            {
+                return WriteSet{std::vector<MemRange>{getMemRange(views)...}};
+            }
+
+            //#############################################################################
+            //! A task together with the memory it reads and writes.
+            //!
+            //! The QueueCpuConcurrent only orders such a task after the previously enqueued tasks it conflicts with.
+            template<
+                typename TTask>
+            class TaskWithAccesses final
+            {
+            public:
+                //-----------------------------------------------------------------------------
+                TaskWithAccesses(
+                    TTask const & task,
+                    ReadSet readSet,
+                    WriteSet writeSet) :
+                        m_task(task),
+                        m_readSet(std::move(readSet)),
+                        m_writeSet(std::move(writeSet))
+                {}
+
+            public:
+                TTask m_task;
+                ReadSet m_readSet;
+                WriteSet m_writeSet;
+            };
+
+            //-----------------------------------------------------------------------------
+            //! \return The task annotated with the memory it reads and writes.
+            template<
+                typename TTask>
+            ALPAKA_FN_HOST auto withAccesses(
+                TTask const & task,
+                ReadSet readSet,
+                WriteSet writeSet = WriteSet())
+            -> TaskWithAccesses<TTask>
+            {
+                return TaskWithAccesses<TTask>(task, std::move(readSet), std::move(writeSet));
+            }
+
+            namespace detail
+            {
+                //#############################################################################
+                //! The pool of workers of a QueueCpuConcurrent.
+                //! The workers of a queue wait for new tasks on a condition variable because the queue is usually idle between bursts of tasks.
+                using QueueCpuConcurrentWorkerPool = alpaka::core::detail::ConcurrentExecPool<
+                    std::size_t,
+                    std::thread,                // The concurrent execution type.
+                    std::promise,               // The promise type.
+                    void,                       // The type yielding the current concurrent execution.
+                    std::mutex,                 // The mutex type to use. Only required if TisYielding is true.
+                    std::condition_variable,    // The condition variable type to use. Only required if TisYielding is true.
+                    false>;                     // If the threads should yield.
+
+                //#############################################################################
+                //! A task enqueued into a QueueCpuConcurrent and its position within the dependency graph.
+                struct QueueCpuConcurrentNode
+                {
+                    //#############################################################################
+                    //! The kind of a node determines which other nodes it is ordered with.
+                    enum class Kind
+                    {
+                        Task,       //!< A task with known accesses. It is ordered after the conflicting earlier tasks.
+                        Barrier,    //!< A task with unknown accesses. It is ordered after all earlier nodes and all later nodes are ordered after it.
+                        Join,       //!< An event. It is ordered after all earlier nodes but later tasks can pass it.
+                        Gate        //!< A wait for an event. All later nodes are ordered after it but it does not wait for earlier nodes.
+                    };
+
+                    Kind m_kind;
+                    std::function<void()> m_task;       //!< The task to execute. Empty for gates.
+                    std::vector<MemRange> m_reads;
+                    std::vector<MemRange> m_writes;
+
+                    // The following members are protected by the mutex of the queue.
+                    std::size_t m_dependencyCount;                                      //!< The number of nodes (or events) this node still has to wait for.
+                    std::vector<std::shared_ptr<QueueCpuConcurrentNode>> m_successors;  //!< The nodes waiting for this node.
+
+                    //-----------------------------------------------------------------------------
+                    //! \return If the later node has to wait for this earlier node.
+                    auto isRequiredBy(
+                        QueueCpuConcurrentNode const & later) const
+                    -> bool
+                    {
+                        switch(later.m_kind)
+                        {
+                        case Kind::Gate:
+                            return false;
+                        case Kind::Barrier:
+                        case Kind::Join:
+                            return true;
+                        case Kind::Task:
+                            break;
+                        }
+                        switch(m_kind)
+                        {
+                        case Kind::Barrier:
+                        case Kind::Gate:
+                            return true;
+                        case Kind::Join:
+                            return false;
+                        case Kind::Task:
+                            break;
+                        }
+
+                        // Read after write, write after read and write after write conflict.
+                        auto const overlapsAny(
+                            [](std::vector<MemRange> const & ranges, std::vector<MemRange> const & otherRanges)
+                            {
+                                for(auto const & range : ranges)
+                                {
+                                    for(auto const & otherRange : otherRanges)
+                                    {
+                                        if(range.overlaps(otherRange))
+                                        {
+                                            return true;
+                                        }
+                                    }
+                                }
+                                return false;
+                            });
+                        return
+                            overlapsAny(m_writes, later.m_reads)
+                            || overlapsAny(m_writes, later.m_writes)
+                            || overlapsAny(m_reads, later.m_writes);
+                    }
+                };
+
+#if BOOST_COMP_CLANG
+    // avoid diagnostic warning: "has no out-of-line virtual method definitions; its vtable will be emitted in every translation unit [-Werror,-Wweak-vtables]"
+    // https://stackoverflow.com/a/29288300
+    #pragma clang diagnostic push
+    #pragma clang diagnostic ignored "-Wweak-vtables"
+#endif
+                //#############################################################################
+                //! The CPU device concurrent queue implementation.
+                //!
+                //! The enqueued tasks are nodes of a dependency graph which is inferred from the memory they access.
+                //! A node is handed to the worker pool as soon as all nodes it depends on have been completed.
+                //! Events and waits for events are nodes as well, so neither enqueuing nor waiting for an event blocks a worker.
+                class QueueCpuConcurrentImpl final : public cpu::ICpuQueue
+#if BOOST_COMP_CLANG
+    #pragma clang diagnostic pop
+#endif
+                {
+                    using Node = QueueCpuConcurrentNode;
+
+                public:
+                    //-----------------------------------------------------------------------------
+                    QueueCpuConcurrentImpl(
+                        dev::DevCpu const & dev,
+                        std::size_t const workerCount,
+                        core::threads::AffinityPolicy const & affinityPolicy) :
+                            m_dev(dev),
+                            m_affinityPolicy(affinityPolicy),
+                            m_workerCount(workerCount),
+                            m_workerAffinityPolicies(),
+                            m_mtx(),
+                            m_cvIdle(),
+                            m_activeNodes(),
+                            m_externalSubmitCount(0u),
+                            m_latch(),
+                            m_upWorkers()
+                    {
+                        // Each worker gets a disjoint slice of the CPUs of the policy for itself and the block threads of its kernels.
+                        // Otherwise the kernels executed concurrently would pin their block threads to the same first CPUs of the policy.
+                        // The slices only overlap if the policy has less CPUs than there are workers.
+                        std::size_t const sliceSize(
+                            std::max(
+                                m_affinityPolicy.getCpus().size() / std::max(workerCount, static_cast<std::size_t>(1u)),
+                                static_cast<std::size_t>(1u)));
+                        std::vector<std::uint32_t> workerCpus;
+                        for(std::size_t workerIdx(0u); workerIdx < workerCount; ++workerIdx)
+                        {
+                            m_workerAffinityPolicies.push_back(m_affinityPolicy.getSlice(workerIdx * sliceSize, sliceSize));
+                            auto const cpus(m_workerAffinityPolicies.back().getWorkerCpus(0u));
+                            workerCpus.insert(workerCpus.end(), cpus.begin(), cpus.end());
+                        }
+
+                        // The workers inherit the affinity of the thread creating them.
+                        core::threads::ScopedThreadAffinity const affinity(m_dev.m_spDevCpuImpl->getCpuSet());
+                        m_upWorkers.reset(new QueueCpuConcurrentWorkerPool(workerCount));
+                        // Worker i is pinned to the first CPU of its slice.
+                        if(!workerCpus.empty())
+                        {
+                            m_upWorkers->setAffinityPolicy(core::threads::AffinityPolicy::explicitCpus(workerCpus));
+                        }
+                    }
+                    //-----------------------------------------------------------------------------
+                    QueueCpuConcurrentImpl(QueueCpuConcurrentImpl const &) = delete;
+                    //-----------------------------------------------------------------------------
+                    QueueCpuConcurrentImpl(QueueCpuConcurrentImpl &&) = delete;
+                    //-----------------------------------------------------------------------------
+                    auto operator=(QueueCpuConcurrentImpl const &) -> QueueCpuConcurrentImpl & = delete;
+                    //-----------------------------------------------------------------------------
+                    auto operator=(QueueCpuConcurrentImpl &&) -> QueueCpuConcurrentImpl & = delete;
+                    //-----------------------------------------------------------------------------
+                    //! Waits for all enqueued tasks and all external submissions before the workers are joined.
+                    ~QueueCpuConcurrentImpl()
+                    {
+                        waitUntilIdle();
+                    }
+
+                    //-----------------------------------------------------------------------------
+                    void enqueue(event::EventCpu & ev) final
+                    {
+                        auto spEventImpl(ev.m_spEventImpl);
+                        auto const enqueueCount(spEventImpl->enqueue());
+
+                        enqueueNode(
+                            Node::Kind::Join,
+                            [spEventImpl, enqueueCount]()
+                            {
+                                spEventImpl->setReady(enqueueCount);
+                            });
+                    }
+
+                    //-----------------------------------------------------------------------------
+                    void wait(event::EventCpu const & ev) final
+                    {
+                        auto spEventImpl(ev.m_spEventImpl);
+                        auto const enqueueCount(spEventImpl->getEnqueueCount());
+
+                        if(spEventImpl->isReady(enqueueCount))
+                        {
+                            return;
+                        }
+
+                        // The gate has an additional dependency which is released by the queue completing the event.
+                        // It does not execute anything itself.
+                        auto const spGate(
+                            enqueueNode(
+                                Node::Kind::Gate,
+                                std::function<void()>(),
+                                std::vector<MemRange>(),
+                                std::vector<MemRange>(),
+                                1u));
+                        auto const release(
+                            [this, spGate]()
+                            {
+                                releaseDependency(spGate);
+                            });
+                        if(!spEventImpl->addContinuation(enqueueCount, release))
+                        {
+                            release();
+                        }
+                    }
+
+                    //-----------------------------------------------------------------------------
+                    //! Adds a node to the dependency graph and hands it to the workers if it does not depend on any active node.
+                    //!
+                    //! \param externalDependencyCount The number of dependencies in addition to the earlier nodes which are released by releaseDependency.
+                    //! \return The node.
+                    auto enqueueNode(
+                        Node::Kind const kind,
+                        std::function<void()> task,
+                        std::vector<MemRange> reads = std::vector<MemRange>(),
+                        std::vector<MemRange> writes = std::vector<MemRange>(),
+                        std::size_t const externalDependencyCount = 0u)
+                    -> std::shared_ptr<Node>
+                    {
+                        auto spNode(std::make_shared<Node>());
+                        spNode->m_kind = kind;
+                        spNode->m_task = std::move(task);
+                        spNode->m_reads = std::move(reads);
+                        spNode->m_writes = std::move(writes);
+                        spNode->m_dependencyCount = externalDependencyCount;
+
+                        bool bReady(false);
+                        {
+                            std::lock_guard<std::mutex> lk(m_mtx);
+
+                            // Scan the active nodes from the latest to the earliest.
+                            // A barrier itself waits for all earlier nodes, so the scan can stop there.
+                            if(kind != Node::Kind::Gate)
+                            {
+                                for(auto it(m_activeNodes.rbegin()); it != m_activeNodes.rend(); ++it)
+                                {
+                                    auto & activeNode(**it);
+                                    if(activeNode.isRequiredBy(*spNode))
+                                    {
+                                        activeNode.m_successors.push_back(spNode);
+                                        ++spNode->m_dependencyCount;
+                                    }
+                                    if(activeNode.m_kind == Node::Kind::Barrier)
+                                    {
+                                        break;
+                                    }
+                                }
+                            }
+
+                            m_activeNodes.push_back(spNode);
+                            // As soon as the lock is released, the dependency count may be changed by other threads.
+                            bReady = (spNode->m_dependencyCount == 0u);
+                        }
+
+                        if(bReady)
+                        {
+                            submit(spNode);
+                        }
+
+                        return spNode;
+                    }
+
+                    //-----------------------------------------------------------------------------
+                    //! \return If there are no active nodes.
+                    auto isIdle() const
+                    -> bool
+                    {
+                        std::lock_guard<std::mutex> lk(m_mtx);
+                        return m_activeNodes.empty();
+                    }
+
+                    //-----------------------------------------------------------------------------
+                    //! Blocks the calling thread until all active nodes have been completed and no external thread submits a node anymore.
+                    //! This includes the nodes enqueued concurrently by other threads while waiting.
+                    auto waitUntilIdle()
+                    -> void
+                    {
+                        std::unique_lock<std::mutex> lk(m_mtx);
+                        m_cvIdle.wait(
+                            lk,
+                            [this]()
+                            {
+                                return m_activeNodes.empty() && (m_externalSubmitCount == 0u);
+                            });
+                    }
+
+                private:
+                    //-----------------------------------------------------------------------------
+                    //! Hands the node to the workers.
+                    auto submit(
+                        std::shared_ptr<Node> const & spNode)
+                    -> void
+                    {
+                        m_upWorkers->enqueueTaskWithLatch(
+                            m_latch,
+                            [this, spNode]()
+                            {
+                                try
+                                {
+                                    // Gates do not have a task.
+                                    if(spNode->m_task)
+                                    {
+                                        core::threads::ScopedAffinityPolicy const affinityPolicy(
+                                            m_workerAffinityPolicies[alpaka::core::detail::currentConcurrentExecIdx()]);
+                                        // Kernels executed concurrently by the workers share the hardware threads.
+                                        core::threads::ScopedConcurrentWorkerCount const workerCount(m_workerCount);
+                                        spNode->m_task();
+                                    }
+                                }
+                                catch(...)
+                                {
+                                    // Like the tasks of the other CPU queues, exceptions are not propagated to the enqueuing thread.
+                                }
+                                complete(spNode);
+                            });
+                    }
+                    //-----------------------------------------------------------------------------
+                    //! Removes the node from the graph and submits the successors which do not have to wait anymore.
+                    auto complete(
+                        std::shared_ptr<Node> const & spNode)
+                    -> void
+                    {
+                        std::vector<std::shared_ptr<Node>> readyNodes;
+                        {
+                            std::lock_guard<std::mutex> lk(m_mtx);
+
+                            m_activeNodes.erase(std::find(m_activeNodes.begin(), m_activeNodes.end(), spNode));
+                            for(auto const & spSuccessor : spNode->m_successors)
+                            {
+                                if(--spSuccessor->m_dependencyCount == 0u)
+                                {
+                                    readyNodes.push_back(spSuccessor);
+                                }
+                            }
+                            spNode->m_successors.clear();
+
+                            // After the notification the queue may be destroyed. If there are no active nodes, there are no ready nodes either.
+                            // The workers are joined by the destructor, so they may still leave the pool afterwards.
+                            if(m_activeNodes.empty() && (m_externalSubmitCount == 0u))
+                            {
+                                m_cvIdle.notify_all();
+                            }
+                        }
+
+                        for(auto const & spReadyNode : readyNodes)
+                        {
+                            submit(spReadyNode);
+                        }
+                    }
+                    //-----------------------------------------------------------------------------
+                    //! Releases an external dependency of the node.
+                    //!
+                    //! This is called by the thread completing the event, which is not joined by the destructor.
+                    //! The node can be completed by a worker before submit returns, so the submission is counted to keep the queue alive until the thread has left the pool.
+                    auto releaseDependency(
+                        std::shared_ptr<Node> const & spNode)
+                    -> void
+                    {
+                        bool bReady(false);
+                        {
+                            std::lock_guard<std::mutex> lk(m_mtx);
+                            bReady = (--spNode->m_dependencyCount == 0u);
+                            if(bReady)
+                            {
+                                ++m_externalSubmitCount;
+                            }
+                        }
+                        if(bReady)
+                        {
+                            submit(spNode);
+
+                            std::lock_guard<std::mutex> lk(m_mtx);
+                            --m_externalSubmitCount;
+                            if(m_activeNodes.empty() && (m_externalSubmitCount == 0u))
+                            {
+                                m_cvIdle.notify_all();
+                            }
+                        }
+                    }
+
+                public:
+                    dev::DevCpu const m_dev;            //!< The device this queue is bound to.
+                    core::threads::AffinityPolicy const m_affinityPolicy;   //!< The affinity policy divided between the workers and the kernels they execute.
+                    std::size_t const m_workerCount;    //!< The number of workers executing tasks concurrently.
+                    std::vector<core::threads::AffinityPolicy> m_workerAffinityPolicies;    //!< The slice of the affinity policy used by each worker.
+
+                private:
+                    std::mutex mutable m_mtx;
+                    std::condition_variable m_cvIdle;
+                    std::vector<std::shared_ptr<Node>> m_activeNodes;   //!< The nodes which have not been completed in the order they have been enqueued.
+                    std::size_t m_externalSubmitCount;                  //!< The number of nodes currently submitted by threads completing an event.
+
+                    // The latch has to outlive the workers which count it down.
+                    alpaka::core::detail::TaskLatch<std::mutex, std::condition_variable> m_latch;
+                    std::unique_ptr<QueueCpuConcurrentWorkerPool> m_upWorkers;
+                };
+            }
+        }
+
+        //#############################################################################
+        //! The CPU device concurrent queue.
+        //!
+        //! The tasks are executed by multiple workers. Only tasks which conflict are executed in the order they have been enqueued.
+        //! Tasks annotated via cpu::withAccesses conflict if one of them writes memory the other one reads or writes.
+        //! All other tasks conflict with every task, so without annotations the queue behaves like an in-order queue.
+        //! Enqueuing an event does not stop later tasks, but the event is only completed after all earlier tasks.
+        //! Waiting for an event stops all later tasks until the event is completed without blocking a worker.
+        class QueueCpuConcurrent final
+        {
+        public:
+            //-----------------------------------------------------------------------------
+            //! \param workerCount The number of tasks which can be executed concurrently. By default the number of hardware threads.
+            //! The kernels executed by the workers divide the hardware threads between them.
+            QueueCpuConcurrent(
+                dev::DevCpu const & dev,
+                std::size_t const workerCount = std::max(std::thread::hardware_concurrency(), 1u)) :
+                    QueueCpuConcurrent(dev, workerCount, dev::cpu::getAffinityPolicy(dev))
+            {}
+            //-----------------------------------------------------------------------------
+            //! Creates a queue using the given affinity policy instead of the one of the device.
+            QueueCpuConcurrent(
+                dev::DevCpu const & dev,
+                std::size_t const workerCount,
+                core::threads::AffinityPolicy const & affinityPolicy) :
+                    m_spQueueImpl(std::make_shared<cpu::detail::QueueCpuConcurrentImpl>(dev, workerCount, affinityPolicy))
+            {
+                dev.m_spDevCpuImpl->RegisterQueue(m_spQueueImpl);
+            }
+            //-----------------------------------------------------------------------------
+            QueueCpuConcurrent(QueueCpuConcurrent const &) = default;
+            //-----------------------------------------------------------------------------
+            QueueCpuConcurrent(QueueCpuConcurrent &&) = default;
+            //-----------------------------------------------------------------------------
+            auto operator=(QueueCpuConcurrent const &) -> QueueCpuConcurrent & = default;
+            //-----------------------------------------------------------------------------
+            auto operator=(QueueCpuConcurrent &&) -> QueueCpuConcurrent & = default;
+            //-----------------------------------------------------------------------------
+            auto operator==(QueueCpuConcurrent const & rhs) const
+            -> bool
+            {
+                return (m_spQueueImpl == rhs.m_spQueueImpl);
+            }
+            //-----------------------------------------------------------------------------
+            auto operator!=(QueueCpuConcurrent const & rhs) const
+            -> bool
+            {
+                return !((*this) == rhs);
+            }
+            //-----------------------------------------------------------------------------
+            ~QueueCpuConcurrent() = default;
+
+        public:
+            std::shared_ptr<cpu::detail::QueueCpuConcurrentImpl> m_spQueueImpl;
+        };
+
+        namespace cpu
+        {
+            //-----------------------------------------------------------------------------
+            //! \return The affinity policy of the queue.
+            ALPAKA_FN_HOST inline auto getAffinityPolicy(
+                QueueCpuConcurrent const & queue)
+            -> core::threads::AffinityPolicy const &
+            {
+                return queue.m_spQueueImpl->m_affinityPolicy;
+            }
+        }
+    }
+
+    namespace dev
+    {
+        namespace traits
+        {
+            //#############################################################################
+            //! The CPU concurrent device queue device type trait specialization.
+            template<>
+            struct DevType<
+                queue::QueueCpuConcurrent>
+            {
+                using type = dev::DevCpu;
+            };
+            //#############################################################################
+            //! The CPU concurrent device queue device get trait specialization.
+            template<>
+            struct GetDev<
+                queue::QueueCpuConcurrent>
+            {
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST static auto getDev(
+                    queue::QueueCpuConcurrent const & queue)
+                -> dev::DevCpu
+                {
+                    return queue.m_spQueueImpl->m_dev;
+                }
+            };
+        }
+    }
+    namespace event
+    {
+        namespace traits
+        {
+            //#############################################################################
+            //! The CPU concurrent device queue event type trait specialization.
+            template<>
+            struct EventType<
+                queue::QueueCpuConcurrent>
+            {
+                using type = event::EventCpu;
+            };
+        }
+    }
+    namespace queue
+    {
+        namespace traits
+        {
+            //#############################################################################
+            //! The CPU concurrent device queue enqueue trait specialization.
+            //! This default implementation for all tasks orders the task after all earlier tasks and all later tasks after it.
+            template<
+                typename TTask>
+            struct Enqueue<
+                queue::QueueCpuConcurrent,
+                TTask>
+            {
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST static auto enqueue(
+                    queue::QueueCpuConcurrent & queue,
+                    TTask const & task)
+                -> void
+                {
+                    queue.m_spQueueImpl->enqueueNode(
+                        queue::cpu::detail::QueueCpuConcurrentNode::Kind::Barrier,
+                        task);
+                }
+            };
+            //#############################################################################
+            //! The CPU concurrent device queue enqueue trait specialization for tasks with known accesses.
+            template<
+                typename TTask>
+            struct Enqueue<
+                queue::QueueCpuConcurrent,
+                queue::cpu::TaskWithAccesses<TTask>>
+            {
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST static auto enqueue(
+                    queue::QueueCpuConcurrent & queue,
+                    queue::cpu::TaskWithAccesses<TTask> const & task)
+                -> void
+                {
+                    queue.m_spQueueImpl->enqueueNode(
+                        queue::cpu::detail::QueueCpuConcurrentNode::Kind::Task,
+                        task.m_task,
+                        task.m_readSet.m_ranges,
+                        task.m_writeSet.m_ranges);
+                }
+            };
+            //#############################################################################
+            //! The CPU concurrent device queue event enqueue trait specialization.
+            template<>
+            struct Enqueue<
+                queue::QueueCpuConcurrent,
+                event::EventCpu>
+            {
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST static auto enqueue(
+                    queue::QueueCpuConcurrent & queue,
+                    event::EventCpu & event)
+                -> void
+                {
+                    ALPAKA_DEBUG_MINIMAL_LOG_SCOPE;
+
+                    queue.m_spQueueImpl->enqueue(event);
+                }
+            };
+            //#############################################################################
+            //! The CPU concurrent device queue host function enqueue trait specialization.
+            //!
+            //! The host function has unknown accesses, so it is ordered like a task without annotations.
+            template<>
+            struct EnqueueHostFn<
+                queue::QueueCpuConcurrent>
+            {
+                //-----------------------------------------------------------------------------
+                template<
+                    typename TFn,
+                    typename... TArgs>
+                ALPAKA_FN_HOST static auto enqueueHostFn(
+                    queue::QueueCpuConcurrent & queue,
+                    TFn && fn,
+                    TArgs && ... args)
+                -> void
+                {
+                    // The nodes store copyable functions, so the move-only host function task is shared with the node.
+                    using Task = cpu::detail::HostFnTask<
+                        typename std::decay<TFn>::type,
+                        typename std::decay<TArgs>::type...>;
+                    auto spTask(
+                        std::make_shared<Task>(
+                            cpu::detail::makeHostFnTask(
+                                std::forward<TFn>(fn),
+                                std::forward<TArgs>(args)...)));
+
+                    queue.m_spQueueImpl->enqueueNode(
+                        queue::cpu::detail::QueueCpuConcurrentNode::Kind::Barrier,
+                        [spTask]()
+                        {
+                            (*spTask)();
+                        });
+                }
+            };
+            //#############################################################################
+            //! The CPU concurrent device queue test trait specialization.
+            template<>
+            struct Empty<
+                queue::QueueCpuConcurrent>
+            {
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST static auto empty(
+                    queue::QueueCpuConcurrent const & queue)
+                -> bool
+                {
+                    return queue.m_spQueueImpl->isIdle();
+                }
+            };
+        }
+    }
+    namespace wait
+    {
+        namespace traits
+        {
+            //#############################################################################
+            //! The CPU concurrent device queue thread wait trait specialization.
+            //!
+            //! Blocks execution of the calling thread until the queue has finished processing all previously requested tasks (kernels, data copies, ...)
+            template<>
+            struct CurrentThreadWaitFor<
+                queue::QueueCpuConcurrent>
+            {
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST static auto currentThreadWaitFor(
+                    queue::QueueCpuConcurrent const & queue)
+                -> void
+                {
+                    queue.m_spQueueImpl->waitUntilIdle();
+                }
+            };
+            //#############################################################################
+            //! The CPU concurrent device queue event wait trait specialization.
+            template<>
+            struct WaiterWaitFor<
+                queue::QueueCpuConcurrent,
+                event::EventCpu>
+            {
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST static auto waiterWaitFor(
+                    queue::QueueCpuConcurrent & queue,
+                    event::EventCpu const & event)
+                -> void
+                {
+                    queue.m_spQueueImpl->wait(event);
+                }
+            };
+        }
+    }
+}
@@ -10,19 +10,30 @@
 #pragma once
 
 #include <alpaka/dev/DevCpu.hpp>
+#include <alpaka/graph/GraphCpu.hpp>
+#include <alpaka/queue/cpu/HostFnTask.hpp>
 #include <alpaka/queue/cpu/ICpuQueue.hpp>
+#include <alpaka/queue/cpu/TaskRing.hpp>
 
 #include <alpaka/dev/Traits.hpp>
 #include <alpaka/event/Traits.hpp>
+#include <alpaka/graph/Traits.hpp>
 #include <alpaka/queue/Traits.hpp>
 #include <alpaka/wait/Traits.hpp>
 
-#include <alpaka/core/ConcurrentExecPool.hpp>
+#include <alpaka/core/ThreadAffinity.hpp>
+#include <alpaka/core/Unused.hpp>
+#include <alpaka/meta/IntegerSequence.hpp>
 
-#include <type_traits>
-#include <thread>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <mutex>
-#include <future>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace alpaka
 {
@@ -48,28 +59,36 @@ namespace alpaka
 #endif
                 //#############################################################################
                 //! The CPU device queue implementation.
+                //!
+                //! The tasks are executed in order by the single worker thread of a lock-free task ring.
+                //! The worker is pinned according to the affinity policy of the queue.
+                //! If the policy is inherited and the device is bound to a NUMA node, the worker is restricted to the CPUs of the node.
                 class QueueCpuNonBlockingImpl final : public cpu::ICpuQueue
 #if BOOST_COMP_CLANG
     #pragma clang diagnostic pop
 #endif
                 {
-                private:
-                    //#############################################################################
-                    using ThreadPool = alpaka::core::detail::ConcurrentExecPool<
-                        std::size_t,
-                        std::thread,                // The concurrent execution type.
-                        std::promise,               // The promise type.
-                        void,                       // The type yielding the current concurrent execution.
-                        std::mutex,                 // The mutex type to use. Only required if TisYielding is true.
-                        std::condition_variable,    // The condition variable type to use. Only required if TisYielding is true.
-                        false>;                     // If the threads should yield.
-
                 public:
                     //-----------------------------------------------------------------------------
                     QueueCpuNonBlockingImpl(
-                        dev::DevCpu const & dev) :
+                        dev::DevCpu const & dev,
+                        core::threads::AffinityPolicy const & affinityPolicy) :
                             m_dev(dev),
-                            m_workerThread(1u)
+                            m_affinityPolicy(affinityPolicy),
+                            m_taskRing(
+                                1024u,
+                                [this]()
+                                {
+                                    auto const workerCpus(dev::cpu::detail::getQueueWorkerCpus(m_dev, m_affinityPolicy));
+                                    if(!workerCpus.empty())
+                                    {
+                                        core::threads::setCurrentThreadAffinity(workerCpus);
+                                    }
+                                    // The worker executes the tasks of this queue only, so the policy is set for its whole lifetime.
+                                    core::threads::detail::currentAffinityPolicy() = &m_affinityPolicy;
+                                }),
+                            m_mutex(),
+                            m_spCapturedGraph()
                     {}
                     //-----------------------------------------------------------------------------
                     QueueCpuNonBlockingImpl(QueueCpuNonBlockingImpl const &) = delete;
@@ -94,8 +113,39 @@ namespace alpaka
 
                 public:
                     dev::DevCpu const m_dev;            //!< The device this queue is bound to.
+                    core::threads::AffinityPolicy const m_affinityPolicy;   //!< The affinity policy of the worker and the kernels it executes.
 
-                    ThreadPool m_workerThread;
+                    TaskRing m_taskRing;                //!< The tasks enqueued into this queue.
+
+                    std::mutex mutable m_mutex;         //!< Guards the capture state. The task ring itself is lock-free.
+                    std::shared_ptr<graph::cpu::detail::GraphCpuImpl> m_spCapturedGraph;    //!< The graph the enqueued tasks are recorded into while capturing, nullptr else.
+                };
+
+                //#############################################################################
+                //! The trait converting a task into the function object that is executed by the task ring of the queue.
+                //!
+                //! This default implementation for all tasks copies the task and directly invokes its function call operator.
+                template<
+                    typename TTask,
+                    typename TSfinae = void>
+                struct MakeTaskRingFnObj
+                {
+                    using type = TTask;
+
+                    //-----------------------------------------------------------------------------
+                    ALPAKA_FN_HOST static auto makeTaskRingFnObj(
+                        QueueCpuNonBlockingImpl &,
+                        TTask const & task)
+                    -> type
+                    {
+                        return task;
+                    }
+                    //-----------------------------------------------------------------------------
+                    //! Reverts the side effects of makeTaskRingFnObj if the function object could not be passed to the task ring.
+                    ALPAKA_FN_HOST static auto cancelTaskRingFnObj(
+                        type &) noexcept
+                    -> void
+                    {}
                 };
             }
         }
@@ -108,7 +158,14 @@ namespace alpaka
             //-----------------------------------------------------------------------------
             QueueCpuNonBlocking(
                 dev::DevCpu const & dev) :
-                    m_spQueueImpl(std::make_shared<cpu::detail::QueueCpuNonBlockingImpl>(dev))
+                    QueueCpuNonBlocking(dev, dev::cpu::getAffinityPolicy(dev))
+            {}
+            //-----------------------------------------------------------------------------
+            //! Creates a queue using the given affinity policy instead of the one of the device.
+            QueueCpuNonBlocking(
+                dev::DevCpu const & dev,
+                core::threads::AffinityPolicy const & affinityPolicy) :
+                    m_spQueueImpl(std::make_shared<cpu::detail::QueueCpuNonBlockingImpl>(dev, affinityPolicy))
             {
                 dev.m_spDevCpuImpl->RegisterQueue(m_spQueueImpl);
             }
@@ -138,6 +195,26 @@ namespace alpaka
         public:
             std::shared_ptr<cpu::detail::QueueCpuNonBlockingImpl> m_spQueueImpl;
         };
+
+        namespace cpu
+        {
+            //-----------------------------------------------------------------------------
+            //! \return The affinity policy of the queue.
+            ALPAKA_FN_HOST inline auto getAffinityPolicy(
+                QueueCpuNonBlocking const & queue)
+            -> core::threads::AffinityPolicy const &
+            {
+                return queue.m_spQueueImpl->m_affinityPolicy;
+            }
+            //-----------------------------------------------------------------------------
+            //! \return The logical CPUs the worker of the queue is currently allowed to run on.
+            ALPAKA_FN_HOST inline auto getWorkerAffinity(
+                QueueCpuNonBlocking const & queue)
+            -> std::vector<std::uint32_t>
+            {
+                return queue.m_spQueueImpl->m_taskRing.getWorkerAffinity();
+            }
+        }
     }
 
     namespace dev
@@ -208,8 +285,165 @@ namespace alpaka
                 {
 // Workaround: Clang can not support this when natively compiling device code. See ConcurrentExecPool.hpp.
 #if !(BOOST_COMP_CLANG_CUDA && BOOST_ARCH_PTX)
-                    queue.m_spQueueImpl->m_workerThread.enqueueTask(
+                    auto & queueImpl(*queue.m_spQueueImpl);
+                    {
+                        std::lock_guard<std::mutex> lk(queueImpl.m_mutex);
+
+                        if(queueImpl.m_spCapturedGraph)
+                        {
+                            queueImpl.m_spCapturedGraph->record(
+                                task);
+                            return;
+                        }
+                    }
+
+                    queueImpl.m_taskRing.enqueue(
                         task);
+#endif
+                }
+            };
+            //#############################################################################
+            //! The CPU non-blocking device queue batch enqueue trait specialization.
+            //!
+            //! All tasks are published to the task ring at once and the worker is woken up only once.
+            template<>
+            struct EnqueueBatch<
+                queue::QueueCpuNonBlocking>
+            {
+                //-----------------------------------------------------------------------------
+                template<
+                    typename... TTasks>
+                ALPAKA_FN_HOST static auto enqueueBatch(
+#if !(BOOST_COMP_CLANG_CUDA && BOOST_ARCH_PTX)
+                    queue::QueueCpuNonBlocking & queue,
+                    TTasks && ... tasks)
+#else
+                    queue::QueueCpuNonBlocking &,
+                    TTasks && ...)
+#endif
+                -> void
+                {
+// Workaround: Clang can not support this when natively compiling device code. See ConcurrentExecPool.hpp.
+#if !(BOOST_COMP_CLANG_CUDA && BOOST_ARCH_PTX)
+                    auto & queueImpl(*queue.m_spQueueImpl);
+
+                    bool bCapturing(false);
+                    {
+                        std::lock_guard<std::mutex> lk(queueImpl.m_mutex);
+                        bCapturing = static_cast<bool>(queueImpl.m_spCapturedGraph);
+                    }
+
+                    if(bCapturing)
+                    {
+                        // Each task is recorded on its own. The lock is not held because the single enqueue locks it itself.
+                        int const dummy[] = {0, (queue::enqueue(queue, std::forward<TTasks>(tasks)), 0)...};
+                        alpaka::ignore_unused(dummy);
+                        return;
+                    }
+
+                    // The braced initializer list guarantees that the tasks are converted from left to right.
+                    // This is required for the bookkeeping of events which are contained multiple times.
+                    std::tuple<
+                        typename cpu::detail::MakeTaskRingFnObj<typename std::decay<TTasks>::type>::type...> fnObjs{
+                            cpu::detail::MakeTaskRingFnObj<typename std::decay<TTasks>::type>::makeTaskRingFnObj(queueImpl, tasks)...};
+
+                    try
+                    {
+                        enqueueFnObjs(
+                            queueImpl.m_taskRing,
+                            fnObjs,
+                            meta::IndexSequenceFor<TTasks...>());
+                    }
+                    catch(...)
+                    {
+                        // The function objects which have not been stored by the task ring are cancelled from the last to the first,
+                        // so that an event contained multiple times gets back the enqueue count it had before the batch.
+                        cancelFnObjs<0u, typename std::decay<TTasks>::type...>(fnObjs);
+                        throw;
+                    }
+#endif
+                }
+
+            private:
+                //-----------------------------------------------------------------------------
+                template<
+                    typename TFnObjs,
+                    std::size_t... TIndices>
+                ALPAKA_FN_HOST static auto enqueueFnObjs(
+                    cpu::detail::TaskRing & taskRing,
+                    TFnObjs & fnObjs,
+                    meta::IndexSequence<TIndices...> const &)
+                -> void
+                {
+                    // If the batch is empty, fnObjs will not be used at all.
+                    alpaka::ignore_unused(fnObjs);
+
+                    taskRing.enqueueBatch(
+                        std::move(std::get<TIndices>(fnObjs))...);
+                }
+                //-----------------------------------------------------------------------------
+                template<
+                    std::size_t TIdx,
+                    typename TFnObjs>
+                ALPAKA_FN_HOST static auto cancelFnObjs(
+                    TFnObjs &) noexcept
+                -> void
+                {}
+                //-----------------------------------------------------------------------------
+                template<
+                    std::size_t TIdx,
+                    typename TTask,
+                    typename... TTasks,
+                    typename TFnObjs>
+                ALPAKA_FN_HOST static auto cancelFnObjs(
+                    TFnObjs & fnObjs) noexcept
+                -> void
+                {
+                    cancelFnObjs<TIdx + 1u, TTasks...>(fnObjs);
+                    cpu::detail::MakeTaskRingFnObj<TTask>::cancelTaskRingFnObj(std::get<TIdx>(fnObjs));
+                }
+            };
+            //#############################################################################
+            //! The CPU non-blocking device queue host function enqueue trait specialization.
+            //!
+            //! The function and its arguments are moved into the task ring and are executed inline by the queue worker.
+            template<>
+            struct EnqueueHostFn<
+                queue::QueueCpuNonBlocking>
+            {
+                //-----------------------------------------------------------------------------
+                template<
+                    typename TFn,
+                    typename... TArgs>
+                ALPAKA_FN_HOST static auto enqueueHostFn(
+#if !(BOOST_COMP_CLANG_CUDA && BOOST_ARCH_PTX)
+                    queue::QueueCpuNonBlocking & queue,
+                    TFn && fn,
+                    TArgs && ... args)
+#else
+                    queue::QueueCpuNonBlocking &,
+                    TFn &&,
+                    TArgs && ...)
+#endif
+                -> void
+                {
+// Workaround: Clang can not support this when natively compiling device code. See ConcurrentExecPool.hpp.
+#if !(BOOST_COMP_CLANG_CUDA && BOOST_ARCH_PTX)
+                    auto & queueImpl(*queue.m_spQueueImpl);
+                    {
+                        std::lock_guard<std::mutex> lk(queueImpl.m_mutex);
+
+                        if(queueImpl.m_spCapturedGraph)
+                        {
+                            // The arguments are moved into the function, so the task can not be launched repeatedly.
+                            throw std::runtime_error("Host functions can not be recorded into a graph!");
+                        }
+                    }
+
+                    queueImpl.m_taskRing.enqueue(
+                        cpu::detail::makeHostFnTask(
+                            std::forward<TFn>(fn),
+                            std::forward<TArgs>(args)...));
 #endif
                 }
             };
@@ -224,7 +458,76 @@ namespace alpaka
                     queue::QueueCpuNonBlocking const & queue)
                 -> bool
                 {
-                    return queue.m_spQueueImpl->m_workerThread.isIdle();
+                    return queue.m_spQueueImpl->m_taskRing.isIdle();
+                }
+            };
+        }
+    }
+    namespace graph
+    {
+        namespace traits
+        {
+            //#############################################################################
+            //! The CPU non-blocking device queue graph type trait specialization.
+            template<>
+            struct GraphType<
+                queue::QueueCpuNonBlocking>
+            {
+                using type = graph::GraphCpu;
+            };
+            //#############################################################################
+            //! The CPU non-blocking device queue graph capture begin trait specialization.
+            template<>
+            struct BeginCapture<
+                queue::QueueCpuNonBlocking>
+            {
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST static auto beginCapture(
+                    queue::QueueCpuNonBlocking & queue)
+                -> void
+                {
+                    std::lock_guard<std::mutex> lk(queue.m_spQueueImpl->m_mutex);
+
+                    graph::cpu::detail::beginCapture(queue.m_spQueueImpl->m_spCapturedGraph);
+                }
+            };
+            //#############################################################################
+            //! The CPU non-blocking device queue graph capture end trait specialization.
+            template<>
+            struct EndCapture<
+                queue::QueueCpuNonBlocking>
+            {
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST static auto endCapture(
+                    queue::QueueCpuNonBlocking & queue)
+                -> graph::GraphCpu
+                {
+                    std::lock_guard<std::mutex> lk(queue.m_spQueueImpl->m_mutex);
+
+                    return graph::cpu::detail::endCapture(queue.m_spQueueImpl->m_spCapturedGraph);
+                }
+            };
+        }
+    }
+    namespace wait
+    {
+        namespace traits
+        {
+            //#############################################################################
+            //! The CPU non-blocking device queue thread wait trait specialization.
+            //!
+            //! Blocks execution of the calling thread until the queue has finished processing all previously requested tasks (kernels, data copies, ...)
+            template<>
+            struct CurrentThreadWaitFor<
+                queue::QueueCpuNonBlocking>
+            {
+                //-----------------------------------------------------------------------------
+                ALPAKA_FN_HOST static auto currentThreadWaitFor(
+                    queue::QueueCpuNonBlocking const & queue)
+                -> void
+                {
+                    auto & taskRing(queue.m_spQueueImpl->m_taskRing);
+                    taskRing.waitFor(taskRing.getEnqueueCount());
                 }
             };
         }
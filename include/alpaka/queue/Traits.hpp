@@ -12,6 +12,7 @@
 #include <alpaka/wait/Traits.hpp>
 
 #include <alpaka/core/Common.hpp>
+#include <alpaka/core/Unused.hpp>
 
 #include <type_traits>
 #include <utility>
@@ -34,6 +35,36 @@ namespace alpaka
                 typename TSfinae = void>
             struct Enqueue;
 
+            //#############################################################################
+            //! The queue batch enqueue trait.
+            //!
+            //! This default implementation enqueues the tasks one after the other.
+            template<
+                typename TQueue,
+                typename TSfinae = void>
+            struct EnqueueBatch
+            {
+                //-----------------------------------------------------------------------------
+                template<
+                    typename... TTasks>
+                ALPAKA_FN_HOST static auto enqueueBatch(
+                    TQueue & queue,
+                    TTasks && ... tasks)
+                -> void
+                {
+                    // The braced initializer list guarantees the evaluation from left to right.
+                    int const dummy[] = {0, (Enqueue<TQueue, typename std::decay<TTasks>::type>::enqueue(queue, std::forward<TTasks>(tasks)), 0)...};
+                    alpaka::ignore_unused(dummy);
+                }
+            };
+
+            //#############################################################################
+            //! The queue host function enqueue trait.
+            template<
+                typename TQueue,
+                typename TSfinae = void>
+            struct EnqueueHostFn;
+
             //#############################################################################
             //! The queue empty trait.
             template<
@@ -64,6 +95,50 @@ namespace alpaka
                 std::forward<TTask>(task));
         }
 
+        //-----------------------------------------------------------------------------
+        //! Queues the given tasks in the given order into the given queue.
+        //!
+        //! This has the same effect as calling enqueue for each of the tasks but queues may publish the whole batch at once.
+        //! Pipelines enqueuing multiple dependent kernels, copies and events per step then pay the synchronization with the queue worker only once.
+        template<
+            typename TQueue,
+            typename... TTasks>
+        ALPAKA_FN_HOST auto enqueueBatch(
+            TQueue & queue,
+            TTasks && ... tasks)
+        -> void
+        {
+            traits::EnqueueBatch<
+                TQueue>
+            ::enqueueBatch(
+                queue,
+                std::forward<TTasks>(tasks)...);
+        }
+
+        //-----------------------------------------------------------------------------
+        //! Queues a call of the given host function with the given arguments in the given queue.
+        //!
+        //! The function and the arguments are moved into the queue without being copied and are passed as rvalues to the function like with std::thread.
+        //! Therefore move-only functions and arguments (e.g. buffers owned by a std::unique_ptr) are supported.
+        //! The function is executed by the host thread processing the queue in order with the other tasks.
+        template<
+            typename TQueue,
+            typename TFn,
+            typename... TArgs>
+        ALPAKA_FN_HOST auto enqueueHostFn(
+            TQueue & queue,
+            TFn && fn,
+            TArgs && ... args)
+        -> void
+        {
+            traits::EnqueueHostFn<
+                TQueue>
+            ::enqueueHostFn(
+                queue,
+                std::forward<TFn>(fn),
+                std::forward<TArgs>(args)...);
+        }
+
         //-----------------------------------------------------------------------------
         //! Tests if the queue is empty (all ops in the given queue have been completed).
         template<
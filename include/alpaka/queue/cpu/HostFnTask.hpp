@@ -0,0 +1,93 @@
+/* Copyright 2019 Benjamin Worpitz
+ *
+ * This file is part of Alpaka.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <alpaka/core/Common.hpp>
+#include <alpaka/meta/ApplyTuple.hpp>
+
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace alpaka
+{
+    namespace queue
+    {
+        namespace cpu
+        {
+            namespace detail
+            {
+                //#############################################################################
+                //! A host function together with its arguments.
+                //!
+                //! The function and the arguments are moved in and are passed as rvalues on invocation like with std::thread.
+                //! Therefore move-only functions and arguments are supported but the task can only be executed once.
+                template<
+                    typename TFn,
+                    typename... TArgs>
+                class HostFnTask final
+                {
+                public:
+                    //-----------------------------------------------------------------------------
+                    HostFnTask(
+                        TFn && fn,
+                        std::tuple<TArgs...> && args) :
+                            m_fn(std::move(fn)),
+                            m_args(std::move(args))
+                    {}
+                    //-----------------------------------------------------------------------------
+                    HostFnTask(HostFnTask const &) = delete;
+                    //-----------------------------------------------------------------------------
+                    HostFnTask(HostFnTask &&) = default;
+                    //-----------------------------------------------------------------------------
+                    auto operator=(HostFnTask const &) -> HostFnTask & = delete;
+                    //-----------------------------------------------------------------------------
+                    auto operator=(HostFnTask &&) -> HostFnTask & = default;
+                    //-----------------------------------------------------------------------------
+                    ~HostFnTask() = default;
+
+                    //-----------------------------------------------------------------------------
+                    //! Calls the function with the arguments.
+                    ALPAKA_FN_HOST auto operator()()
+                    -> void
+                    {
+                        meta::apply(
+                            std::move(m_fn),
+                            std::move(m_args));
+                    }
+
+                private:
+                    TFn m_fn;
+                    std::tuple<TArgs...> m_args;
+                };
+
+                //-----------------------------------------------------------------------------
+                //! \return The host function task holding the decayed function and arguments.
+                template<
+                    typename TFn,
+                    typename... TArgs>
+                ALPAKA_FN_HOST auto makeHostFnTask(
+                    TFn && fn,
+                    TArgs && ... args)
+                -> HostFnTask<
+                    typename std::decay<TFn>::type,
+                    typename std::decay<TArgs>::type...>
+                {
+                    return
+                        HostFnTask<
+                            typename std::decay<TFn>::type,
+                            typename std::decay<TArgs>::type...>(
+                                typename std::decay<TFn>::type(std::forward<TFn>(fn)),
+                                std::tuple<typename std::decay<TArgs>::type...>(std::forward<TArgs>(args)...));
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,641 @@
+/* Copyright 2019 Benjamin Worpitz
+ *
+ * This file is part of Alpaka.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <alpaka/core/BoostPredef.hpp>
+#include <alpaka/core/Futex.hpp>
+#include <alpaka/core/ThreadAffinity.hpp>
+#include <alpaka/core/Unused.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace alpaka
+{
+    namespace queue
+    {
+        namespace cpu
+        {
+            namespace detail
+            {
+                //#############################################################################
+                //! A lock-free multi-producer single-consumer ring of tasks which are executed in order by a single worker thread.
+                //!
+                //! Each slot carries a sequence number which tells the producers whether the slot is free and the worker whether the task in it has been published.
+                //! Producers claim a position with a single atomic increment and store the function object in-place without heap allocation as long as it fits into inlineStorageSize bytes.
+                //! The worker spins a short time for new tasks and then parks on a futex. Producers only make a system call if the worker is parked.
+                //!
+                //! Every task gets a sequence number on enqueue. The number of completed tasks is published after each task so that waiting for a task is a comparison of sequence numbers.
+                //! If the slot of a position is still occupied because the ring is full, the task is spilled into an overflow list guarded by a mutex instead of waiting for the worker.
+                //! Waiting would dead-lock if the worker is parked behind a gate opened only after the enqueue or if the producer is a task of this ring.
+                //!
+                //! A gate can be enqueued instead of a task to park all following tasks until it is opened, e.g. by the queue completing an event.
+                //! The worker does not execute anything while the gate is closed but is parked like an idle worker.
+                //!
+                //! The worker waits for every claimed position. If a task can not be stored, e.g. because its copy throws, a task doing nothing is published in its place before the exception is rethrown.
+                class TaskRing final
+                {
+                public:
+                    static constexpr std::size_t inlineStorageSize = 128u;
+                    //! The number of iterations the worker spins for new tasks before it is parked.
+                    static constexpr std::uint32_t spinCountMax = 1024u;
+
+                private:
+                    using Storage = typename std::aligned_storage<inlineStorageSize, alignof(std::max_align_t)>::type;
+
+                    //#############################################################################
+                    struct Slot
+                    {
+                        std::atomic<std::uint64_t> m_sequence;
+                        Storage m_storage;
+                        void (* m_pfnInvoke)(void *);
+                        void (* m_pfnDestroy)(void *);
+                        bool m_bGate;                       //!< If the slot holds a gate instead of a task.
+                        std::atomic<bool> m_bGateOpen;
+                    };
+
+                public:
+                    //#############################################################################
+                    //! Opens a gate enqueued by enqueueGate.
+                    //!
+                    //! It can be called once from any thread, e.g. as the continuation of an event.
+                    class Gate final
+                    {
+                    public:
+                        //-----------------------------------------------------------------------------
+                        Gate(
+                            std::atomic<bool> & bOpen,
+                            std::shared_ptr<core::threads::Futex> spEnqueueSignal) :
+                                m_pbOpen(&bOpen),
+                                m_spEnqueueSignal(std::move(spEnqueueSignal))
+                        {}
+
+                        //-----------------------------------------------------------------------------
+                        auto operator()() const
+                        -> void
+                        {
+                            // The ring can be destroyed as soon as the worker has passed the gate, so only the signal which is shared with the gate is accessed afterwards.
+                            m_pbOpen->store(true, std::memory_order_release);
+                            m_spEnqueueSignal->fetchAdd(1u);
+                            m_spEnqueueSignal->notifyOne();
+                        }
+
+                    private:
+                        std::atomic<bool> * m_pbOpen;
+                        std::shared_ptr<core::threads::Futex> m_spEnqueueSignal;
+                    };
+
+                    //-----------------------------------------------------------------------------
+                    //! \param capacity The number of queued tasks stored without locking. It is rounded up to the next power of two.
+                    //! \param workerInitFn The function called by the worker before it executes the first task, e.g. to set its affinity.
+                    explicit TaskRing(
+                        std::size_t const capacity = 1024u,
+                        std::function<void()> workerInitFn = std::function<void()>()) :
+                            m_capacity(roundUpToPowerOfTwo(capacity)),
+                            m_upSlots(new Slot[m_capacity]),
+                            m_enqueueCount(0u),
+                            m_dequeueCount(0u),
+                            m_completedCount(0u),
+                            m_completedSignal(0u),
+                            m_spEnqueueSignal(std::make_shared<core::threads::Futex>(0u)),
+                            m_mtxOverflow(),
+                            m_overflowSlots(),
+                            m_overflowCount(0u),
+                            m_upOverflowSlot(),
+                            m_bShutdownFlag(false),
+                            m_worker()
+                    {
+                        for(std::uint64_t i(0u); i < m_capacity; ++i)
+                        {
+                            initSlot(m_upSlots[i], i);
+                        }
+                        m_worker = std::thread(
+                            [this, workerInitFn]()
+                            {
+                                if(workerInitFn)
+                                {
+                                    workerInitFn();
+                                }
+                                workerFn();
+                            });
+                    }
+                    //-----------------------------------------------------------------------------
+                    TaskRing(TaskRing const &) = delete;
+                    //-----------------------------------------------------------------------------
+                    TaskRing(TaskRing &&) = delete;
+                    //-----------------------------------------------------------------------------
+                    auto operator=(TaskRing const &) -> TaskRing & = delete;
+                    //-----------------------------------------------------------------------------
+                    auto operator=(TaskRing &&) -> TaskRing & = delete;
+                    //-----------------------------------------------------------------------------
+                    //! Executes all tasks that have already been enqueued and joins the worker.
+                    //! All gates enqueued before have to be opened.
+                    ~TaskRing()
+                    {
+                        m_bShutdownFlag.store(true);
+                        m_spEnqueueSignal->fetchAdd(1u);
+                        m_spEnqueueSignal->notifyAll();
+                        m_worker.join();
+                    }
+
+                    //-----------------------------------------------------------------------------
+                    //! Enqueues a function object taking no arguments.
+                    //!
+                    //! \return The sequence number of the task. It is completed as soon as getCompletedCount() is greater or equal.
+                    template<
+                        typename TFnObj>
+                    auto enqueue(
+                        TFnObj && task)
+                    -> std::uint64_t
+                    {
+                        auto const pos(m_enqueueCount.fetch_add(1u, std::memory_order_relaxed));
+
+                        try
+                        {
+                            emplaceAndPublish(pos, std::forward<TFnObj>(task));
+                        }
+                        catch(...)
+                        {
+                            signalEnqueue();
+                            throw;
+                        }
+
+                        signalEnqueue();
+
+                        return pos + 1u;
+                    }
+                    //-----------------------------------------------------------------------------
+                    //! Enqueues a gate which parks all tasks enqueued after it until it is opened.
+                    //!
+                    //! The gate is completed like a task as soon as it has been opened and all earlier tasks have been completed.
+                    //!
+                    //! \return The function object opening the gate.
+                    auto enqueueGate()
+                    -> Gate
+                    {
+                        auto const pos(m_enqueueCount.fetch_add(1u, std::memory_order_relaxed));
+
+                        auto & slot(m_upSlots[pos & (m_capacity - 1u)]);
+                        std::atomic<bool> * pbGateOpen(nullptr);
+                        if(slot.m_sequence.load(std::memory_order_acquire) == pos)
+                        {
+                            slot.m_pfnInvoke = [](void *){};
+                            slot.m_pfnDestroy = [](void *){};
+                            slot.m_bGate = true;
+                            pbGateOpen = &slot.m_bGateOpen;
+                            slot.m_sequence.store(pos + 1u, std::memory_order_release);
+                        }
+                        else
+                        {
+                            try
+                            {
+                                std::unique_ptr<Slot> upSlot(new Slot());
+                                initSlot(*upSlot, pos);
+                                upSlot->m_pfnInvoke = [](void *){};
+                                upSlot->m_pfnDestroy = [](void *){};
+                                upSlot->m_bGate = true;
+                                // The slot is owned by the overflow list until the worker has passed the gate, so its address stays valid for the gate.
+                                pbGateOpen = &upSlot->m_bGateOpen;
+                                spill(pos, std::move(upSlot));
+                            }
+                            catch(...)
+                            {
+                                publishNoOp(pos);
+                                signalEnqueue();
+                                throw;
+                            }
+                        }
+
+                        // The worker has to be woken up even if the gate is still closed, because it has to check it.
+                        signalEnqueue();
+
+                        return Gate(*pbGateOpen, m_spEnqueueSignal);
+                    }
+                    //-----------------------------------------------------------------------------
+                    //! Enqueues multiple function objects taking no arguments which are executed in the given order.
+                    //!
+                    //! All positions are claimed with a single atomic increment and the worker is woken up only once after all tasks have been published.
+                    //! No task of another producer can be interleaved with the tasks of the batch.
+                    //!
+                    //! \return The sequence number of the last task of the batch.
+                    template<
+                        typename TFnObj,
+                        typename... TFnObjs>
+                    auto enqueueBatch(
+                        TFnObj && task,
+                        TFnObjs && ... tasks)
+                    -> std::uint64_t
+                    {
+                        std::uint64_t const taskCount(1u + sizeof...(TFnObjs));
+                        auto const pos(m_enqueueCount.fetch_add(taskCount, std::memory_order_relaxed));
+
+                        // Store and publish the tasks in order so that the worker can already start with the first ones.
+                        auto taskPos(pos);
+                        try
+                        {
+                            int const dummy[] = {(emplaceAndPublish(taskPos++, std::forward<TFnObj>(task)), 0), (emplaceAndPublish(taskPos++, std::forward<TFnObjs>(tasks)), 0)...};
+                            alpaka::ignore_unused(dummy);
+                        }
+                        catch(...)
+                        {
+                            // The task which could not be stored has already been replaced, but the positions of the following ones are still claimed.
+                            for(; taskPos < pos + taskCount; ++taskPos)
+                            {
+                                publishNoOp(taskPos);
+                            }
+                            signalEnqueue();
+                            throw;
+                        }
+
+                        signalEnqueue();
+
+                        return pos + taskCount;
+                    }
+                    //-----------------------------------------------------------------------------
+                    //! Enqueues an empty batch.
+                    //! \return The sequence number of the last task enqueued so far.
+                    auto enqueueBatch()
+                    -> std::uint64_t
+                    {
+                        return getEnqueueCount();
+                    }
+                    //-----------------------------------------------------------------------------
+                    //! \return The number of tasks that have been enqueued so far.
+                    auto getEnqueueCount() const
+                    -> std::uint64_t
+                    {
+                        return m_enqueueCount.load(std::memory_order_acquire);
+                    }
+                    //-----------------------------------------------------------------------------
+                    //! \return The number of tasks that have been completed so far.
+                    auto getCompletedCount() const
+                    -> std::uint64_t
+                    {
+                        return m_completedCount.load(std::memory_order_acquire);
+                    }
+                    //-----------------------------------------------------------------------------
+                    //! \return If all tasks enqueued so far have been completed.
+                    auto isIdle() const
+                    -> bool
+                    {
+                        return getCompletedCount() == getEnqueueCount();
+                    }
+                    //-----------------------------------------------------------------------------
+                    //! \return The logical CPUs the worker is allowed to run on.
+                    auto getWorkerAffinity()
+                    -> std::vector<std::uint32_t>
+                    {
+                        return core::threads::getThreadAffinity(m_worker);
+                    }
+                    //-----------------------------------------------------------------------------
+                    //! Blocks the calling thread until the task with the given sequence number has been completed.
+                    auto waitFor(
+                        std::uint64_t const sequence)
+                    -> void
+                    {
+                        while(true)
+                        {
+                            auto const signal(m_completedSignal.load());
+                            if(getCompletedCount() >= sequence)
+                            {
+                                return;
+                            }
+                            m_completedSignal.wait(signal);
+                        }
+                    }
+
+                private:
+                    //-----------------------------------------------------------------------------
+                    //! Initializes an empty slot which is free for the given position.
+                    static auto initSlot(
+                        Slot & slot,
+                        std::uint64_t const pos)
+                    -> void
+                    {
+                        slot.m_sequence.store(pos, std::memory_order_relaxed);
+                        slot.m_pfnInvoke = nullptr;
+                        slot.m_pfnDestroy = nullptr;
+                        slot.m_bGate = false;
+                        slot.m_bGateOpen.store(false, std::memory_order_relaxed);
+                    }
+                    //-----------------------------------------------------------------------------
+                    //! Wakes up the worker after tasks have been published.
+                    auto signalEnqueue()
+                    -> void
+                    {
+                        m_spEnqueueSignal->fetchAdd(1u);
+                        m_spEnqueueSignal->notifyOne();
+                    }
+                    //-----------------------------------------------------------------------------
+                    //! Turns the slot into one holding a task doing nothing.
+                    static auto setNoOp(
+                        Slot & slot)
+                    -> void
+                    {
+                        slot.m_pfnInvoke = [](void *){};
+                        slot.m_pfnDestroy = [](void *){};
+                        slot.m_bGate = false;
+                    }
+                    //-----------------------------------------------------------------------------
+                    //! Publishes a task doing nothing for the already claimed position whose task could not be stored.
+                    //!
+                    //! If the slot of the ring is occupied and there is not even memory for a spilled slot, this waits until the worker has freed the slot of the ring.
+                    auto publishNoOp(
+                        std::uint64_t const pos) noexcept
+                    -> void
+                    {
+                        auto & slot(m_upSlots[pos & (m_capacity - 1u)]);
+                        if(slot.m_sequence.load(std::memory_order_acquire) != pos)
+                        {
+                            try
+                            {
+                                std::unique_ptr<Slot> upSlot(new Slot());
+                                initSlot(*upSlot, pos);
+                                setNoOp(*upSlot);
+                                spill(pos, std::move(upSlot));
+                                return;
+                            }
+                            catch(...)
+                            {
+                            }
+                            while(slot.m_sequence.load(std::memory_order_acquire) != pos)
+                            {
+                                std::this_thread::yield();
+                            }
+                        }
+                        setNoOp(slot);
+                        slot.m_sequence.store(pos + 1u, std::memory_order_release);
+                    }
+                    //-----------------------------------------------------------------------------
+                    //! Adds the heap allocated slot holding the task of the given position to the overflow list.
+                    auto spill(
+                        std::uint64_t const pos,
+                        std::unique_ptr<Slot> upSlot)
+                    -> void
+                    {
+                        std::lock_guard<std::mutex> lock(m_mtxOverflow);
+                        m_overflowSlots.emplace(pos, std::move(upSlot));
+                        m_overflowCount.fetch_add(1u, std::memory_order_release);
+                    }
+                    //-----------------------------------------------------------------------------
+                    static auto roundUpToPowerOfTwo(
+                        std::uint64_t const value)
+                    -> std::uint64_t
+                    {
+                        std::uint64_t powerOfTwo(1u);
+                        while(powerOfTwo < value)
+                        {
+                            powerOfTwo <<= 1u;
+                        }
+                        return powerOfTwo;
+                    }
+                    //-----------------------------------------------------------------------------
+                    //! Stores the function object either in-place or on the heap.
+                    template<
+                        typename TFnObj>
+                    static auto emplaceFnObj(
+                        Slot & slot,
+                        TFnObj && fnObj)
+                    -> void
+                    {
+                        using FnObj = typename std::decay<TFnObj>::type;
+
+                        emplaceFnObj<FnObj>(
+                            slot,
+                            std::forward<TFnObj>(fnObj),
+                            std::integral_constant<
+                                bool,
+                                (sizeof(FnObj) <= inlineStorageSize) && (alignof(FnObj) <= alignof(Storage))>());
+                    }
+                    //-----------------------------------------------------------------------------
+                    //! Stores the function object for the already claimed position and publishes it to the worker.
+                    //!
+                    //! The slot of the position is free as soon as the worker has completed the task one round earlier.
+                    //! If this has not happened yet, the task is spilled into the overflow list.
+                    //! If the task can not be stored, a task doing nothing is published instead and the exception is rethrown.
+                    template<
+                        typename TFnObj>
+                    auto emplaceAndPublish(
+                        std::uint64_t const pos,
+                        TFnObj && fnObj)
+                    -> void
+                    {
+                        auto & slot(m_upSlots[pos & (m_capacity - 1u)]);
+                        try
+                        {
+                            if(slot.m_sequence.load(std::memory_order_acquire) == pos)
+                            {
+                                emplaceFnObj(
+                                    slot,
+                                    std::forward<TFnObj>(fnObj));
+                                slot.m_sequence.store(pos + 1u, std::memory_order_release);
+                            }
+                            else
+                            {
+                                std::unique_ptr<Slot> upSlot(new Slot());
+                                initSlot(*upSlot, pos);
+                                emplaceFnObj(
+                                    *upSlot,
+                                    std::forward<TFnObj>(fnObj));
+                                try
+                                {
+                                    spill(pos, std::move(upSlot));
+                                }
+                                catch(...)
+                                {
+                                    // The overflow list has not taken the slot, so the function object stored in it is destroyed here.
+                                    if(upSlot)
+                                    {
+                                        upSlot->m_pfnDestroy(&upSlot->m_storage);
+                                    }
+                                    throw;
+                                }
+                            }
+                        }
+                        catch(...)
+                        {
+                            publishNoOp(pos);
+                            throw;
+                        }
+                    }
+                    //-----------------------------------------------------------------------------
+                    //! Stores the function object in-place.
+                    template<
+                        typename TFnObj,
+                        typename TFnObjFwd>
+                    static auto emplaceFnObj(
+                        Slot & slot,
+                        TFnObjFwd && fnObj,
+                        std::true_type)
+                    -> void
+                    {
+                        new (&slot.m_storage) TFnObj(std::forward<TFnObjFwd>(fnObj));
+                        slot.m_pfnInvoke = [](void * const pStorage){(*static_cast<TFnObj *>(pStorage))();};
+                        slot.m_pfnDestroy = [](void * const pStorage){static_cast<TFnObj *>(pStorage)->~TFnObj();};
+                    }
+                    //-----------------------------------------------------------------------------
+                    //! Stores a pointer to a heap allocated copy of the function object because it is too large to be stored in-place.
+                    template<
+                        typename TFnObj,
+                        typename TFnObjFwd>
+                    static auto emplaceFnObj(
+                        Slot & slot,
+                        TFnObjFwd && fnObj,
+                        std::false_type)
+                    -> void
+                    {
+                        new (&slot.m_storage) TFnObj *(new TFnObj(std::forward<TFnObjFwd>(fnObj)));
+                        slot.m_pfnInvoke = [](void * const pStorage){(**static_cast<TFnObj **>(pStorage))();};
+                        slot.m_pfnDestroy = [](void * const pStorage){delete *static_cast<TFnObj **>(pStorage);};
+                    }
+                    //-----------------------------------------------------------------------------
+                    //! \return The slot of the next task if it has already been published and is not a closed gate, nullptr else.
+                    //! The slot is either the one of the ring or the one spilled into the overflow list for the next position.
+                    auto tryGetNextTask()
+                    -> Slot *
+                    {
+                        auto & slot(m_upSlots[m_dequeueCount & (m_capacity - 1u)]);
+                        if(slot.m_sequence.load(std::memory_order_acquire) == m_dequeueCount + 1u)
+                        {
+                            return (!slot.m_bGate || slot.m_bGateOpen.load(std::memory_order_acquire)) ? &slot : nullptr;
+                        }
+
+                        // The overflow list is only locked if something has been spilled.
+                        if(m_overflowCount.load(std::memory_order_acquire) != 0u)
+                        {
+                            std::lock_guard<std::mutex> lock(m_mtxOverflow);
+                            auto const it(m_overflowSlots.find(m_dequeueCount));
+                            if((it != m_overflowSlots.end())
+                                && (!it->second->m_bGate || it->second->m_bGateOpen.load(std::memory_order_acquire)))
+                            {
+                                m_upOverflowSlot = std::move(it->second);
+                                m_overflowSlots.erase(it);
+                                m_overflowCount.fetch_sub(1u, std::memory_order_relaxed);
+                                return m_upOverflowSlot.get();
+                            }
+                        }
+                        return nullptr;
+                    }
+                    //-----------------------------------------------------------------------------
+                    //! Runs the task and frees the slot.
+                    auto runTask(
+                        Slot & slot)
+                    -> void
+                    {
+                        try
+                        {
+                            slot.m_pfnInvoke(&slot.m_storage);
+                        }
+                        catch(...)
+                        {
+                            // Like the tasks of the ConcurrentExecPool whose futures are dropped, exceptions are not propagated to the enqueuing thread.
+                        }
+                        slot.m_pfnDestroy(&slot.m_storage);
+
+                        auto & ringSlot(m_upSlots[m_dequeueCount & (m_capacity - 1u)]);
+                        if(&slot == &ringSlot)
+                        {
+                            slot.m_bGate = false;
+                            slot.m_bGateOpen.store(false, std::memory_order_relaxed);
+                        }
+                        else
+                        {
+                            m_upOverflowSlot.reset();
+                        }
+
+                        ++m_dequeueCount;
+                        // The slot of the ring can be reused for the task one round later even if the task of this round has been spilled.
+                        ringSlot.m_sequence.store(m_dequeueCount + m_capacity - 1u, std::memory_order_release);
+
+                        m_completedCount.store(m_dequeueCount, std::memory_order_release);
+                        m_completedSignal.fetchAdd(1u);
+                        m_completedSignal.notifyAll();
+                    }
+                    //-----------------------------------------------------------------------------
+                    //! The function the worker thread is executing.
+                    auto workerFn()
+                    -> void
+                    {
+                        while(true)
+                        {
+                            if(Slot * const pSlot = waitForNextTask())
+                            {
+                                runTask(*pSlot);
+                            }
+                            else
+                            {
+                                // All tasks enqueued before the shutdown have been executed.
+                                return;
+                            }
+                        }
+                    }
+                    //-----------------------------------------------------------------------------
+                    //! Spins and then parks the worker until a task has been published.
+                    //! \return The slot of the next task or nullptr if the ring is shut down and empty.
+                    auto waitForNextTask()
+                    -> Slot *
+                    {
+                        for(std::uint32_t i(0u); i < spinCountMax; ++i)
+                        {
+                            if(Slot * const pSlot = tryGetNextTask())
+                            {
+                                return pSlot;
+                            }
+                            core::threads::cpuRelax();
+                        }
+                        while(true)
+                        {
+                            auto const signal(m_spEnqueueSignal->load());
+                            if(Slot * const pSlot = tryGetNextTask())
+                            {
+                                return pSlot;
+                            }
+                            // A slot that has been claimed but not yet published has to be waited for even during shutdown.
+                            if(m_bShutdownFlag.load() && (m_enqueueCount.load() == m_dequeueCount))
+                            {
+                                return nullptr;
+                            }
+                            m_spEnqueueSignal->wait(signal);
+                        }
+                    }
+
+                private:
+                    std::uint64_t const m_capacity;
+                    std::unique_ptr<Slot[]> m_upSlots;
+
+                    std::atomic<std::uint64_t> m_enqueueCount;
+                    std::uint64_t m_dequeueCount;                   //!< Only accessed by the worker.
+                    std::atomic<std::uint64_t> m_completedCount;
+                    core::threads::Futex m_completedSignal;         //!< Incremented after each completed task.
+                    std::shared_ptr<core::threads::Futex> m_spEnqueueSignal;    //!< Incremented after each published task and opened gate. It is shared with the gates so that they can outlive the ring.
+
+                    std::mutex m_mtxOverflow;
+                    std::map<std::uint64_t, std::unique_ptr<Slot>> m_overflowSlots;    //!< The tasks spilled because the slot of their position was occupied. Guarded by m_mtxOverflow.
+                    std::atomic<std::size_t> m_overflowCount;      //!< The number of spilled tasks. It is read without locking.
+                    std::unique_ptr<Slot> m_upOverflowSlot;         //!< The spilled task currently executed. Only accessed by the worker.
+                    std::atomic<bool> m_bShutdownFlag;
+
+                    std::thread m_worker;
+                };
+            }
+        }
+    }
+}
@@ -0,0 +1,104 @@
+/* Copyright 2019 Benjamin Worpitz
+ *
+ * This file is part of Alpaka.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <alpaka/atomic/AtomicStdLibLock.hpp>
+#include <alpaka/atomic/Op.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    //#############################################################################
+    //! A type that is too large to be updated lock-free.
+    struct Vec2
+    {
+        double m_x;
+        double m_y;
+
+        auto operator+=(Vec2 const & rhs)
+        -> Vec2 &
+        {
+            m_x += rhs.m_x;
+            m_y += rhs.m_y;
+            return *this;
+        }
+    };
+
+    //-----------------------------------------------------------------------------
+    //! Measures the throughput of all threads concurrently adding to either the same or to their own neighbouring element.
+    template<
+        typename TAtomic>
+    auto measureLockContention(
+        std::string const & name,
+        std::size_t const threadCount,
+        std::size_t const opCount,
+        bool const bSharedAddress)
+    -> void
+    {
+        TAtomic const atomic{};
+        std::vector<Vec2> values(threadCount, Vec2{0.0, 0.0});
+
+        std::vector<std::thread> threads;
+        auto const tpStart(std::chrono::high_resolution_clock::now());
+        for(std::size_t t(0u); t < threadCount; ++t)
+        {
+            Vec2 * const pValue(bSharedAddress ? &values[0u] : &values[t]);
+            threads.emplace_back(
+                [&atomic, pValue, opCount]()
+                {
+                    for(std::size_t i(0u); i < opCount; ++i)
+                    {
+                        alpaka::atomic::atomicOp<alpaka::atomic::op::Add>(atomic, pValue, Vec2{1.0, 1.0});
+                    }
+                });
+        }
+        for(auto & thread : threads)
+        {
+            thread.join();
+        }
+        auto const tpEnd(std::chrono::high_resolution_clock::now());
+
+        auto const durNs(std::chrono::duration_cast<std::chrono::nanoseconds>(tpEnd - tpStart).count());
+
+        std::cout
+            << name
+            << "(threads: " << threadCount
+            << ", hardware threads: " << std::thread::hardware_concurrency()
+            << ", ops per thread: " << opCount
+            << ", address: " << (bSharedAddress ? "shared" : "per thread")
+            << ") throughput: " << static_cast<double>(threadCount * opCount) * 1.0e3 / static_cast<double>(durNs) << " Mops/s" << std::endl;
+    }
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE( "atomicLockContention", "[benchmark]")
+{
+#ifdef ALPAKA_CI
+    std::size_t const opCount = 1000u;
+#else
+    std::size_t const opCount = 1000000u;
+#endif
+
+    for(bool const bSharedAddress : {true, false})
+    {
+        for(std::size_t const threadCount : {1u, 2u, 4u, 8u})
+        {
+            measureLockContention<alpaka::atomic::AtomicStdLibLock<1>>("AtomicStdLibLock<1>", threadCount, opCount, bSharedAddress);
+            measureLockContention<alpaka::atomic::AtomicStdLibLock<16>>("AtomicStdLibLock<16>", threadCount, opCount, bSharedAddress);
+            measureLockContention<alpaka::atomic::AtomicStdLibLock<256>>("AtomicStdLibLock<256>", threadCount, opCount, bSharedAddress);
+        }
+    }
+}
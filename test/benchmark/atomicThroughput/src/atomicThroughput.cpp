@@ -0,0 +1,90 @@
+/* Copyright 2019 Benjamin Worpitz
+ *
+ * This file is part of Alpaka.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <alpaka/atomic/AtomicStdLibLock.hpp>
+#include <alpaka/atomic/AtomicStdLibLockFree.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    //-----------------------------------------------------------------------------
+    //! Measures the throughput of all threads concurrently applying the operation to the same address.
+    template<
+        typename TOp,
+        typename TAtomic,
+        typename T>
+    auto measureAtomicThroughput(
+        std::string const & name,
+        std::size_t const threadCount,
+        std::size_t const opCount)
+    -> void
+    {
+        TAtomic const atomic{};
+        T value(0);
+
+        std::vector<std::thread> threads;
+        auto const tpStart(std::chrono::high_resolution_clock::now());
+        for(std::size_t t(0u); t < threadCount; ++t)
+        {
+            threads.emplace_back(
+                [&atomic, &value, opCount]()
+                {
+                    for(std::size_t i(0u); i < opCount; ++i)
+                    {
+                        alpaka::atomic::atomicOp<TOp>(atomic, &value, static_cast<T>(i));
+                    }
+                });
+        }
+        for(auto & thread : threads)
+        {
+            thread.join();
+        }
+        auto const tpEnd(std::chrono::high_resolution_clock::now());
+
+        auto const durNs(std::chrono::duration_cast<std::chrono::nanoseconds>(tpEnd - tpStart).count());
+
+        std::cout
+            << name
+            << "(threads: " << threadCount
+            << ", hardware threads: " << std::thread::hardware_concurrency()
+            << ", ops per thread: " << opCount
+            << ") throughput: " << static_cast<double>(threadCount * opCount) * 1.0e3 / static_cast<double>(durNs) << " Mops/s" << std::endl;
+    }
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE( "atomicThroughput", "[benchmark]")
+{
+#ifdef ALPAKA_CI
+    std::size_t const opCount = 1000u;
+#else
+    std::size_t const opCount = 1000000u;
+#endif
+
+    using AtomicLock = alpaka::atomic::AtomicStdLibLock<16>;
+    using AtomicLockFree = alpaka::atomic::AtomicStdLibLockFree<16>;
+
+    for(std::size_t const threadCount : {1u, 2u, 4u, 8u})
+    {
+        measureAtomicThroughput<alpaka::atomic::op::Add, AtomicLock, int>("AtomicStdLibLock Add<int>", threadCount, opCount);
+        measureAtomicThroughput<alpaka::atomic::op::Add, AtomicLockFree, int>("AtomicStdLibLockFree Add<int>", threadCount, opCount);
+        measureAtomicThroughput<alpaka::atomic::op::Max, AtomicLock, int>("AtomicStdLibLock Max<int>", threadCount, opCount);
+        measureAtomicThroughput<alpaka::atomic::op::Max, AtomicLockFree, int>("AtomicStdLibLockFree Max<int>", threadCount, opCount);
+        measureAtomicThroughput<alpaka::atomic::op::Add, AtomicLock, float>("AtomicStdLibLock Add<float>", threadCount, opCount);
+        measureAtomicThroughput<alpaka::atomic::op::Add, AtomicLockFree, float>("AtomicStdLibLockFree Add<float>", threadCount, opCount);
+    }
+}
@@ -0,0 +1,67 @@
+/* Copyright 2019 Benjamin Worpitz
+ *
+ * This file is part of Alpaka.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <alpaka/core/BarrierThread.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+TEST_CASE( "barrierThreadRoundTripLatency", "[benchmark]")
+{
+#ifdef ALPAKA_CI
+    std::size_t const roundTripCount = 100u;
+#else
+    std::size_t const roundTripCount = 10000u;
+#endif
+
+    // Spinning only pays off if each thread has its own hardware thread.
+    // With more threads than hardware threads the spinning delays the threads the waiters are waiting for.
+    for(std::uint32_t const spinCount : {0u, alpaka::core::threads::getBarrierSpinCount()})
+    {
+        for(std::size_t const threadCount : {1u, 2u, 4u, 8u, 16u})
+        {
+            alpaka::core::threads::BarrierThread<std::size_t> barrier(threadCount, spinCount);
+
+            std::vector<std::thread> threads;
+            auto const tpStart(std::chrono::high_resolution_clock::now());
+            for(std::size_t t(0u); t < threadCount; ++t)
+            {
+                threads.emplace_back(
+                    [&barrier, roundTripCount]()
+                    {
+                        for(std::size_t i(0u); i < roundTripCount; ++i)
+                        {
+                            barrier.wait();
+                        }
+                    });
+            }
+            for(auto & thread : threads)
+            {
+                thread.join();
+            }
+            auto const tpEnd(std::chrono::high_resolution_clock::now());
+
+            auto const durNs(std::chrono::duration_cast<std::chrono::nanoseconds>(tpEnd - tpStart).count());
+
+            std::cout
+                << "barrierThread(spinCount: " << spinCount
+                << ", threads: " << threadCount
+                << ", hardware threads: " << std::thread::hardware_concurrency()
+                << ", round trips: " << roundTripCount
+                << ") latency: " << static_cast<double>(durNs) / static_cast<double>(roundTripCount) << " ns" << std::endl;
+        }
+    }
+}
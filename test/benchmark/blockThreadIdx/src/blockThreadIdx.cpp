@@ -0,0 +1,126 @@
+/* Copyright 2019 Benjamin Worpitz
+ *
+ * This file is part of Alpaka.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <alpaka/alpaka.hpp>
+
+#include <alpaka/test/acc/TestAccs.hpp>
+#include <alpaka/test/queue/Queue.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <typeinfo>
+
+//#############################################################################
+//! A kernel repeatedly querying the block thread index so that mainly the cost of the index query is measured.
+class BlockThreadIdxQueryKernel
+{
+public:
+    //-----------------------------------------------------------------------------
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc>
+    ALPAKA_FN_ACC auto operator()(
+        TAcc const & acc,
+        std::uint32_t const queryCount,
+        std::uint32_t * const result) const
+    -> void
+    {
+        using Idx = alpaka::idx::Idx<TAcc>;
+
+        Idx sum(0u);
+        for(std::uint32_t i(0u); i < queryCount; ++i)
+        {
+            sum = static_cast<Idx>(sum + alpaka::idx::getIdx<alpaka::Block, alpaka::Threads>(acc)[0u]);
+        }
+
+        // The result is written so that the queries can not be optimized away.
+        if(alpaka::idx::getIdx<alpaka::Grid, alpaka::Threads>(acc).sum() == 0u)
+        {
+            *result = static_cast<std::uint32_t>(sum);
+        }
+    }
+};
+
+//-----------------------------------------------------------------------------
+struct TestTemplate
+{
+template< typename TAcc >
+void operator()()
+{
+    using Dim = alpaka::dim::Dim<TAcc>;
+    using Idx = alpaka::idx::Idx<TAcc>;
+    using DevAcc = alpaka::dev::Dev<TAcc>;
+    using PltfAcc = alpaka::pltf::Pltf<DevAcc>;
+    using QueueAcc = alpaka::test::queue::DefaultQueue<DevAcc>;
+
+#ifdef ALPAKA_CI
+    std::uint32_t const queryCount = 10000u;
+#else
+    std::uint32_t const queryCount = 1000000u;
+#endif
+
+    auto const devAcc(
+        alpaka::pltf::getDevByIdx<PltfAcc>(0u));
+    QueueAcc queue(devAcc);
+
+    auto const blockThreadCountMax(
+        alpaka::acc::getAccDevProps<TAcc>(devAcc).m_blockThreadCountMax);
+    auto const blockThreadCount(std::min(static_cast<Idx>(4u), blockThreadCountMax));
+
+    auto bufAcc(alpaka::mem::buf::alloc<std::uint32_t, Idx>(devAcc, static_cast<Idx>(1u)));
+
+    alpaka::workdiv::WorkDivMembers<Dim, Idx> const workDiv(
+        alpaka::vec::Vec<Dim, Idx>::ones(),
+        alpaka::vec::Vec<Dim, Idx>::all(blockThreadCount),
+        alpaka::vec::Vec<Dim, Idx>::ones());
+
+    BlockThreadIdxQueryKernel kernel;
+
+    auto const taskKernel(alpaka::kernel::createTaskKernel<TAcc>(
+        workDiv,
+        kernel,
+        queryCount,
+        alpaka::mem::view::getPtrNative(bufAcc)));
+
+    // Warm up so that one-time initialization is not part of the measurement.
+    alpaka::queue::enqueue(queue, taskKernel);
+    alpaka::wait::wait(queue);
+
+    auto const tpStart(std::chrono::high_resolution_clock::now());
+    alpaka::queue::enqueue(queue, taskKernel);
+    alpaka::wait::wait(queue);
+    auto const tpEnd(std::chrono::high_resolution_clock::now());
+
+    auto const durNs(std::chrono::duration_cast<std::chrono::nanoseconds>(tpEnd - tpStart).count());
+
+    std::cout
+        << "blockThreadIdx(" << alpaka::acc::getAccName<TAcc>()
+        << ", blockThreadCount: " << blockThreadCount
+        << ", queries: " << queryCount
+        << ") time per query: " << static_cast<double>(durNs) / static_cast<double>(queryCount) << " ns" << std::endl;
+
+    auto bufHost(alpaka::mem::buf::alloc<std::uint32_t, Idx>(alpaka::pltf::getDevByIdx<alpaka::pltf::PltfCpu>(0u), static_cast<Idx>(1u)));
+    alpaka::mem::view::copy(queue, bufHost, bufAcc, static_cast<Idx>(1u));
+    alpaka::wait::wait(queue);
+
+    // The thread with block thread index zero writes the result, so the sum is zero.
+    REQUIRE(0u == *alpaka::mem::view::getPtrNative(bufHost));
+}
+};
+
+TEST_CASE( "blockThreadIdxQuery", "[benchmark]")
+{
+    using TestAccs = alpaka::test::acc::EnabledAccs<
+        alpaka::dim::DimInt<1u>,
+        std::size_t>;
+
+    alpaka::meta::forEachType< TestAccs >( TestTemplate() );
+}
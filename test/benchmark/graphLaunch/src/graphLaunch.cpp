@@ -0,0 +1,165 @@
+/* Copyright 2019 Benjamin Worpitz
+ *
+ * This file is part of Alpaka.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <alpaka/alpaka.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+#if defined(ALPAKA_ACC_CPU_B_SEQ_T_SEQ_ENABLED)
+
+namespace
+{
+    using Dim = alpaka::dim::DimInt<1u>;
+    using Idx = std::size_t;
+    using Acc = alpaka::acc::AccCpuSerial<Dim, Idx>;
+
+    //#############################################################################
+    //! A kernel incrementing each element.
+    class IncrementKernel
+    {
+    public:
+        //-----------------------------------------------------------------------------
+        ALPAKA_NO_HOST_ACC_WARNING
+        template<
+            typename TAcc>
+        ALPAKA_FN_ACC auto operator()(
+            TAcc const & acc,
+            std::uint32_t * const data,
+            Idx const & elemCount) const
+        -> void
+        {
+            auto const idx(alpaka::idx::getIdx<alpaka::Grid, alpaka::Threads>(acc)[0u]);
+            if(idx < elemCount)
+            {
+                ++data[idx];
+            }
+        }
+    };
+
+    //! The number of kernels within each step of the pipeline.
+    constexpr std::uint32_t kernelCount = 6u;
+
+    //-----------------------------------------------------------------------------
+    //! Enqueues one step of the pipeline: a set, multiple dependent kernels and a copy of the result.
+    template<
+        typename TQueue,
+        typename TBuf>
+    auto enqueuePipelineStep(
+        TQueue & queue,
+        TBuf & bufA,
+        TBuf & bufB,
+        Idx const & elemCount)
+    -> void
+    {
+        alpaka::vec::Vec<Dim, Idx> const extent(elemCount);
+
+        alpaka::mem::view::set(queue, bufA, 0u, extent);
+
+        auto const workDiv(
+            alpaka::workdiv::getValidWorkDiv<Acc>(
+                alpaka::dev::getDev(queue),
+                extent,
+                alpaka::vec::Vec<Dim, Idx>::ones(),
+                false,
+                alpaka::workdiv::GridBlockExtentSubDivRestrictions::Unrestricted));
+        for(std::uint32_t k(0u); k < kernelCount; ++k)
+        {
+            alpaka::queue::enqueue(
+                queue,
+                alpaka::kernel::createTaskKernel<Acc>(
+                    workDiv,
+                    IncrementKernel(),
+                    alpaka::mem::view::getPtrNative(bufA),
+                    elemCount));
+        }
+
+        alpaka::mem::view::copy(queue, bufB, bufA, extent);
+    }
+
+    //-----------------------------------------------------------------------------
+    //! Measures the latency of a pipeline step enqueued task by task and launched as a recorded graph.
+    //!
+    //! The graph saves the work division validation, the task creation and the enqueue of each task.
+    //! The per-launch setup of the kernel back-end is executed by both variants.
+    template<
+        typename TQueue>
+    auto measureGraphLaunch(
+        std::string const & name,
+        std::uint32_t const stepCount)
+    -> void
+    {
+        auto const dev(alpaka::pltf::getDevByIdx<alpaka::pltf::PltfCpu>(0u));
+        TQueue queue(dev);
+
+        // A single element keeps the kernels short so that mainly the launch overhead is measured.
+        Idx const elemCount(1u);
+        auto bufA(alpaka::mem::buf::alloc<std::uint32_t, Idx>(dev, elemCount));
+        auto bufB(alpaka::mem::buf::alloc<std::uint32_t, Idx>(dev, elemCount));
+
+        // Warm up so that one-time initialization is not part of the measurement.
+        enqueuePipelineStep(queue, bufA, bufB, elemCount);
+        alpaka::wait::wait(queue);
+
+        auto const tpStartEnqueue(std::chrono::high_resolution_clock::now());
+        for(std::uint32_t i(0u); i < stepCount; ++i)
+        {
+            enqueuePipelineStep(queue, bufA, bufB, elemCount);
+            alpaka::wait::wait(queue);
+        }
+        auto const tpEndEnqueue(std::chrono::high_resolution_clock::now());
+
+        alpaka::graph::beginCapture(queue);
+        enqueuePipelineStep(queue, bufA, bufB, elemCount);
+        auto const graph(alpaka::graph::endCapture(queue));
+
+        auto const tpStartGraph(std::chrono::high_resolution_clock::now());
+        for(std::uint32_t i(0u); i < stepCount; ++i)
+        {
+            alpaka::queue::enqueue(queue, graph);
+            alpaka::wait::wait(queue);
+        }
+        auto const tpEndGraph(std::chrono::high_resolution_clock::now());
+
+        auto const durEnqueueUs(std::chrono::duration_cast<std::chrono::microseconds>(tpEndEnqueue - tpStartEnqueue).count());
+        auto const durGraphUs(std::chrono::duration_cast<std::chrono::microseconds>(tpEndGraph - tpStartGraph).count());
+
+        std::cout
+            << "graphLaunch(" << name
+            << ", tasks per step: " << graph.getTaskCount()
+            << ", steps: " << stepCount
+            << ") latency per step: enqueue " << static_cast<double>(durEnqueueUs) / static_cast<double>(stepCount) << " us"
+            << ", graph " << static_cast<double>(durGraphUs) / static_cast<double>(stepCount) << " us" << std::endl;
+
+        auto const pB(alpaka::mem::view::getPtrNative(bufB));
+        for(Idx i(0u); i < elemCount; ++i)
+        {
+            REQUIRE(kernelCount == pB[i]);
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE( "graphLaunch", "[benchmark]")
+{
+#ifdef ALPAKA_CI
+    std::uint32_t const stepCount = 100u;
+#else
+    std::uint32_t const stepCount = 10000u;
+#endif
+
+    measureGraphLaunch<alpaka::queue::QueueCpuBlocking>("QueueCpuBlocking", stepCount);
+    measureGraphLaunch<alpaka::queue::QueueCpuNonBlocking>("QueueCpuNonBlocking", stepCount);
+}
+
+#endif
@@ -0,0 +1,129 @@
+/* Copyright 2019 Benjamin Worpitz
+ *
+ * This file is part of Alpaka.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <alpaka/alpaka.hpp>
+
+#include <alpaka/test/acc/TestAccs.hpp>
+#include <alpaka/test/queue/Queue.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <typeinfo>
+
+//#############################################################################
+//! A kernel doing (nearly) nothing so that only the launch overhead is measured.
+class EmptyKernel
+{
+public:
+    //-----------------------------------------------------------------------------
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc>
+    ALPAKA_FN_ACC auto operator()(
+        TAcc const & acc,
+        std::uint32_t * const counter) const
+    -> void
+    {
+        if(alpaka::idx::getIdx<alpaka::Grid, alpaka::Threads>(acc).sum() == 0u)
+        {
+            ++(*counter);
+        }
+    }
+};
+
+//-----------------------------------------------------------------------------
+struct TestTemplate
+{
+template< typename TAcc >
+void operator()()
+{
+    using Dim = alpaka::dim::Dim<TAcc>;
+    using Idx = alpaka::idx::Idx<TAcc>;
+    using DevAcc = alpaka::dev::Dev<TAcc>;
+    using PltfAcc = alpaka::pltf::Pltf<DevAcc>;
+    using QueueAcc = alpaka::test::queue::DefaultQueue<DevAcc>;
+
+#ifdef ALPAKA_CI
+    std::uint32_t const launchCount = 100u;
+#else
+    std::uint32_t const launchCount = 1000u;
+#endif
+
+    auto const devAcc(
+        alpaka::pltf::getDevByIdx<PltfAcc>(0u));
+    QueueAcc queue(devAcc);
+
+    auto const blockThreadCountMax(
+        alpaka::acc::getAccDevProps<TAcc>(devAcc).m_blockThreadCountMax);
+
+    auto bufAcc(alpaka::mem::buf::alloc<std::uint32_t, Idx>(devAcc, static_cast<Idx>(1u)));
+    alpaka::mem::view::set(queue, bufAcc, 0u, static_cast<Idx>(1u));
+
+    EmptyKernel kernel;
+
+    for(auto const blockThreadCount : {static_cast<Idx>(1u), static_cast<Idx>(8u), static_cast<Idx>(64u)})
+    {
+        if(blockThreadCount > blockThreadCountMax)
+        {
+            std::cout
+                << "kernelLaunch(" << alpaka::acc::getAccName<TAcc>()
+                << ", blockThreadCount: " << blockThreadCount
+                << ") skipped: more threads than supported by the accelerator" << std::endl;
+            continue;
+        }
+
+        alpaka::workdiv::WorkDivMembers<Dim, Idx> const workDiv(
+            alpaka::vec::Vec<Dim, Idx>::ones(),
+            alpaka::vec::Vec<Dim, Idx>::all(blockThreadCount),
+            alpaka::vec::Vec<Dim, Idx>::ones());
+
+        auto const taskKernel(alpaka::kernel::createTaskKernel<TAcc>(
+            workDiv,
+            kernel,
+            alpaka::mem::view::getPtrNative(bufAcc)));
+
+        // Warm up so that one-time initialization is not part of the measurement.
+        alpaka::queue::enqueue(queue, taskKernel);
+        alpaka::wait::wait(queue);
+
+        auto const tpStart(std::chrono::high_resolution_clock::now());
+        for(std::uint32_t i(0u); i < launchCount; ++i)
+        {
+            alpaka::queue::enqueue(queue, taskKernel);
+            alpaka::wait::wait(queue);
+        }
+        auto const tpEnd(std::chrono::high_resolution_clock::now());
+
+        auto const durUs(std::chrono::duration_cast<std::chrono::microseconds>(tpEnd - tpStart).count());
+
+        std::cout
+            << "kernelLaunch(" << alpaka::acc::getAccName<TAcc>()
+            << ", blockThreadCount: " << blockThreadCount
+            << ", launches: " << launchCount
+            << ") latency: " << static_cast<double>(durUs) / static_cast<double>(launchCount) << " us" << std::endl;
+    }
+
+    auto bufHost(alpaka::mem::buf::alloc<std::uint32_t, Idx>(alpaka::pltf::getDevByIdx<alpaka::pltf::PltfCpu>(0u), static_cast<Idx>(1u)));
+    alpaka::mem::view::copy(queue, bufHost, bufAcc, static_cast<Idx>(1u));
+    alpaka::wait::wait(queue);
+
+    REQUIRE(*alpaka::mem::view::getPtrNative(bufHost) > 0u);
+}
+};
+
+TEST_CASE( "kernelLaunchLatency", "[benchmark]")
+{
+    using TestAccs = alpaka::test::acc::EnabledAccs<
+        alpaka::dim::DimInt<1u>,
+        std::size_t>;
+
+    alpaka::meta::forEachType< TestAccs >( TestTemplate() );
+}
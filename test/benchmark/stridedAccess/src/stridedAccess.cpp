@@ -0,0 +1,98 @@
+/* Copyright 2019 Benjamin Worpitz
+ *
+ * This file is part of Alpaka.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <alpaka/mem/alloc/AllocCpuHugePages.hpp>
+#include <alpaka/dev/DevCpu.hpp>
+#include <alpaka/dim/DimArithmetic.hpp>
+#include <alpaka/mem/buf/BufCpu.hpp>
+#include <alpaka/pltf/PltfCpu.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <string>
+
+namespace
+{
+    using Elem = std::size_t;
+    using Idx = std::size_t;
+
+#ifdef ALPAKA_CI
+    std::size_t const bufferBytes = std::size_t(64u) << 20u;
+    std::size_t const passCount = 1u;
+#else
+    std::size_t const bufferBytes = std::size_t(512u) << 20u;
+    std::size_t const passCount = 4u;
+#endif
+    // Each access hits a different 4 KiB page, so nearly every access misses the TLB when the buffer is backed by small pages.
+    std::size_t const strideBytes = 4096u + 64u;
+
+    //-----------------------------------------------------------------------------
+    auto getName(
+        alpaka::mem::alloc::HugePages const hugePages)
+    -> std::string
+    {
+        switch(hugePages)
+        {
+        case alpaka::mem::alloc::HugePages::Disabled: return "disabled";
+        case alpaka::mem::alloc::HugePages::Transparent: return "transparent";
+        case alpaka::mem::alloc::HugePages::HugeTlb: return "hugetlb";
+        }
+        return "unknown";
+    }
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE( "stridedAccessBandwidth", "[benchmark]")
+{
+    auto const dev(alpaka::pltf::getDevByIdx<alpaka::pltf::PltfCpu>(0u));
+    Idx const elementCount(bufferBytes / sizeof(Elem));
+    Idx const strideElements(strideBytes / sizeof(Elem));
+
+    for(auto const hugePages : {alpaka::mem::alloc::HugePages::Disabled, alpaka::mem::alloc::HugePages::Transparent, alpaka::mem::alloc::HugePages::HugeTlb})
+    {
+        auto buf(alpaka::mem::buf::cpu::alloc<Elem, Idx>(dev, elementCount, hugePages));
+        auto const pBuf(alpaka::mem::view::getPtrNative(buf));
+        REQUIRE(nullptr != pBuf);
+
+        // Touch all pages before the measurement so that page faults are not measured.
+        for(Idx i(0u); i < elementCount; ++i)
+        {
+            pBuf[i] = i;
+        }
+
+        Elem sum(0u);
+        auto const tpStart(std::chrono::high_resolution_clock::now());
+        for(std::size_t pass(0u); pass < passCount; ++pass)
+        {
+            for(Idx offset(0u); offset < strideElements; ++offset)
+            {
+                for(Idx i(offset); i < elementCount; i += strideElements)
+                {
+                    sum += pBuf[i];
+                }
+            }
+        }
+        auto const tpEnd(std::chrono::high_resolution_clock::now());
+
+        auto const durUs(std::chrono::duration_cast<std::chrono::microseconds>(tpEnd - tpStart).count());
+        auto const accessCount(passCount * elementCount);
+
+        std::cout
+            << "stridedAccess(hugePages: " << getName(hugePages)
+            << ", bytes: " << bufferBytes
+            << ", strideBytes: " << strideBytes
+            << ") time per access: " << static_cast<double>(durUs) * 1000.0 / static_cast<double>(accessCount) << " ns" << std::endl;
+
+        // Every element is read once per pass.
+        REQUIRE(passCount * (elementCount * (elementCount - 1u) / 2u) == sum);
+    }
+}
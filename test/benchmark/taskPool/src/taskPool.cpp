@@ -0,0 +1,115 @@
+/* Copyright 2019 Benjamin Worpitz
+ *
+ * This file is part of Alpaka.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <alpaka/core/ConcurrentExecPool.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <future>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    using ThreadPool = alpaka::core::detail::ConcurrentExecPool<
+        std::size_t,
+        std::thread,
+        std::promise,
+        void,
+        std::mutex,
+        std::condition_variable,
+        false,
+        alpaka::core::detail::WorkStealingQueue>;
+
+    using Latch = alpaka::core::detail::TaskLatch<
+        std::mutex,
+        std::condition_variable>;
+
+#ifdef ALPAKA_CI
+    std::size_t const taskCount = 10000u;
+#else
+    std::size_t const taskCount = 1000000u;
+#endif
+    // The tasks are submitted in batches like the threads of a block.
+    std::size_t const batchSize = 64u;
+
+    //-----------------------------------------------------------------------------
+    auto printThroughput(
+        std::string const & variant,
+        std::size_t const workerCount,
+        std::chrono::high_resolution_clock::time_point const & tpStart)
+    -> void
+    {
+        auto const tpEnd(std::chrono::high_resolution_clock::now());
+        auto const durUs(std::chrono::duration_cast<std::chrono::microseconds>(tpEnd - tpStart).count());
+
+        std::cout
+            << "taskPool(" << variant
+            << ", workers: " << workerCount
+            << ", tasks: " << taskCount
+            << ") throughput: " << static_cast<double>(taskCount) / static_cast<double>(durUs) << " tasks/us" << std::endl;
+    }
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE( "taskPoolEnqueueDequeueThroughput", "[benchmark]")
+{
+    for(std::size_t const workerCount : {1u, 4u})
+    {
+        ThreadPool pool(workerCount);
+
+        {
+            std::atomic<std::size_t> runCount(0u);
+            std::vector<std::future<void>> futures;
+            futures.reserve(batchSize);
+
+            auto const tpStart(std::chrono::high_resolution_clock::now());
+            for(std::size_t i(0u); i < taskCount; i += batchSize)
+            {
+                for(std::size_t j(0u); j < batchSize; ++j)
+                {
+                    futures.emplace_back(pool.enqueueTask([&runCount](){++runCount;}));
+                }
+                for(auto & future : futures)
+                {
+                    future.wait();
+                }
+                futures.clear();
+            }
+            printThroughput("future", workerCount, tpStart);
+
+            REQUIRE(runCount.load() >= taskCount);
+        }
+
+        {
+            std::atomic<std::size_t> runCount(0u);
+            Latch latch;
+
+            auto const tpStart(std::chrono::high_resolution_clock::now());
+            for(std::size_t i(0u); i < taskCount; i += batchSize)
+            {
+                for(std::size_t j(0u); j < batchSize; ++j)
+                {
+                    pool.enqueueTaskWithLatch(latch, [&runCount](){++runCount;});
+                }
+                latch.wait();
+            }
+            printThroughput("latch", workerCount, tpStart);
+
+            REQUIRE(runCount.load() >= taskCount);
+        }
+    }
+}
@@ -0,0 +1,114 @@
+/* Copyright 2019 Benjamin Worpitz
+ *
+ * This file is part of Alpaka.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <alpaka/atomic/AtomicStdLibLockFree.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+TEST_CASE( "atomicStdLibLockFreeIntegralOperations", "[atomic]")
+{
+    alpaka::atomic::AtomicStdLibLockFree<16> const atomic{};
+
+    int operand(32);
+    CHECK(32 == alpaka::atomic::atomicOp<alpaka::atomic::op::Add>(atomic, &operand, 4));
+    CHECK(36 == operand);
+    CHECK(36 == alpaka::atomic::atomicOp<alpaka::atomic::op::Sub>(atomic, &operand, 4));
+    CHECK(32 == operand);
+    CHECK(32 == alpaka::atomic::atomicOp<alpaka::atomic::op::Min>(atomic, &operand, 4));
+    CHECK(4 == operand);
+    CHECK(4 == alpaka::atomic::atomicOp<alpaka::atomic::op::Max>(atomic, &operand, 2));
+    CHECK(4 == operand);
+    CHECK(4 == alpaka::atomic::atomicOp<alpaka::atomic::op::Max>(atomic, &operand, 8));
+    CHECK(8 == operand);
+    CHECK(8 == alpaka::atomic::atomicOp<alpaka::atomic::op::Exch>(atomic, &operand, 3));
+    CHECK(3 == operand);
+    CHECK(3 == alpaka::atomic::atomicOp<alpaka::atomic::op::And>(atomic, &operand, 1));
+    CHECK(1 == operand);
+    CHECK(1 == alpaka::atomic::atomicOp<alpaka::atomic::op::Or>(atomic, &operand, 6));
+    CHECK(7 == operand);
+    CHECK(7 == alpaka::atomic::atomicOp<alpaka::atomic::op::Xor>(atomic, &operand, 5));
+    CHECK(2 == operand);
+    CHECK(2 == alpaka::atomic::atomicOp<alpaka::atomic::op::Inc>(atomic, &operand, 2));
+    CHECK(0 == operand);
+    CHECK(0 == alpaka::atomic::atomicOp<alpaka::atomic::op::Dec>(atomic, &operand, 2));
+    CHECK(2 == operand);
+    // The compare value does not match.
+    CHECK(2 == alpaka::atomic::atomicOp<alpaka::atomic::op::Cas>(atomic, &operand, 5, 9));
+    CHECK(2 == operand);
+    CHECK(2 == alpaka::atomic::atomicOp<alpaka::atomic::op::Cas>(atomic, &operand, 2, 9));
+    CHECK(9 == operand);
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE( "atomicStdLibLockFreeFloatingPointOperations", "[atomic]")
+{
+    alpaka::atomic::AtomicStdLibLockFree<16> const atomic{};
+
+    double operand(32.0);
+    CHECK(Approx(32.0) == alpaka::atomic::atomicOp<alpaka::atomic::op::Add>(atomic, &operand, 0.5));
+    CHECK(Approx(32.5) == operand);
+    CHECK(Approx(32.5) == alpaka::atomic::atomicOp<alpaka::atomic::op::Max>(atomic, &operand, 64.0));
+    CHECK(Approx(64.0) == operand);
+    CHECK(Approx(64.0) == alpaka::atomic::atomicOp<alpaka::atomic::op::Exch>(atomic, &operand, 1.0));
+    CHECK(Approx(1.0) == operand);
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE( "atomicStdLibLockFreeFallsBackToLocksForLargeTypes", "[atomic]")
+{
+    alpaka::atomic::AtomicStdLibLockFree<16> const atomic{};
+
+    long double operand(32.0L);
+    CHECK(Approx(32.0L) == alpaka::atomic::atomicOp<alpaka::atomic::op::Add>(atomic, &operand, 4.0L));
+    CHECK(Approx(36.0L) == operand);
+    CHECK(Approx(36.0L) == alpaka::atomic::atomicOp<alpaka::atomic::op::Exch>(atomic, &operand, 2.0L));
+    CHECK(Approx(2.0L) == operand);
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE( "atomicStdLibLockFreeConcurrentOperations", "[atomic]")
+{
+    alpaka::atomic::AtomicStdLibLockFree<16> const atomic{};
+
+    std::size_t const threadCount(4u);
+    std::size_t const opCount(10000u);
+
+    std::size_t sum(0u);
+    float sumFloat(0.0f);
+    std::size_t max(0u);
+
+    std::vector<std::thread> threads;
+    for(std::size_t t(0u); t < threadCount; ++t)
+    {
+        threads.emplace_back(
+            [&, t]()
+            {
+                for(std::size_t i(0u); i < opCount; ++i)
+                {
+                    alpaka::atomic::atomicOp<alpaka::atomic::op::Add>(atomic, &sum, static_cast<std::size_t>(1u));
+                    alpaka::atomic::atomicOp<alpaka::atomic::op::Add>(atomic, &sumFloat, 1.0f);
+                    alpaka::atomic::atomicOp<alpaka::atomic::op::Max>(atomic, &max, t * opCount + i);
+                }
+            });
+    }
+    for(auto & thread : threads)
+    {
+        thread.join();
+    }
+
+    CHECK(threadCount * opCount == sum);
+    // All partial sums are exactly representable.
+    CHECK(Approx(static_cast<float>(threadCount * opCount)) == sumFloat);
+    CHECK(threadCount * opCount - 1u == max);
+}
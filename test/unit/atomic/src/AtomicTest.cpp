@@ -15,6 +15,7 @@
 #include <catch2/catch.hpp>
 
 #include <climits>
+#include <type_traits>
 
 //-----------------------------------------------------------------------------
 ALPAKA_NO_HOST_ACC_WARNING
@@ -976,3 +977,38 @@ TEST_CASE( "atomicOperationsWorking", "[atomic]")
 
     alpaka::meta::forEachType< TestAccs >( TestTemplate() );
 }
+
+//-----------------------------------------------------------------------------
+//! Atomics between the threads of a block are plain read-modify-write operations on accelerators with a single thread per block.
+template<
+    typename TAcc,
+    typename TBlockAtomic>
+auto checkSingleThreadBlockAtomics()
+-> void
+{
+    using AtomicHierarchy = typename TAcc::UsedAtomicHierarchies;
+    static_assert(
+        std::is_same<typename alpaka::atomic::traits::AtomicBase<AtomicHierarchy, alpaka::hierarchy::Threads>::type, alpaka::atomic::AtomicNoOp>::value,
+        "Atomics between threads should not be synchronized on accelerators with a single thread per block!");
+    static_assert(
+        std::is_same<typename alpaka::atomic::traits::AtomicBase<AtomicHierarchy, alpaka::hierarchy::Blocks>::type, TBlockAtomic>::value,
+        "Unexpected atomic implementation for atomics between blocks!");
+}
+
+TEST_CASE( "atomicHierarchySingleThreadBlocks", "[atomic]")
+{
+    using Dim = alpaka::dim::DimInt<1u>;
+    using Idx = std::size_t;
+
+#ifdef ALPAKA_ACC_CPU_B_SEQ_T_SEQ_ENABLED
+    // Only a single block is executed at a time.
+    checkSingleThreadBlockAtomics<alpaka::acc::AccCpuSerial<Dim, Idx>, alpaka::atomic::AtomicNoOp>();
+#endif
+#ifdef ALPAKA_ACC_CPU_B_OMP2_T_SEQ_ENABLED
+    checkSingleThreadBlockAtomics<alpaka::acc::AccCpuOmp2Blocks<Dim, Idx>, alpaka::atomic::AtomicStdLibLockFree<ALPAKA_ATOMIC_STDLIB_LOCK_HASH_TABLE_SIZE>>();
+#endif
+#ifdef ALPAKA_ACC_CPU_B_TBB_T_SEQ_ENABLED
+    checkSingleThreadBlockAtomics<alpaka::acc::AccCpuTbbBlocks<Dim, Idx>, alpaka::atomic::AtomicStdLibLockFree<ALPAKA_ATOMIC_STDLIB_LOCK_HASH_TABLE_SIZE>>();
+#endif
+    alpaka::ignore_unused(Dim(), Idx());
+}
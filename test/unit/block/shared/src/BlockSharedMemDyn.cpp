@@ -8,6 +8,7 @@
  */
 
 #include <alpaka/block/shared/dyn/Traits.hpp>
+#include <alpaka/block/shared/dyn/BlockSharedMemDynBoostAlignedAlloc.hpp>
 
 #include <alpaka/test/acc/TestAccs.hpp>
 #include <alpaka/test/queue/Queue.hpp>
@@ -15,6 +16,8 @@
 
 #include <catch2/catch.hpp>
 
+#include <thread>
+
 //#############################################################################
 class BlockSharedMemDynTestKernel
 {
@@ -101,3 +104,82 @@ TEST_CASE( "sameNonNullAdress", "[blockSharedMemDyn]")
 {
     alpaka::meta::forEachType< alpaka::test::acc::TestAccs >( TestTemplate() );
 }
+
+TEST_CASE( "cacheReusesAndGrowsBuffers", "[blockSharedMemDyn]")
+{
+    alpaka::block::shared::dyn::detail::BlockSharedMemDynCache cache;
+
+    auto buffer(cache.acquire(64u));
+    auto const * const pMem(buffer.m_pMem.get());
+    REQUIRE(nullptr != pMem);
+    CHECK(64u == buffer.m_sizeBytes);
+    cache.release(std::move(buffer));
+
+    // A smaller or equal request reuses the cached buffer.
+    auto bufferReused(cache.acquire(32u));
+    CHECK(pMem == bufferReused.m_pMem.get());
+    CHECK(64u == bufferReused.m_sizeBytes);
+    cache.release(std::move(bufferReused));
+
+    // A larger request grows the buffer.
+    auto bufferGrown(cache.acquire(128u));
+    REQUIRE(nullptr != bufferGrown.m_pMem.get());
+    CHECK(128u == bufferGrown.m_sizeBytes);
+    cache.release(std::move(bufferGrown));
+}
+
+TEST_CASE( "cacheFreesBuffersAboveTheByteLimit", "[blockSharedMemDyn]")
+{
+    alpaka::block::shared::dyn::detail::BlockSharedMemDynCache cache;
+    std::size_t const cachedBytesMax(std::size_t(1u) << 20u);
+
+    // A buffer larger than the limit is not kept.
+    auto bufferHuge(cache.acquire(cachedBytesMax + 1u));
+    REQUIRE(nullptr != bufferHuge.m_pMem.get());
+    cache.release(std::move(bufferHuge));
+    CHECK(0u == cache.getCachedBytes());
+
+    // Smaller buffers are dropped to make room for a larger one.
+    auto bufferSmall(cache.acquire(cachedBytesMax / 4u));
+    auto bufferLarge(cache.acquire(cachedBytesMax));
+    cache.release(std::move(bufferSmall));
+    CHECK(cachedBytesMax / 4u == cache.getCachedBytes());
+    cache.release(std::move(bufferLarge));
+    CHECK(cachedBytesMax == cache.getCachedBytes());
+
+    auto bufferReused(cache.acquire(cachedBytesMax));
+    CHECK(0u == cache.getCachedBytes());
+    cache.release(std::move(bufferReused));
+}
+
+#ifdef ALPAKA_ACC_CPU_B_SEQ_T_THREADS_ENABLED
+TEST_CASE( "launchFromShortLivedThread", "[blockSharedMemDyn]")
+{
+    using Dim = alpaka::dim::DimInt<1u>;
+    using Idx = std::size_t;
+    using Acc = alpaka::acc::AccCpuThreads<Dim, Idx>;
+    using Vec = alpaka::vec::Vec<Dim, Idx>;
+
+    // The block slots and the block shared dynamic memory cache of the launching thread are destroyed when it exits.
+    bool success(true);
+    std::thread thread(
+        [&success]()
+        {
+            auto const dev(alpaka::pltf::getDevByIdx<alpaka::pltf::PltfCpu>(0u));
+            alpaka::queue::QueueCpuBlocking queue(dev);
+            alpaka::workdiv::WorkDivMembers<Dim, Idx> const workDiv(
+                Vec(static_cast<Idx>(2u)),
+                Vec(static_cast<Idx>(4u)),
+                Vec(static_cast<Idx>(16u)));
+            alpaka::queue::enqueue(
+                queue,
+                alpaka::kernel::createTaskKernel<Acc>(
+                    workDiv,
+                    BlockSharedMemDynTestKernel(),
+                    &success));
+        });
+    thread.join();
+
+    CHECK(success);
+}
+#endif
@@ -142,6 +142,143 @@ void operator()()
 }
 };
 
+//#############################################################################
+class BlockSharedMemStSharedBetweenThreadsTestKernel
+{
+public:
+    //-----------------------------------------------------------------------------
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc>
+    ALPAKA_FN_ACC auto operator()(
+        TAcc const & acc,
+        bool * success) const
+    -> void
+    {
+        using Idx = alpaka::idx::Idx<TAcc>;
+
+        auto const blockThreadIdx(
+            alpaka::idx::mapIdx<1u>(
+                alpaka::idx::getIdx<alpaka::Block, alpaka::Threads>(acc),
+                alpaka::workdiv::getWorkDiv<alpaka::Block, alpaka::Threads>(acc))[0u]);
+        auto const blockThreadCount(
+            alpaka::workdiv::getWorkDiv<alpaka::Block, alpaka::Threads>(acc).prod());
+
+        // Multiple runs to make sure that the same memory is returned for the same variable.
+        for(std::uint32_t i=0u; i<3u; ++i)
+        {
+            // The variables are large enough to exceed the initial size of an arena based allocator.
+            auto && a = alpaka::block::shared::st::allocVar<alpaka::test::Array<std::uint32_t, 4096>, __COUNTER__>(acc);
+            auto && b = alpaka::block::shared::st::allocVar<alpaka::test::Array<std::uint32_t, 4096>, __COUNTER__>(acc);
+            ALPAKA_CHECK(*success, &a[0] != &b[0]);
+
+            a[blockThreadIdx] = static_cast<std::uint32_t>(blockThreadIdx) + i;
+            b[blockThreadIdx] = static_cast<std::uint32_t>(blockThreadIdx) * 2u + i;
+            alpaka::block::sync::syncBlockThreads(acc);
+
+            for(Idx t(0u); t < blockThreadCount; ++t)
+            {
+                ALPAKA_CHECK(*success, static_cast<std::uint32_t>(t) + i == a[t]);
+                ALPAKA_CHECK(*success, static_cast<std::uint32_t>(t) * 2u + i == b[t]);
+            }
+            alpaka::block::sync::syncBlockThreads(acc);
+        }
+    }
+};
+
+//-----------------------------------------------------------------------------
+struct TestTemplateSharedBetweenThreads
+{
+template< typename TAcc >
+void operator()()
+{
+    using Dim = alpaka::dim::Dim<TAcc>;
+    using Idx = alpaka::idx::Idx<TAcc>;
+
+    // Use multiple threads and blocks to make sure the memory is shared within a block and reused across blocks.
+    alpaka::test::KernelExecutionFixture<TAcc> fixture(
+        alpaka::vec::Vec<Dim, Idx>::all(static_cast<Idx>(4u)));
+
+    BlockSharedMemStSharedBetweenThreadsTestKernel kernel;
+
+    REQUIRE(fixture(kernel));
+}
+};
+
+//-----------------------------------------------------------------------------
+//! Allocates a variable with the same id for all types the helper is instantiated with.
+ALPAKA_NO_HOST_ACC_WARNING
+template<
+    typename T,
+    typename TAcc>
+ALPAKA_FN_ACC auto allocHelperVar(
+    TAcc const & acc)
+-> T &
+{
+    return alpaka::block::shared::st::allocVar<T, __COUNTER__>(acc);
+}
+
+//#############################################################################
+class BlockSharedMemStHelperWithDifferentTypesTestKernel
+{
+public:
+    //-----------------------------------------------------------------------------
+    ALPAKA_NO_HOST_ACC_WARNING
+    template<
+        typename TAcc>
+    ALPAKA_FN_ACC auto operator()(
+        TAcc const & acc,
+        bool * success) const
+    -> void
+    {
+        auto const blockThreadIdx(
+            alpaka::idx::mapIdx<1u>(
+                alpaka::idx::getIdx<alpaka::Block, alpaka::Threads>(acc),
+                alpaka::workdiv::getWorkDiv<alpaka::Block, alpaka::Threads>(acc))[0u]);
+
+        // Multiple runs to make sure that the same memory is returned for the same type.
+        for(std::uint32_t i=0u; i<3u; ++i)
+        {
+            auto && a = allocHelperVar<std::uint32_t>(acc);
+            auto && b = allocHelperVar<std::uint64_t>(acc);
+            ALPAKA_CHECK(*success, static_cast<void *>(&a) != static_cast<void *>(&b));
+            ALPAKA_CHECK(*success, &a == &allocHelperVar<std::uint32_t>(acc));
+            ALPAKA_CHECK(*success, &b == &allocHelperVar<std::uint64_t>(acc));
+
+            if(blockThreadIdx == 0u)
+            {
+                a = 0xfffffff0u + i;
+                b = 0x0123456789abcdefu + i;
+            }
+            alpaka::block::sync::syncBlockThreads(acc);
+
+            // The variables do not overlap.
+            ALPAKA_CHECK(*success, 0xfffffff0u + i == a);
+            ALPAKA_CHECK(*success, 0x0123456789abcdefu + i == b);
+            alpaka::block::sync::syncBlockThreads(acc);
+        }
+    }
+};
+
+//-----------------------------------------------------------------------------
+struct TestTemplateHelperWithDifferentTypes
+{
+template< typename TAcc >
+void operator()()
+{
+    using Dim = alpaka::dim::Dim<TAcc>;
+    using Idx = alpaka::idx::Idx<TAcc>;
+
+    // Use multiple threads and blocks to make sure the variables are shared within a block.
+    alpaka::test::KernelExecutionFixture<TAcc> fixture(
+        alpaka::vec::Vec<Dim, Idx>::all(static_cast<Idx>(4u)));
+
+    BlockSharedMemStHelperWithDifferentTypesTestKernel kernel;
+
+    REQUIRE(fixture(kernel));
+}
+};
+
 TEST_CASE( "nonNull", "[blockSharedMemSt]")
 {
     alpaka::meta::forEachType< alpaka::test::acc::TestAccs >( TestTemplateNonNull() );
@@ -151,3 +288,13 @@ TEST_CASE( "sameTypeDifferentAddress", "[blockSharedMemSt]")
 {
     alpaka::meta::forEachType< alpaka::test::acc::TestAccs >( TestTemplateDiffAddress() );
 }
+
+TEST_CASE( "sharedBetweenThreads", "[blockSharedMemSt]")
+{
+    alpaka::meta::forEachType< alpaka::test::acc::TestAccs >( TestTemplateSharedBetweenThreads() );
+}
+
+TEST_CASE( "helperWithDifferentTypes", "[blockSharedMemSt]")
+{
+    alpaka::meta::forEachType< alpaka::test::acc::TestAccs >( TestTemplateHelperWithDifferentTypes() );
+}
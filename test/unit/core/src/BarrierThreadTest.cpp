@@ -0,0 +1,127 @@
+/* Copyright 2019 Benjamin Worpitz
+ *
+ * This file is part of Alpaka.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <alpaka/core/BarrierThread.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+//! Checks that no thread leaves a barrier before all threads have entered it.
+static auto testBarrierThreadPhases(
+    std::uint32_t const spinCount)
+-> void
+{
+    std::size_t const threadCount(4u);
+    std::size_t const phaseCount(200u);
+
+    alpaka::core::threads::BarrierThread<std::size_t> barrier(threadCount, spinCount);
+    std::atomic<std::size_t> arrivedCount(0u);
+    std::atomic<bool> bPhaseError(false);
+
+    std::vector<std::thread> threads;
+    for(std::size_t t(0u); t < threadCount; ++t)
+    {
+        threads.emplace_back(
+            [&]()
+            {
+                for(std::size_t phase(0u); phase < phaseCount; ++phase)
+                {
+                    ++arrivedCount;
+                    barrier.wait();
+                    // All threads of this phase have to have arrived and none can arrive again before the second barrier.
+                    if(arrivedCount.load() != (phase + 1u) * threadCount)
+                    {
+                        bPhaseError = true;
+                    }
+                    barrier.wait();
+                }
+            });
+    }
+    for(auto & thread : threads)
+    {
+        thread.join();
+    }
+
+    CHECK(!bPhaseError.load());
+    CHECK(threadCount * phaseCount == arrivedCount.load());
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE("barrierThreadWithoutSpinning", "[core]")
+{
+    testBarrierThreadPhases(0u);
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE("barrierThreadWithSpinning", "[core]")
+{
+    testBarrierThreadPhases(1000000u);
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE("barrierThreadSpinCountIsConfigurable", "[core]")
+{
+    auto const spinCountDefault(alpaka::core::threads::getBarrierSpinCount());
+
+    alpaka::core::threads::setBarrierSpinCount(42u);
+    CHECK(42u == alpaka::core::threads::getBarrierSpinCount());
+
+    alpaka::core::threads::setBarrierSpinCount(spinCountDefault);
+    CHECK(spinCountDefault == alpaka::core::threads::getBarrierSpinCount());
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE("barrierThreadWithPredicateLockFreeReducesEachGeneration", "[core]")
+{
+    std::size_t const threadCount(4u);
+    std::size_t const phaseCount(200u);
+
+    alpaka::core::threads::BarrierThreadWithPredicate<std::size_t> barrier(threadCount);
+    std::atomic<bool> bResultError(false);
+
+    std::vector<std::thread> threads;
+    for(std::size_t t(0u); t < threadCount; ++t)
+    {
+        threads.emplace_back(
+            [&, t]()
+            {
+                for(std::size_t phase(0u); phase < phaseCount; ++phase)
+                {
+                    // The first (phase % (threadCount + 1)) threads have a true predicate.
+                    std::size_t const trueCount(phase % (threadCount + 1u));
+                    int const predicate(t < trueCount ? 1 : 0);
+
+                    // Different operations on consecutive barriers use both result slots with all operations.
+                    if(barrier.wait<alpaka::block::sync::op::Count>(predicate) != static_cast<int>(trueCount))
+                    {
+                        bResultError = true;
+                    }
+                    if(barrier.wait<alpaka::block::sync::op::LogicalAnd>(predicate) != static_cast<int>(trueCount == threadCount))
+                    {
+                        bResultError = true;
+                    }
+                    if(barrier.wait<alpaka::block::sync::op::LogicalOr>(predicate) != static_cast<int>(trueCount != 0u))
+                    {
+                        bResultError = true;
+                    }
+                }
+            });
+    }
+    for(auto & thread : threads)
+    {
+        thread.join();
+    }
+
+    CHECK(!bResultError.load());
+}
@@ -0,0 +1,105 @@
+/* Copyright 2019 Benjamin Worpitz
+ *
+ * This file is part of Alpaka.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <alpaka/core/ConcurrentExecPool.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <future>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+namespace
+{
+    using ThreadPool = alpaka::core::detail::ConcurrentExecPool<
+        std::size_t,
+        std::thread,
+        std::promise,
+        void,
+        std::mutex,
+        std::condition_variable,
+        false>;
+
+    using Latch = alpaka::core::detail::TaskLatch<
+        std::mutex,
+        std::condition_variable>;
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE(
+    "concurrentExecPoolLatchWaitsForAllTasks", "[core]")
+{
+    ThreadPool pool(2u);
+    Latch latch;
+
+    std::atomic<std::size_t> runCount(0u);
+
+    // The latch is reused for multiple rounds.
+    for(std::size_t round(1u); round <= 10u; ++round)
+    {
+        for(std::size_t i(0u); i < 100u; ++i)
+        {
+            pool.enqueueTaskWithLatch(latch, [&runCount](){++runCount;});
+        }
+        latch.wait();
+
+        CHECK(round * 100u == runCount.load());
+    }
+
+    CHECK(pool.isIdle());
+    CHECK(!latch.takeException());
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE(
+    "concurrentExecPoolLatchStoresFunctionObjectsLargerThanTheInlineStorage", "[core]")
+{
+    ThreadPool pool(2u);
+    Latch latch;
+
+    std::array<std::size_t, 2u * alpaka::core::detail::PooledTaskPkg::inlineStorageSize> values;
+    values.fill(1u);
+    std::atomic<std::size_t> sum(0u);
+
+    pool.enqueueTaskWithLatch(
+        latch,
+        [values, &sum]()
+        {
+            for(auto const & value : values)
+            {
+                sum += value;
+            }
+        });
+    latch.wait();
+
+    CHECK(values.size() == sum.load());
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE(
+    "concurrentExecPoolLatchReceivesTheException", "[core]")
+{
+    ThreadPool pool(1u);
+    Latch latch;
+
+    pool.enqueueTaskWithLatch(latch, [](){throw std::runtime_error("task failed");});
+    pool.enqueueTaskWithLatch(latch, [](){});
+    latch.wait();
+
+    auto const exceptPtr(latch.takeException());
+    REQUIRE(exceptPtr);
+    CHECK_THROWS_AS(std::rethrow_exception(exceptPtr), std::runtime_error);
+    // The exception has been handed over and is not reported again.
+    CHECK(!latch.takeException());
+}
@@ -0,0 +1,61 @@
+/* Copyright 2019 Benjamin Worpitz
+ *
+ * This file is part of Alpaka.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <alpaka/core/SpinLock.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+TEST_CASE( "spinLockTryLock", "[core]")
+{
+    alpaka::core::threads::SpinLock spinLock;
+
+    REQUIRE(spinLock.try_lock());
+    CHECK(!spinLock.try_lock());
+    spinLock.unlock();
+    CHECK(spinLock.try_lock());
+    spinLock.unlock();
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE( "spinLockMutualExclusion", "[core]")
+{
+    // More threads than hardware threads force the waiting threads to be parked.
+    std::size_t const threadCount(std::thread::hardware_concurrency() + 4u);
+    std::size_t const incrementCount(10000u);
+
+    alpaka::core::threads::SpinLock spinLock;
+    // The non-atomic read-modify-write loses increments if the lock does not exclude concurrent access.
+    std::size_t counter(0u);
+
+    std::vector<std::thread> threads;
+    for(std::size_t t(0u); t < threadCount; ++t)
+    {
+        threads.emplace_back(
+            [&]()
+            {
+                for(std::size_t i(0u); i < incrementCount; ++i)
+                {
+                    std::lock_guard<alpaka::core::threads::SpinLock> lock(spinLock);
+                    counter = counter + 1u;
+                }
+            });
+    }
+    for(auto & thread : threads)
+    {
+        thread.join();
+    }
+
+    CHECK(threadCount * incrementCount == counter);
+}
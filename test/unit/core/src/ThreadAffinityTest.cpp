@@ -0,0 +1,250 @@
+/* Copyright 2019 Benjamin Worpitz
+ *
+ * This file is part of Alpaka.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <alpaka/core/ThreadAffinity.hpp>
+#include <alpaka/core/ConcurrentExecPool.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    using ThreadPool = alpaka::core::detail::ConcurrentExecPool<
+        std::size_t,
+        std::thread,
+        std::promise,
+        void,
+        std::mutex,
+        std::condition_variable,
+        false>;
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE( "affinityPolicyExplicitShouldAssignTheCpusRoundRobin", "[core]")
+{
+    auto const policy(alpaka::core::threads::AffinityPolicy::explicitCpus({3u, 1u}));
+
+    CHECK(alpaka::core::threads::AffinityPolicy::Kind::Explicit == policy.getKind());
+    CHECK(std::vector<std::uint32_t>{3u} == policy.getWorkerCpus(0u));
+    CHECK(std::vector<std::uint32_t>{1u} == policy.getWorkerCpus(1u));
+    CHECK(std::vector<std::uint32_t>{3u} == policy.getWorkerCpus(2u));
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE( "affinityPolicySliceShouldWrapAroundTheCpus", "[core]")
+{
+    auto const policy(alpaka::core::threads::AffinityPolicy::explicitCpus({3u, 1u, 2u}));
+
+    auto const slice(policy.getSlice(2u, 2u));
+    CHECK(alpaka::core::threads::AffinityPolicy::Kind::Explicit == slice.getKind());
+    CHECK((std::vector<std::uint32_t>{2u, 3u}) == slice.getCpus());
+    CHECK(alpaka::core::threads::AffinityPolicy::inherit() == alpaka::core::threads::AffinityPolicy::inherit().getSlice(1u, 2u));
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE( "affinityPolicyInheritShouldNotPinTheWorkers", "[core]")
+{
+    auto const policy(alpaka::core::threads::AffinityPolicy::inherit());
+
+    CHECK(alpaka::core::threads::AffinityPolicy::Kind::Inherit == policy.getKind());
+    CHECK(policy.getCpus().empty());
+    CHECK(policy.getWorkerCpus(0u).empty());
+    CHECK(policy == alpaka::core::threads::getCurrentAffinityPolicy());
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE( "affinityPolicyCompactAndScatterShouldUseAllGivenCpus", "[core]")
+{
+    std::vector<std::uint32_t> const cpus{0u, 1u, 2u, 3u, 4u, 5u, 6u, 7u};
+
+    auto compactCpus(alpaka::core::threads::AffinityPolicy::compact(cpus).getCpus());
+    auto scatterCpus(alpaka::core::threads::AffinityPolicy::scatter(cpus).getCpus());
+    std::sort(compactCpus.begin(), compactCpus.end());
+    std::sort(scatterCpus.begin(), scatterCpus.end());
+
+    CHECK(cpus == compactCpus);
+    CHECK(cpus == scatterCpus);
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE( "scopedAffinityPolicyShouldRestoreThePreviousPolicy", "[core]")
+{
+    auto const policy(alpaka::core::threads::AffinityPolicy::explicitCpus({0u}));
+    {
+        alpaka::core::threads::ScopedAffinityPolicy const scopedPolicy(policy);
+        CHECK(policy == alpaka::core::threads::getCurrentAffinityPolicy());
+    }
+    CHECK(alpaka::core::threads::AffinityPolicy::Kind::Inherit == alpaka::core::threads::getCurrentAffinityPolicy().getKind());
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE( "hardwareThreadCountShouldFollowTheCpusOfTheAffinityPolicy", "[core]")
+{
+    auto const policy(alpaka::core::threads::AffinityPolicy::explicitCpus({1u, 0u, 1u}));
+    CHECK(2u == policy.getCpuCount());
+    {
+        alpaka::core::threads::ScopedAffinityPolicy const scopedPolicy(policy);
+        CHECK(2u == alpaka::core::threads::getCurrentHardwareThreadCount());
+    }
+
+    // The inherit policy uses the CPUs the calling thread may run on.
+    auto const & inheritedCpus(alpaka::core::threads::getInheritedCpus(alpaka::core::threads::getCurrentAffinityPolicy()));
+    if(!inheritedCpus.empty())
+    {
+        CHECK(inheritedCpus.size() == alpaka::core::threads::getCurrentHardwareThreadCount());
+    }
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE( "pinCurrentThreadWithInheritShouldRestoreTheOriginalCpus", "[core]")
+{
+    auto const availableCpus(alpaka::core::threads::getCurrentThreadAffinity());
+    if(availableCpus.empty())
+    {
+        // The affinity is not supported on this system.
+        return;
+    }
+
+    std::vector<std::uint32_t> pinnedCpus;
+    std::vector<std::uint32_t> restoredCpus;
+    bool bPinnedCpusReset(false);
+
+    // A new thread is used so that the affinity of the test thread stays unchanged.
+    std::thread thread(
+        [&]()
+        {
+            alpaka::core::threads::pinCurrentThread(alpaka::core::threads::AffinityPolicy::explicitCpus({availableCpus.back()}), 0u);
+            pinnedCpus = alpaka::core::threads::getCurrentThreadAffinity();
+            alpaka::core::threads::pinCurrentThread(alpaka::core::threads::AffinityPolicy::inherit(), 0u);
+            restoredCpus = alpaka::core::threads::getCurrentThreadAffinity();
+            bPinnedCpusReset = alpaka::core::threads::detail::pinnedCpus().empty();
+        });
+    thread.join();
+
+    CHECK(std::vector<std::uint32_t>{availableCpus.back()} == pinnedCpus);
+    CHECK(availableCpus == restoredCpus);
+    CHECK(bPinnedCpusReset);
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE( "getInheritedCpusShouldFollowTheChangesOfTheThreadAffinity", "[core]")
+{
+    auto const availableCpus(alpaka::core::threads::getCurrentThreadAffinity());
+    if(availableCpus.empty())
+    {
+        // The affinity is not supported on this system.
+        return;
+    }
+
+    auto const inherit(alpaka::core::threads::AffinityPolicy::inherit());
+    std::vector<std::uint32_t> initialCpus;
+    std::vector<std::uint32_t> pinnedCpus;
+    std::vector<std::uint32_t> explicitCpus;
+
+    // A new thread is used so that the affinity of the test thread stays unchanged.
+    std::thread thread(
+        [&]()
+        {
+            initialCpus = alpaka::core::threads::getInheritedCpus(inherit);
+            alpaka::core::threads::setCurrentThreadAffinity({availableCpus.back()});
+            pinnedCpus = alpaka::core::threads::getInheritedCpus(inherit);
+            explicitCpus = alpaka::core::threads::getInheritedCpus(alpaka::core::threads::AffinityPolicy::explicitCpus({availableCpus.front()}));
+        });
+    thread.join();
+
+    CHECK(availableCpus == initialCpus);
+    CHECK(std::vector<std::uint32_t>{availableCpus.back()} == pinnedCpus);
+    CHECK(explicitCpus.empty());
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE( "concurrentExecPoolShouldPinItsThreads", "[core]")
+{
+    auto const availableCpus(alpaka::core::threads::getCurrentThreadAffinity());
+    if(availableCpus.empty())
+    {
+        // The affinity is not supported on this system.
+        return;
+    }
+
+    // Pin the threads to the last CPU the process is allowed to run on.
+    auto const policy(alpaka::core::threads::AffinityPolicy::explicitCpus({availableCpus.back()}));
+
+    ThreadPool pool(2u);
+    pool.setAffinityPolicy(policy);
+
+    std::vector<std::vector<std::uint32_t>> taskCpus(8u);
+    std::vector<std::future<void>> futures;
+    for(auto & cpus : taskCpus)
+    {
+        futures.emplace_back(pool.enqueueTask([&cpus](){cpus = alpaka::core::threads::getCurrentThreadAffinity();}));
+    }
+    for(auto & future : futures)
+    {
+        future.get();
+    }
+    for(auto const & cpus : taskCpus)
+    {
+        CHECK(policy.getCpus() == cpus);
+    }
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE( "concurrentExecPoolShouldRestrictUnpinnedThreadsToTheInheritedCpus", "[core]")
+{
+    auto const availableCpus(alpaka::core::threads::getCurrentThreadAffinity());
+    if(availableCpus.empty())
+    {
+        // The affinity is not supported on this system.
+        return;
+    }
+
+    ThreadPool pool(2u);
+    auto const getTaskCpus(
+        [&pool]()
+        {
+            std::vector<std::vector<std::uint32_t>> taskCpus(8u);
+            std::vector<std::future<void>> futures;
+            for(auto & cpus : taskCpus)
+            {
+                futures.emplace_back(pool.enqueueTask([&cpus](){cpus = alpaka::core::threads::getCurrentThreadAffinity();}));
+            }
+            for(auto & future : futures)
+            {
+                future.get();
+            }
+            return taskCpus;
+        });
+
+    // Alternate between the CPUs of two launching threads like a pool reused for two devices.
+    auto const pinnedPolicy(alpaka::core::threads::AffinityPolicy::explicitCpus({availableCpus.back()}));
+    auto const inheritPolicy(alpaka::core::threads::AffinityPolicy::inherit());
+    for(auto const & inheritedCpus : {std::vector<std::uint32_t>{availableCpus.front()}, availableCpus, std::vector<std::uint32_t>{availableCpus.back()}, availableCpus})
+    {
+        pool.setAffinityPolicy(pinnedPolicy);
+        for(auto const & cpus : getTaskCpus())
+        {
+            CHECK(pinnedPolicy.getCpus() == cpus);
+        }
+
+        pool.setAffinityPolicy(inheritPolicy, inheritedCpus);
+        for(auto const & cpus : getTaskCpus())
+        {
+            CHECK(inheritedCpus == cpus);
+        }
+    }
+}
@@ -0,0 +1,264 @@
+/* Copyright 2019 Benjamin Worpitz
+ *
+ * This file is part of Alpaka.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <alpaka/core/ConcurrentExecPool.hpp>
+#include <alpaka/core/WorkStealingQueue.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+TEST_CASE(
+    "chaseLevDequeOwnerPopsLifoThiefStealsFifo", "[core]")
+{
+    // The initial capacity is chosen small so that the deque has to grow.
+    alpaka::core::detail::ChaseLevDeque<std::size_t> deque(2u);
+
+    CHECK(deque.empty());
+
+    for(std::size_t i(0u); i < 10u; ++i)
+    {
+        deque.push(i);
+    }
+    CHECK(!deque.empty());
+
+    std::size_t value(0u);
+    REQUIRE(deque.steal(value));
+    CHECK(0u == value);
+    REQUIRE(deque.pop(value));
+    CHECK(9u == value);
+    REQUIRE(deque.steal(value));
+    CHECK(1u == value);
+
+    std::size_t count(0u);
+    while(deque.pop(value))
+    {
+        ++count;
+    }
+    CHECK(7u == count);
+    CHECK(deque.empty());
+    CHECK(!deque.steal(value));
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE(
+    "workStealingQueueSingleWorkerPopsInFifoOrder", "[core]")
+{
+    alpaka::core::detail::WorkStealingQueue<std::size_t> queue;
+    queue.ensureWorkerCount(1u);
+
+    std::size_t value(0u);
+    CHECK(queue.empty());
+    CHECK(!queue.pop(0u, value));
+
+    // More values than fit into a single batch.
+    for(std::size_t i(0u); i < 100u; ++i)
+    {
+        auto valueIn(i);
+        queue.push(std::move(valueIn));
+    }
+    CHECK(!queue.empty());
+
+    for(std::size_t i(0u); i < 100u; ++i)
+    {
+        REQUIRE(queue.pop(0u, value));
+        CHECK(i == value);
+    }
+    CHECK(queue.empty());
+    CHECK(!queue.pop(0u, value));
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE(
+    "workStealingQueueDistributesValuesAndStealsWhenOutOfWork", "[core]")
+{
+    alpaka::core::detail::WorkStealingQueue<std::size_t> queue;
+    queue.ensureWorkerCount(2u);
+
+    // The values are pushed round-robin, so each worker gets two of them.
+    for(std::size_t i(0u); i < 4u; ++i)
+    {
+        auto valueIn(i);
+        queue.push(std::move(valueIn));
+    }
+
+    // The own values are popped without stealing.
+    std::size_t value(0u);
+    REQUIRE(queue.pop(0u, value));
+    REQUIRE(queue.pop(0u, value));
+    CHECK(0u == queue.getStealCount());
+
+    // The first worker is out of work and steals from the second one.
+    REQUIRE(queue.pop(0u, value));
+    CHECK(1u == queue.getStealCount());
+    REQUIRE(queue.pop(1u, value));
+    CHECK(1u == queue.getStealCount());
+
+    CHECK(queue.empty());
+    CHECK(!queue.pop(0u, value));
+    CHECK(!queue.pop(1u, value));
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE(
+    "workStealingQueueDistributesValuesRoundRobinPerQueue", "[core]")
+{
+    alpaka::core::detail::WorkStealingQueue<std::size_t> queueA;
+    queueA.ensureWorkerCount(2u);
+    alpaka::core::detail::WorkStealingQueue<std::size_t> queueB;
+    queueB.ensureWorkerCount(2u);
+
+    // Alternating pushes into the two queues must not skip workers of either queue.
+    for(std::size_t i(0u); i < 4u; ++i)
+    {
+        auto valueA(i);
+        queueA.push(std::move(valueA));
+        auto valueB(i);
+        queueB.push(std::move(valueB));
+    }
+
+    std::size_t value(0u);
+    REQUIRE(queueA.pop(1u, value));
+    CHECK(0u == queueA.getStealCount());
+    REQUIRE(queueB.pop(0u, value));
+    CHECK(0u == queueB.getStealCount());
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE(
+    "workStealingQueueConcurrentPopDeliversEachValueOnce", "[core]")
+{
+    std::size_t const workerCount(4u);
+    std::size_t const valueCount(10000u);
+
+    alpaka::core::detail::WorkStealingQueue<std::size_t> queue;
+    queue.ensureWorkerCount(workerCount);
+
+    for(std::size_t i(0u); i < valueCount; ++i)
+    {
+        auto value(i);
+        queue.push(std::move(value));
+    }
+
+    std::vector<std::atomic<std::size_t>> popCounts(valueCount);
+    for(auto & popCount : popCounts)
+    {
+        popCount = 0u;
+    }
+    std::atomic<std::size_t> popCountTotal(0u);
+
+    std::vector<std::thread> workers;
+    for(std::size_t workerIdx(0u); workerIdx < workerCount; ++workerIdx)
+    {
+        workers.emplace_back(
+            [&, workerIdx]()
+            {
+                std::size_t value(0u);
+                while(popCountTotal.load() < valueCount)
+                {
+                    if(queue.pop(workerIdx, value))
+                    {
+                        ++popCounts[value];
+                        ++popCountTotal;
+                    }
+                    else
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+    }
+    for(auto & worker : workers)
+    {
+        worker.join();
+    }
+
+    CHECK(queue.empty());
+    for(auto const & popCount : popCounts)
+    {
+        CHECK(1u == popCount.load());
+    }
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE(
+    "concurrentExecPoolWithWorkStealingQueueRunsAllTasks", "[core]")
+{
+    using ThreadPool = alpaka::core::detail::ConcurrentExecPool<
+        std::size_t,
+        std::thread,
+        std::promise,
+        void,
+        std::mutex,
+        std::condition_variable,
+        false,
+        alpaka::core::detail::WorkStealingQueue>;
+
+    std::size_t const taskCount(1000u);
+    std::atomic<std::size_t> runCount(0u);
+
+    ThreadPool pool(4u);
+    // The pool can grow after it has been created.
+    pool.ensureConcurrentExecutionCount(8u);
+
+    std::vector<std::future<void>> futures;
+    for(std::size_t i(0u); i < taskCount; ++i)
+    {
+        futures.emplace_back(pool.enqueueTask([&runCount](){++runCount;}));
+    }
+    for(auto & future : futures)
+    {
+        future.get();
+    }
+
+    CHECK(taskCount == runCount.load());
+    CHECK(8u == pool.getConcurrentExecutionCount());
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE(
+    "concurrentExecPoolWithWorkStealingQueueWakesUpSleepingExecutors", "[core]")
+{
+    using ThreadPool = alpaka::core::detail::ConcurrentExecPool<
+        std::size_t,
+        std::thread,
+        std::promise,
+        void,
+        std::mutex,
+        std::condition_variable,
+        false,
+        alpaka::core::detail::WorkStealingQueue>;
+    using Latch = alpaka::core::detail::TaskLatch<
+        std::mutex,
+        std::condition_variable>;
+
+    std::atomic<std::size_t> runCount(0u);
+
+    ThreadPool pool(4u);
+    Latch latch;
+
+    // Waiting for each task lets the executors run out of work and go to sleep in between.
+    // A lost wakeup would hang this test.
+    std::size_t const roundCount(2000u);
+    for(std::size_t i(0u); i < roundCount; ++i)
+    {
+        pool.enqueueTaskWithLatch(latch, [&runCount](){++runCount;});
+        latch.wait();
+    }
+
+    CHECK(roundCount == runCount.load());
+}
@@ -0,0 +1,276 @@
+/* Copyright 2019 Benjamin Worpitz
+ *
+ * This file is part of Alpaka.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <alpaka/dev/cpu/Numa.hpp>
+#include <alpaka/acc/AccCpuOmp2Threads.hpp>
+#include <alpaka/acc/AccCpuThreads.hpp>
+#include <alpaka/core/ThreadAffinity.hpp>
+#include <alpaka/core/Unused.hpp>
+#include <alpaka/dev/DevCpu.hpp>
+#include <alpaka/dim/DimArithmetic.hpp>
+#include <alpaka/dim/DimIntegralConst.hpp>
+#include <alpaka/kernel/TaskKernelCpuOmp2Threads.hpp>
+#include <alpaka/kernel/TaskKernelCpuThreads.hpp>
+#include <alpaka/mem/buf/BufCpu.hpp>
+#include <alpaka/pltf/PltfCpu.hpp>
+#include <alpaka/queue/QueueCpuBlocking.hpp>
+#include <alpaka/queue/QueueCpuNonBlocking.hpp>
+#include <alpaka/wait/Traits.hpp>
+#include <alpaka/workdiv/WorkDivMembers.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+    //#############################################################################
+    //! Enables the NUMA aware mode of the CPU platform for the lifetime of the object.
+    class ScopedNumaAware final
+    {
+    public:
+        ScopedNumaAware()
+        {
+            alpaka::pltf::cpu::setNumaAware(true);
+        }
+        ScopedNumaAware(ScopedNumaAware const &) = delete;
+        ScopedNumaAware(ScopedNumaAware &&) = delete;
+        auto operator=(ScopedNumaAware const &) -> ScopedNumaAware & = delete;
+        auto operator=(ScopedNumaAware &&) -> ScopedNumaAware & = delete;
+        ~ScopedNumaAware()
+        {
+            alpaka::pltf::cpu::setNumaAware(false);
+        }
+    };
+
+    //-----------------------------------------------------------------------------
+    //! \return If all CPUs of the subset are contained in the set.
+    auto isSubset(
+        std::vector<std::uint32_t> const & subset,
+        std::vector<std::uint32_t> const & set)
+    -> bool
+    {
+        return std::all_of(
+            subset.begin(),
+            subset.end(),
+            [&set](std::uint32_t const cpu)
+            {
+                return std::find(set.begin(), set.end(), cpu) != set.end();
+            });
+    }
+
+    //#############################################################################
+    //! Records the CPUs each block thread may run on.
+    class BlockThreadCpusKernel
+    {
+    public:
+        //-----------------------------------------------------------------------------
+        template<
+            typename TAcc>
+        ALPAKA_FN_ACC auto operator()(
+            TAcc const & acc,
+            std::vector<std::vector<std::uint32_t>> * const pThreadCpus,
+            std::mutex * const pMtx) const
+        -> void
+        {
+            alpaka::ignore_unused(acc);
+
+            auto cpus(alpaka::core::threads::getCurrentThreadAffinity());
+            std::lock_guard<std::mutex> lock(*pMtx);
+            pThreadCpus->push_back(std::move(cpus));
+        }
+    };
+
+    //-----------------------------------------------------------------------------
+    //! Launches kernels on the first and the last device alternately from the calling thread and checks that all block threads run on the CPUs of the device.
+    //!
+    //! The block threads of the accelerator are reused by all launches from the same thread, so they have to be restricted anew for each launch.
+    template<
+        typename TAcc>
+    auto checkBlockThreadsFollowAlternatingDevs()
+    -> void
+    {
+        using Dim = alpaka::dim::DimInt<1u>;
+        using Idx = std::size_t;
+        using Vec = alpaka::vec::Vec<Dim, Idx>;
+
+        ScopedNumaAware const numaAware;
+
+        std::vector<alpaka::dev::DevCpu> const devs{
+            alpaka::pltf::getDevByIdx<alpaka::pltf::PltfCpu>(0u),
+            alpaka::pltf::getDevByIdx<alpaka::pltf::PltfCpu>(alpaka::pltf::getDevCount<alpaka::pltf::PltfCpu>() - 1u)};
+        Idx const blockThreadCount(4u);
+        alpaka::workdiv::WorkDivMembers<Dim, Idx> const workDiv(Vec(Idx(1u)), Vec(blockThreadCount), Vec(Idx(1u)));
+
+        for(std::size_t launchIdx(0u); launchIdx < 4u; ++launchIdx)
+        {
+            auto const & dev(devs[launchIdx % devs.size()]);
+            auto const devCpus(alpaka::dev::cpu::getCpuSet(dev));
+
+            std::vector<std::vector<std::uint32_t>> threadCpus;
+            std::mutex mtx;
+            {
+                alpaka::queue::QueueCpuBlocking queue(dev);
+                alpaka::kernel::exec<TAcc>(queue, workDiv, BlockThreadCpusKernel(), &threadCpus, &mtx);
+            }
+
+            CHECK(blockThreadCount == threadCpus.size());
+            for(auto const & cpus : threadCpus)
+            {
+                CHECK(isSubset(cpus, devCpus));
+            }
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE( "numaParseIdxListShouldExpandRanges", "[dev]")
+{
+    CHECK(alpaka::dev::cpu::detail::parseIdxList("").empty());
+    CHECK(std::vector<std::uint32_t>{0u} == alpaka::dev::cpu::detail::parseIdxList("0"));
+    CHECK(std::vector<std::uint32_t>{0u, 1u, 2u, 3u} == alpaka::dev::cpu::detail::parseIdxList("0-3"));
+    CHECK(std::vector<std::uint32_t>{0u, 1u, 8u, 10u, 11u} == alpaka::dev::cpu::detail::parseIdxList("0-1,8,10-11\n"));
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE( "pltfCpuShouldProvideOneDevByDefault", "[dev]")
+{
+    CHECK(!alpaka::pltf::cpu::isNumaAware());
+    REQUIRE(1u == alpaka::pltf::getDevCount<alpaka::pltf::PltfCpu>());
+
+    auto const dev(alpaka::pltf::getDevByIdx<alpaka::pltf::PltfCpu>(0u));
+    CHECK(!dev.m_spDevCpuImpl->isNumaNode());
+    CHECK(dev.m_spDevCpuImpl->getCpuSet().empty());
+    CHECK(dev == alpaka::pltf::getDevByIdx<alpaka::pltf::PltfCpu>(0u));
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE( "pltfCpuDevHandlesShouldShareTheAffinityPolicy", "[dev]")
+{
+    for(bool const bNumaAware : {false, true})
+    {
+        alpaka::pltf::cpu::setNumaAware(bNumaAware);
+        auto const devCount(alpaka::pltf::getDevCount<alpaka::pltf::PltfCpu>());
+        for(std::size_t devIdx(0u); devIdx < devCount; ++devIdx)
+        {
+            auto const dev(alpaka::pltf::getDevByIdx<alpaka::pltf::PltfCpu>(devIdx));
+            auto const policy(alpaka::core::threads::AffinityPolicy::compact(alpaka::dev::cpu::getCpuSet(dev)));
+            alpaka::dev::cpu::setAffinityPolicy(dev, policy);
+
+            // A handle retrieved separately refers to the same device.
+            auto const otherDev(alpaka::pltf::getDevByIdx<alpaka::pltf::PltfCpu>(devIdx));
+            CHECK(policy == alpaka::dev::cpu::getAffinityPolicy(otherDev));
+
+            alpaka::dev::cpu::setAffinityPolicy(otherDev, alpaka::core::threads::AffinityPolicy::inherit());
+            CHECK(alpaka::core::threads::AffinityPolicy::Kind::Inherit == alpaka::dev::cpu::getAffinityPolicy(dev).getKind());
+        }
+    }
+    alpaka::pltf::cpu::setNumaAware(false);
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE( "pltfCpuNumaAwareShouldProvideOneDevPerNumaNode", "[dev]")
+{
+    ScopedNumaAware const numaAware;
+
+    auto const & numaNodes(alpaka::dev::cpu::detail::getNumaNodes());
+    auto const devCount(alpaka::pltf::getDevCount<alpaka::pltf::PltfCpu>());
+    if(numaNodes.empty())
+    {
+        // The topology is not available, so the platform falls back to the single device.
+        CHECK(1u == devCount);
+        return;
+    }
+
+    REQUIRE(numaNodes.size() == devCount);
+    for(std::size_t devIdx(0u); devIdx < devCount; ++devIdx)
+    {
+        auto const dev(alpaka::pltf::getDevByIdx<alpaka::pltf::PltfCpu>(devIdx));
+        CHECK(dev.m_spDevCpuImpl->isNumaNode());
+        CHECK(numaNodes[devIdx].m_nodeIdx == dev.m_spDevCpuImpl->getNumaNodeIdx());
+        CHECK(numaNodes[devIdx].m_cpus == dev.m_spDevCpuImpl->getCpuSet());
+        CHECK(!dev.m_spDevCpuImpl->getCpuSet().empty());
+        CHECK(alpaka::dev::getMemBytes(dev) > 0u);
+
+        CHECK(dev == alpaka::pltf::getDevByIdx<alpaka::pltf::PltfCpu>(devIdx));
+        for(std::size_t otherDevIdx(devIdx + 1u); otherDevIdx < devCount; ++otherDevIdx)
+        {
+            CHECK(dev != alpaka::pltf::getDevByIdx<alpaka::pltf::PltfCpu>(otherDevIdx));
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE( "bufCpuOnNumaNodeShouldBeUsable", "[dev]")
+{
+    ScopedNumaAware const numaAware;
+
+    using Idx = std::size_t;
+    auto const dev(alpaka::pltf::getDevByIdx<alpaka::pltf::PltfCpu>(alpaka::pltf::getDevCount<alpaka::pltf::PltfCpu>() - 1u));
+
+    // Large enough to contain whole pages which are bound to the node.
+    Idx const elementCount(Idx(1u) << 20u);
+    auto buf(alpaka::mem::buf::alloc<int, Idx>(dev, elementCount));
+    auto const pBuf(alpaka::mem::view::getPtrNative(buf));
+    for(Idx i(0u); i < elementCount; ++i)
+    {
+        pBuf[i] = static_cast<int>(i);
+    }
+    CHECK(static_cast<int>(elementCount - 1u) == pBuf[elementCount - 1u]);
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE( "queueCpuOnNumaNodeShouldExecuteOnTheCpusOfTheNode", "[dev]")
+{
+    ScopedNumaAware const numaAware;
+
+    auto const dev(alpaka::pltf::getDevByIdx<alpaka::pltf::PltfCpu>(0u));
+    auto const & devCpus(dev.m_spDevCpuImpl->getCpuSet());
+    auto const callerCpus(alpaka::core::threads::getCurrentThreadAffinity());
+
+    std::vector<std::uint32_t> nonBlockingCpus;
+    std::vector<std::uint32_t> blockingCpus;
+    {
+        alpaka::queue::QueueCpuNonBlocking queueNonBlocking(dev);
+        alpaka::queue::enqueue(queueNonBlocking, [&nonBlockingCpus](){nonBlockingCpus = alpaka::core::threads::getCurrentThreadAffinity();});
+        alpaka::wait::wait(queueNonBlocking);
+
+        alpaka::queue::QueueCpuBlocking queueBlocking(dev);
+        alpaka::queue::enqueue(queueBlocking, [&blockingCpus](){blockingCpus = alpaka::core::threads::getCurrentThreadAffinity();});
+    }
+
+    if(!devCpus.empty() && !callerCpus.empty())
+    {
+        CHECK(isSubset(nonBlockingCpus, devCpus));
+        CHECK(isSubset(blockingCpus, devCpus));
+    }
+
+    // The blocking queue restores the affinity of the calling thread.
+    CHECK(callerCpus == alpaka::core::threads::getCurrentThreadAffinity());
+}
+
+#ifdef ALPAKA_ACC_CPU_B_SEQ_T_THREADS_ENABLED
+//-----------------------------------------------------------------------------
+TEST_CASE( "accCpuThreadsBlockThreadsShouldFollowTheDevOfEachLaunch", "[dev]")
+{
+    checkBlockThreadsFollowAlternatingDevs<alpaka::acc::AccCpuThreads<alpaka::dim::DimInt<1u>, std::size_t>>();
+}
+#endif
+
+#ifdef ALPAKA_ACC_CPU_B_SEQ_T_OMP2_ENABLED
+//-----------------------------------------------------------------------------
+TEST_CASE( "accCpuOmp2ThreadsBlockThreadsShouldFollowTheDevOfEachLaunch", "[dev]")
+{
+    checkBlockThreadsFollowAlternatingDevs<alpaka::acc::AccCpuOmp2Threads<alpaka::dim::DimInt<1u>, std::size_t>>();
+}
+#endif
@@ -8,6 +8,8 @@
  */
 
 #include <alpaka/event/Traits.hpp>
+#include <alpaka/event/EventCpu.hpp>
+#include <alpaka/pltf/PltfCpu.hpp>
 
 #include <alpaka/test/event/EventHostManualTrigger.hpp>
 #include <alpaka/test/queue/Queue.hpp>
@@ -16,6 +18,14 @@
 
 #include <catch2/catch.hpp>
 
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+#include <vector>
+
 //-----------------------------------------------------------------------------
 struct TestTemplateInitTrue
 {
@@ -286,6 +296,220 @@ void operator()()
 }
 };
 
+//-----------------------------------------------------------------------------
+struct TestTemplateMultipleThreadsWaitFor
+{
+template< typename TDevQueue >
+void operator()()
+{
+    using Fixture = alpaka::test::queue::QueueTestFixture<TDevQueue>;
+    using Queue = typename Fixture::Queue;
+    using Dev = typename Fixture::Dev;
+
+    if(!alpaka::test::queue::IsBlockingQueue<Queue>::value)
+    {
+        Fixture f1;
+        if(alpaka::test::event::isEventHostManualTriggerSupported(f1.m_dev))
+        {
+            auto q1 = f1.m_queue;
+            alpaka::test::event::EventHostManualTrigger<Dev> k1(f1.m_dev);
+            alpaka::event::Event<Queue> e1(f1.m_dev);
+
+            // q1 = [k1, e1]
+            alpaka::queue::enqueue(q1, k1);
+            alpaka::queue::enqueue(q1, e1);
+
+            std::atomic<std::size_t> finishedWaiterCount(0u);
+            std::vector<std::thread> waiters;
+            for(std::size_t i(0u); i < 4u; ++i)
+            {
+                waiters.emplace_back(
+                    [&e1, &finishedWaiterCount]()
+                    {
+                        alpaka::wait::wait(e1);
+                        ++finishedWaiterCount;
+                    });
+            }
+
+            REQUIRE(alpaka::event::test(e1) == false);
+
+            // All waiters have to be woken up as soon as the event is completed.
+            k1.trigger();
+            for(auto & waiter : waiters)
+            {
+                waiter.join();
+            }
+
+            REQUIRE(4u == finishedWaiterCount);
+            REQUIRE(alpaka::event::test(e1));
+        }
+        else
+        {
+            std::cerr << "Can not execute test because CU_DEVICE_ATTRIBUTE_CAN_USE_STREAM_MEM_OPS is not supported!" << std::endl;
+        }
+    }
+}
+};
+
+//-----------------------------------------------------------------------------
+struct TestTemplateElapsedTimeCpu
+{
+template< typename TQueue >
+void operator()()
+{
+    auto const dev(alpaka::pltf::getDevByIdx<alpaka::pltf::PltfCpu>(0u));
+    TQueue queue(dev);
+    alpaka::event::EventCpu eventStart(dev);
+    alpaka::event::EventCpu eventEnd(dev);
+
+    // The events have not been enqueued yet.
+    CHECK_THROWS_AS(alpaka::event::elapsedTime(eventStart, eventEnd), std::runtime_error);
+
+    auto const begin(std::chrono::steady_clock::now());
+    alpaka::queue::enqueue(queue, eventStart);
+    alpaka::queue::enqueue(
+        queue,
+        []() noexcept
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20u));
+        });
+    alpaka::queue::enqueue(queue, eventEnd);
+    alpaka::wait::wait(eventEnd);
+    auto const end(std::chrono::steady_clock::now());
+
+    // The time has been taken by the queue and not by the waiting thread.
+    // An upper bound depending on the scheduling of the queue would be flaky, so the time is only bounded by the span observed by this thread.
+    std::this_thread::sleep_for(std::chrono::milliseconds(50u));
+
+    auto const elapsedTimeMs(alpaka::event::elapsedTime(eventStart, eventEnd));
+    CHECK(elapsedTimeMs >= 20.0);
+    CHECK(elapsedTimeMs <= std::chrono::duration<double, std::milli>(end - begin).count());
+}
+};
+
+//-----------------------------------------------------------------------------
+//! A chain of queues where each queue waits for the event of the previous one.
+//! All waiting queues are released one after the other by the queue completing the event they wait for.
+TEST_CASE( "eventWaitShouldReleaseDependentQueuesInOrder", "[event]")
+{
+    auto const dev(alpaka::pltf::getDevByIdx<alpaka::pltf::PltfCpu>(0u));
+
+    std::size_t const queueCount(16u);
+    std::vector<alpaka::queue::QueueCpuNonBlocking> queues;
+    std::vector<alpaka::event::EventCpu> events;
+    for(std::size_t i(0u); i < queueCount; ++i)
+    {
+        queues.emplace_back(dev);
+        events.emplace_back(dev);
+    }
+
+    alpaka::test::event::EventHostManualTrigger<alpaka::dev::DevCpu> trigger(dev);
+    alpaka::queue::enqueue(queues[0u], trigger);
+
+    std::atomic<std::size_t> executedCount(0u);
+    std::vector<std::size_t> executionOrder(queueCount);
+    for(std::size_t i(0u); i < queueCount; ++i)
+    {
+        if(i > 0u)
+        {
+            alpaka::wait::wait(queues[i], events[i - 1u]);
+        }
+        alpaka::queue::enqueue(
+            queues[i],
+            [i, &executedCount, &executionOrder]() noexcept
+            {
+                executionOrder[i] = executedCount++;
+            });
+        alpaka::queue::enqueue(queues[i], events[i]);
+    }
+
+    // Nothing is executed before the first queue is released.
+    std::this_thread::sleep_for(std::chrono::milliseconds(10u));
+    CHECK(0u == executedCount.load());
+    for(auto const & event : events)
+    {
+        CHECK(!alpaka::event::test(event));
+    }
+
+    trigger.trigger();
+    alpaka::wait::wait(queues.back());
+
+    CHECK(queueCount == executedCount.load());
+    for(std::size_t i(0u); i < queueCount; ++i)
+    {
+        CHECK(i == executionOrder[i]);
+        CHECK(alpaka::event::test(events[i]));
+    }
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE( "eventWaitShouldReleaseManyMoreWaitingQueuesThanThreads", "[event]")
+{
+    auto const dev(alpaka::pltf::getDevByIdx<alpaka::pltf::PltfCpu>(0u));
+
+    // Each queue waits for the events of multiple earlier queues, so there are many more waits than hardware threads.
+    std::size_t const queueCount(64u);
+    std::size_t const waitCountPerQueue(8u);
+    std::vector<alpaka::queue::QueueCpuNonBlocking> queues;
+    std::vector<alpaka::event::EventCpu> events;
+    for(std::size_t i(0u); i < queueCount; ++i)
+    {
+        queues.emplace_back(dev);
+        events.emplace_back(dev);
+    }
+
+    alpaka::test::event::EventHostManualTrigger<alpaka::dev::DevCpu> trigger(dev);
+    alpaka::queue::enqueue(queues[0u], trigger);
+
+    // A queue only increments its counter after all queues it waits for have incremented theirs.
+    std::vector<std::atomic<std::size_t>> counters(queueCount);
+    for(auto & counter : counters)
+    {
+        counter = 0u;
+    }
+    std::atomic<bool> bOrderError(false);
+    for(std::size_t i(0u); i < queueCount; ++i)
+    {
+        for(std::size_t w(1u); (w <= waitCountPerQueue) && (w <= i); ++w)
+        {
+            alpaka::wait::wait(queues[i], events[i - w]);
+        }
+        alpaka::queue::enqueue(
+            queues[i],
+            [i, waitCountPerQueue, &counters, &bOrderError]() noexcept
+            {
+                for(std::size_t w(1u); (w <= waitCountPerQueue) && (w <= i); ++w)
+                {
+                    if(counters[i - w] != 1u)
+                    {
+                        bOrderError = true;
+                    }
+                }
+                ++counters[i];
+            });
+        alpaka::queue::enqueue(queues[i], events[i]);
+    }
+
+    // Nothing is executed before the first queue is released.
+    std::this_thread::sleep_for(std::chrono::milliseconds(10u));
+    for(auto const & counter : counters)
+    {
+        CHECK(0u == counter);
+    }
+
+    trigger.trigger();
+    for(auto & queue : queues)
+    {
+        alpaka::wait::wait(queue);
+    }
+
+    CHECK(!bOrderError);
+    for(auto const & counter : counters)
+    {
+        CHECK(1u == counter);
+    }
+}
+
 using TestQueues = alpaka::meta::Concatenate<
         alpaka::test::queue::TestQueues
  #ifdef ALPAKA_ACC_CPU_B_OMP2_T_SEQ_ENABLED
@@ -318,3 +542,50 @@ TEST_CASE( "waitForEventThatAlreadyFinishedShouldBeSkipped", "[event]")
 {
     alpaka::meta::forEachType< TestQueues >( TestTemplateFinishedShouldBeSkipped() );
 }
+
+TEST_CASE( "eventShouldWakeUpAllWaitingThreads", "[event]")
+{
+    alpaka::meta::forEachType< TestQueues >( TestTemplateMultipleThreadsWaitFor() );
+}
+
+TEST_CASE( "eventElapsedTimeShouldMeasureTheTimeBetweenTheCompletions", "[event]")
+{
+    alpaka::meta::forEachType<
+        std::tuple<
+            alpaka::queue::QueueCpuBlocking,
+            alpaka::queue::QueueCpuNonBlocking>>( TestTemplateElapsedTimeCpu() );
+}
+
+//-----------------------------------------------------------------------------
+//! An enqueue completing after a later one (in a different queue) must not change the time of the event.
+TEST_CASE( "eventReadyTimeShouldNotBeChangedByAnOlderCompletion", "[event]")
+{
+    auto const dev(alpaka::pltf::getDevByIdx<alpaka::pltf::PltfCpu>(0u));
+    alpaka::event::cpu::detail::EventCpuImpl eventImpl(dev);
+
+    auto const enqueueCountOld(eventImpl.enqueue());
+    auto const enqueueCountNew(eventImpl.enqueue());
+
+    eventImpl.setReady(enqueueCountNew);
+    REQUIRE(eventImpl.isReady());
+    auto const readyTimeNs(eventImpl.getReadyTimeNs());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(2u));
+    eventImpl.setReady(enqueueCountOld);
+    CHECK(eventImpl.isReady());
+    CHECK(readyTimeNs == eventImpl.getReadyTimeNs());
+
+    // Concurrent completions of an older and a newer enqueue always keep the time of the newer one.
+    for(std::size_t i(0u); i < 100u; ++i)
+    {
+        auto const enqueueCountA(eventImpl.enqueue());
+        auto const enqueueCountB(eventImpl.enqueue());
+        std::thread threadA([&eventImpl, enqueueCountA](){eventImpl.setReady(enqueueCountA);});
+        auto const timeBeforeNs(alpaka::event::cpu::detail::EventCpuImpl::getTimeNs());
+        eventImpl.setReady(enqueueCountB);
+        threadA.join();
+        // The newer enqueue always sets the ready count, so the time has been taken within setReady(enqueueCountB).
+        CHECK(eventImpl.isReady());
+        CHECK(eventImpl.getReadyTimeNs() >= timeBeforeNs);
+    }
+}
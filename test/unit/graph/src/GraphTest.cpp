@@ -0,0 +1,120 @@
+/* Copyright 2019 Benjamin Worpitz
+ *
+ * This file is part of Alpaka.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <alpaka/graph/Traits.hpp>
+#include <alpaka/graph/GraphCpu.hpp>
+#include <alpaka/meta/ForEachType.hpp>
+
+#include <alpaka/event/EventCpu.hpp>
+#include <alpaka/pltf/PltfCpu.hpp>
+#include <alpaka/queue/QueueCpuBlocking.hpp>
+#include <alpaka/queue/QueueCpuNonBlocking.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+using CpuQueues = std::tuple<
+    alpaka::queue::QueueCpuBlocking,
+    alpaka::queue::QueueCpuNonBlocking>;
+
+//-----------------------------------------------------------------------------
+struct TestTemplateCaptureDoesNotExecute
+{
+template< typename TQueue >
+void operator()()
+{
+    auto const dev(alpaka::pltf::getDevByIdx<alpaka::pltf::PltfCpu>(0u));
+    TQueue queue(dev);
+
+    int executedCount(0);
+
+    alpaka::graph::beginCapture(queue);
+    alpaka::queue::enqueue(queue, [&executedCount]() noexcept{++executedCount;});
+    alpaka::queue::enqueue(queue, [&executedCount]() noexcept{++executedCount;});
+    auto const graph(alpaka::graph::endCapture(queue));
+
+    alpaka::wait::wait(queue);
+
+    CHECK(0 == executedCount);
+    CHECK(2u == graph.getTaskCount());
+
+    // After the capture has ended, tasks are executed again.
+    alpaka::queue::enqueue(queue, [&executedCount]() noexcept{++executedCount;});
+    alpaka::wait::wait(queue);
+
+    CHECK(1 == executedCount);
+}
+};
+
+//-----------------------------------------------------------------------------
+struct TestTemplateGraphLaunchExecutesTasksInOrder
+{
+template< typename TQueue >
+void operator()()
+{
+    auto const dev(alpaka::pltf::getDevByIdx<alpaka::pltf::PltfCpu>(0u));
+    TQueue queue(dev);
+
+    // Only the queue writes, so no synchronization is required besides waiting for the queue.
+    std::vector<int> order;
+
+    alpaka::graph::beginCapture(queue);
+    alpaka::queue::enqueue(queue, [&order](){order.push_back(0);});
+    alpaka::queue::enqueue(queue, [&order](){order.push_back(1);});
+    auto const graph(alpaka::graph::endCapture(queue));
+
+    alpaka::queue::enqueue(queue, graph);
+    alpaka::queue::enqueue(queue, [&order](){order.push_back(2);});
+    alpaka::queue::enqueue(queue, graph);
+    alpaka::wait::wait(queue);
+
+    CHECK((std::vector<int>{0, 1, 2, 0, 1}) == order);
+}
+};
+
+//-----------------------------------------------------------------------------
+struct TestTemplateCaptureMisuseThrows
+{
+template< typename TQueue >
+void operator()()
+{
+    auto const dev(alpaka::pltf::getDevByIdx<alpaka::pltf::PltfCpu>(0u));
+    TQueue queue(dev);
+    alpaka::event::EventCpu event(dev);
+
+    CHECK_THROWS_AS(alpaka::graph::endCapture(queue), std::runtime_error);
+
+    alpaka::graph::beginCapture(queue);
+    CHECK_THROWS_AS(alpaka::graph::beginCapture(queue), std::runtime_error);
+    CHECK_THROWS_AS(alpaka::queue::enqueue(queue, event), std::runtime_error);
+    CHECK_THROWS_AS(alpaka::wait::wait(queue, event), std::runtime_error);
+    auto const graph(alpaka::graph::endCapture(queue));
+
+    CHECK(0u == graph.getTaskCount());
+    CHECK(alpaka::event::test(event));
+}
+};
+
+TEST_CASE( "graphCaptureShouldNotExecuteTasks", "[graph]")
+{
+    alpaka::meta::forEachType< CpuQueues >( TestTemplateCaptureDoesNotExecute() );
+}
+
+TEST_CASE( "graphLaunchShouldExecuteTasksInOrder", "[graph]")
+{
+    alpaka::meta::forEachType< CpuQueues >( TestTemplateGraphLaunchExecutesTasksInOrder() );
+}
+
+TEST_CASE( "graphCaptureMisuseShouldThrow", "[graph]")
+{
+    alpaka::meta::forEachType< CpuQueues >( TestTemplateCaptureMisuseThrows() );
+}
@@ -0,0 +1,81 @@
+/* Copyright 2019 Benjamin Worpitz
+ *
+ * This file is part of Alpaka.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <alpaka/alpaka.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <atomic>
+#include <stdexcept>
+
+#ifdef ALPAKA_ACC_CPU_B_SEQ_T_THREADS_ENABLED
+//#############################################################################
+class ThrowingBlockThreadKernel
+{
+public:
+    //-----------------------------------------------------------------------------
+    template<
+        typename TAcc>
+    auto operator()(
+        TAcc const & acc,
+        bool const bThrow,
+        std::atomic<std::size_t> * executedThreadCount) const
+    -> void
+    {
+        auto const gridBlockIdx(alpaka::idx::getIdx<alpaka::Grid, alpaka::Blocks>(acc)[0u]);
+        auto const blockThreadIdx(alpaka::idx::getIdx<alpaka::Block, alpaka::Threads>(acc)[0u]);
+        ++(*executedThreadCount);
+        if(bThrow && (gridBlockIdx == 1u) && (blockThreadIdx == 0u))
+        {
+            throw std::runtime_error("block thread failed");
+        }
+    }
+};
+
+//-----------------------------------------------------------------------------
+TEST_CASE( "kernelCpuThreadsShouldRethrowTheExceptionOfABlockThread", "[kernel]")
+{
+    using Dim = alpaka::dim::DimInt<1u>;
+    using Idx = std::size_t;
+    using Acc = alpaka::acc::AccCpuThreads<Dim, Idx>;
+    using Vec = alpaka::vec::Vec<Dim, Idx>;
+
+    auto const dev(alpaka::pltf::getDevByIdx<alpaka::pltf::PltfCpu>(0u));
+    alpaka::queue::QueueCpuBlocking queue(dev);
+    alpaka::workdiv::WorkDivMembers<Dim, Idx> const workDiv(
+        Vec(static_cast<Idx>(4u)),
+        Vec(static_cast<Idx>(2u)),
+        Vec(static_cast<Idx>(1u)));
+
+    // The exception is only rethrown after all blocks have been executed.
+    std::atomic<std::size_t> executedThreadCount(0u);
+    CHECK_THROWS_AS(
+        alpaka::queue::enqueue(
+            queue,
+            alpaka::kernel::createTaskKernel<Acc>(
+                workDiv,
+                ThrowingBlockThreadKernel(),
+                true,
+                &executedThreadCount)),
+        std::runtime_error);
+    CHECK(8u == executedThreadCount);
+
+    // The block slots reused by the next kernel do not report the old exception.
+    executedThreadCount = 0u;
+    CHECK_NOTHROW(
+        alpaka::queue::enqueue(
+            queue,
+            alpaka::kernel::createTaskKernel<Acc>(
+                workDiv,
+                ThrowingBlockThreadKernel(),
+                false,
+                &executedThreadCount)));
+    CHECK(8u == executedThreadCount);
+}
+#endif
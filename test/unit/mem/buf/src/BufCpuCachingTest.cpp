@@ -0,0 +1,233 @@
+/* Copyright 2019 Benjamin Worpitz
+ *
+ * This file is part of Alpaka.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <alpaka/mem/alloc/AllocCpuCaching.hpp>
+#include <alpaka/dev/DevCpu.hpp>
+#include <alpaka/dim/DimArithmetic.hpp>
+#include <alpaka/mem/buf/BufCpu.hpp>
+#include <alpaka/pltf/PltfCpu.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <thread>
+
+namespace
+{
+    //#############################################################################
+    //! Enables the caching allocator for CPU buffers for the lifetime of the object.
+    class ScopedCaching final
+    {
+    public:
+        ScopedCaching()
+        {
+            alpaka::mem::buf::cpu::setCaching(true);
+        }
+        ScopedCaching(ScopedCaching const &) = delete;
+        ScopedCaching(ScopedCaching &&) = delete;
+        auto operator=(ScopedCaching const &) -> ScopedCaching & = delete;
+        auto operator=(ScopedCaching &&) -> ScopedCaching & = delete;
+        ~ScopedCaching()
+        {
+            alpaka::mem::buf::cpu::setCaching(false);
+        }
+    };
+
+    // Tags which are not used by the buffers to keep the test cases independent of each other.
+    std::uint32_t const tagReuse(1000u);
+    std::uint32_t const tagThreshold(1001u);
+    std::uint32_t const tagRelease(1002u);
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE( "allocCpuCachingShouldRoundUpToSizeClasses", "[memBuf]")
+{
+    using Alloc = alpaka::mem::alloc::AllocCpuCaching;
+
+    CHECK(64u == Alloc::getClassBytes(0u));
+    CHECK(64u == Alloc::getClassBytes(1u));
+    CHECK(64u == Alloc::getClassBytes(64u));
+    CHECK(80u == Alloc::getClassBytes(65u));
+    CHECK(128u == Alloc::getClassBytes(128u));
+    CHECK(160u == Alloc::getClassBytes(129u));
+    CHECK(1280u == Alloc::getClassBytes(1025u));
+    CHECK(1792u == Alloc::getClassBytes(1537u));
+    CHECK(2048u == Alloc::getClassBytes(1793u));
+
+    // At most a quarter of a block is wasted.
+    for(std::size_t sizeBytes(65u); sizeBytes < 100000u; sizeBytes += 997u)
+    {
+        auto const classBytes(Alloc::getClassBytes(sizeBytes));
+        CHECK(classBytes >= sizeBytes);
+        CHECK((classBytes - sizeBytes) * 4u < classBytes);
+    }
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE( "allocCpuCachingShouldFailForUnrepresentableSizes", "[memBuf]")
+{
+    using Alloc = alpaka::mem::alloc::AllocCpuCaching;
+    std::size_t const maxBytes(std::numeric_limits<std::size_t>::max());
+
+    CHECK(0u == Alloc::getClassBytes(maxBytes));
+    CHECK(0u == Alloc::getClassBytes(maxBytes - 1u));
+
+    auto & alloc(Alloc::get());
+    auto const statsBegin(alloc.getStats());
+    CHECK(nullptr == alloc.alloc(maxBytes, tagReuse));
+    auto const statsEnd(alloc.getStats());
+    CHECK(statsBegin.m_usedBytes == statsEnd.m_usedBytes);
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE( "allocCpuCachingStatsShouldIncludeAllThreads", "[memBuf]")
+{
+    auto & alloc(alpaka::mem::alloc::AllocCpuCaching::get());
+    auto const statsBegin(alloc.getStats());
+
+    // The block is allocated by another thread, which has exited before the block is freed.
+    void * p(nullptr);
+    std::thread thread(
+        [&]()
+        {
+            p = alloc.alloc(1000u, tagReuse);
+        });
+    thread.join();
+    REQUIRE(nullptr != p);
+
+    auto const statsAlloc(alloc.getStats());
+    CHECK(statsBegin.m_allocCount + 1u == statsAlloc.m_allocCount);
+    CHECK(statsBegin.m_usedBytes + 1024u == statsAlloc.m_usedBytes);
+
+    alloc.free(p, 1000u, tagReuse);
+    auto const statsFree(alloc.getStats());
+    CHECK(statsBegin.m_freeCount + 1u == statsFree.m_freeCount);
+    CHECK(statsBegin.m_usedBytes == statsFree.m_usedBytes);
+
+    alloc.release();
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE( "allocCpuCachingShouldReuseFreedBlocks", "[memBuf]")
+{
+    auto & alloc(alpaka::mem::alloc::AllocCpuCaching::get());
+    auto const statsBegin(alloc.getStats());
+
+    auto const p0(alloc.alloc(1000u, tagReuse));
+    REQUIRE(nullptr != p0);
+    CHECK(0u == reinterpret_cast<std::uintptr_t>(p0) % 64u);
+    alloc.free(p0, 1000u, tagReuse);
+
+    // A different size of the same class gets the freed block.
+    auto const p1(alloc.alloc(1010u, tagReuse));
+    CHECK(p0 == p1);
+    // A different tag does not get the block.
+    auto const p2(alloc.alloc(1000u, tagReuse + 100u));
+    CHECK(p0 != p2);
+
+    auto const statsEnd(alloc.getStats());
+    CHECK(statsBegin.m_allocCount + 3u == statsEnd.m_allocCount);
+    CHECK(statsBegin.m_cacheHitCount + 1u == statsEnd.m_cacheHitCount);
+    CHECK(statsBegin.m_freeCount + 1u == statsEnd.m_freeCount);
+    CHECK(statsBegin.m_usedBytes + 2u * 1024u == statsEnd.m_usedBytes);
+
+    alloc.free(p1, 1010u, tagReuse);
+    alloc.free(p2, 1000u, tagReuse + 100u);
+    alloc.release();
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE( "allocCpuCachingShouldReleaseBlocksAboveTheThreshold", "[memBuf]")
+{
+    auto & alloc(alpaka::mem::alloc::AllocCpuCaching::get());
+    alloc.release();
+    auto const releaseThresholdBytes(alloc.getReleaseThreshold());
+    alloc.setReleaseThreshold(4096u);
+
+    auto const p0(alloc.alloc(4096u, tagThreshold));
+    auto const p1(alloc.alloc(4096u, tagThreshold));
+    REQUIRE(nullptr != p0);
+    REQUIRE(nullptr != p1);
+
+    auto const statsBegin(alloc.getStats());
+    alloc.free(p0, 4096u, tagThreshold);
+    alloc.free(p1, 4096u, tagThreshold);
+    auto const statsEnd(alloc.getStats());
+
+    // Only the first block fits into the cache.
+    CHECK(statsBegin.m_releaseCount + 1u == statsEnd.m_releaseCount);
+    CHECK(4096u == statsEnd.m_cachedBytes);
+
+    alloc.setReleaseThreshold(releaseThresholdBytes);
+    alloc.release();
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE( "allocCpuCachingReleaseShouldEmptyTheCaches", "[memBuf]")
+{
+    auto & alloc(alpaka::mem::alloc::AllocCpuCaching::get());
+
+    // One block small enough for the thread cache and one for the global pool.
+    std::size_t const smallBytes(256u);
+    std::size_t const largeBytes(std::size_t(4u) << 20u);
+    auto const pSmall(alloc.alloc(smallBytes, tagRelease));
+    auto const pLarge(alloc.alloc(largeBytes, tagRelease));
+    REQUIRE(nullptr != pSmall);
+    REQUIRE(nullptr != pLarge);
+    alloc.free(pSmall, smallBytes, tagRelease);
+    alloc.free(pLarge, largeBytes, tagRelease);
+    CHECK(alloc.getStats().m_cachedBytes >= smallBytes + largeBytes);
+
+    auto const releaseCount(alloc.getStats().m_releaseCount);
+    alloc.release();
+    auto const stats(alloc.getStats());
+    CHECK(0u == stats.m_cachedBytes);
+    CHECK(releaseCount + 2u <= stats.m_releaseCount);
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE( "bufCpuWithCachingShouldReuseTheMemory", "[memBuf]")
+{
+    using Elem = float;
+    using Idx = std::size_t;
+    auto const dev(alpaka::pltf::getDevByIdx<alpaka::pltf::PltfCpu>(0u));
+    Idx const elementCount(1000u);
+
+    CHECK(!alpaka::mem::buf::cpu::isCaching());
+    ScopedCaching const caching;
+    CHECK(alpaka::mem::buf::cpu::isCaching());
+
+    auto & alloc(alpaka::mem::alloc::AllocCpuCaching::get());
+    auto const statsBegin(alloc.getStats());
+
+    Elem * pMem(nullptr);
+    {
+        auto buf(alpaka::mem::buf::alloc<Elem, Idx>(dev, elementCount));
+        pMem = alpaka::mem::view::getPtrNative(buf);
+        REQUIRE(nullptr != pMem);
+        for(Idx i(0u); i < elementCount; ++i)
+        {
+            pMem[i] = static_cast<Elem>(i);
+        }
+    }
+    {
+        auto buf(alpaka::mem::buf::alloc<Elem, Idx>(dev, elementCount));
+        CHECK(pMem == alpaka::mem::view::getPtrNative(buf));
+    }
+
+    auto const statsEnd(alloc.getStats());
+    CHECK(statsBegin.m_allocCount + 2u == statsEnd.m_allocCount);
+    CHECK(statsBegin.m_cacheHitCount + 1u <= statsEnd.m_cacheHitCount);
+    CHECK(statsBegin.m_freeCount + 2u == statsEnd.m_freeCount);
+    CHECK(statsBegin.m_usedBytes == statsEnd.m_usedBytes);
+
+    alloc.release();
+}
@@ -0,0 +1,117 @@
+/* Copyright 2019 Benjamin Worpitz
+ *
+ * This file is part of Alpaka.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <alpaka/mem/buf/cpu/FirstTouch.hpp>
+#include <alpaka/core/ThreadAffinity.hpp>
+#include <alpaka/dev/DevCpu.hpp>
+#include <alpaka/dim/DimArithmetic.hpp>
+#include <alpaka/mem/buf/BufCpu.hpp>
+#include <alpaka/pltf/PltfCpu.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+    //-----------------------------------------------------------------------------
+    //! \return A policy with the given number of workers which are all pinned to a CPU the calling thread may run on.
+    auto getPolicyWithWorkers(
+        std::size_t const workerCount)
+    -> alpaka::core::threads::AffinityPolicy
+    {
+        auto const callerCpus(alpaka::core::threads::getCurrentThreadAffinity());
+        std::uint32_t const cpu(callerCpus.empty() ? 0u : callerCpus.front());
+        return alpaka::core::threads::AffinityPolicy::explicitCpus(std::vector<std::uint32_t>(workerCount, cpu));
+    }
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE( "touchPagesShouldTouchAllPagesWithinTheRange", "[memBuf]")
+{
+    auto const pageBytes(alpaka::mem::buf::cpu::detail::getPageBytes());
+
+    // With four workers and enough pages the range is touched by multiple threads.
+    for(std::size_t const workerCount : {1u, 4u})
+    {
+        auto const policy(getPolicyWithWorkers(workerCount));
+
+        std::size_t const sizeBytes(2048u * pageBytes + 100u);
+        std::size_t const offsetBytes(100u);
+        std::vector<std::uint8_t> mem(offsetBytes + sizeBytes + pageBytes, std::uint8_t(0xffu));
+
+        alpaka::mem::buf::cpu::detail::touchPages(mem.data() + offsetBytes, sizeBytes, policy);
+
+        // The first byte of the range and the first bytes of all pages within the range have been written.
+        std::size_t touchCount(0u);
+        for(std::size_t i(0u); i < mem.size(); ++i)
+        {
+            auto const bWithinRange((i >= offsetBytes) && (i < offsetBytes + sizeBytes));
+            auto const bPageStart((reinterpret_cast<std::uintptr_t>(mem.data() + i) % pageBytes) == 0u);
+            auto const bTouchExpected(bWithinRange && ((i == offsetBytes) || bPageStart));
+            if(bTouchExpected)
+            {
+                ++touchCount;
+            }
+            if(bTouchExpected != (mem[i] == 0u))
+            {
+                FAIL("Byte " << i << " has been touched unexpectedly or has not been touched.");
+            }
+        }
+        CHECK(touchCount > 2048u);
+    }
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE( "firstTouchPolicyShouldFollowTheDeviceAffinityPolicy", "[memBuf]")
+{
+    auto const dev(alpaka::pltf::getDevByIdx<alpaka::pltf::PltfCpu>(0u));
+
+    // The pages of a device without pinned workers are spread over all of its CPUs.
+    auto const inheritPolicy(alpaka::mem::buf::cpu::detail::getFirstTouchPolicy(dev));
+    CHECK(alpaka::core::threads::AffinityPolicy::Kind::Explicit == inheritPolicy.getKind());
+    CHECK(alpaka::dev::cpu::getCpuSet(dev) == inheritPolicy.getCpus());
+
+    auto const policy(alpaka::core::threads::AffinityPolicy::compact(alpaka::dev::cpu::getCpuSet(dev)));
+    alpaka::dev::cpu::setAffinityPolicy(dev, policy);
+    CHECK(policy == alpaka::mem::buf::cpu::detail::getFirstTouchPolicy(dev));
+    alpaka::dev::cpu::setAffinityPolicy(dev, alpaka::core::threads::AffinityPolicy::inherit());
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE( "bufCpuWithFirstTouchShouldBeUsable", "[memBuf]")
+{
+    using Elem = std::uint32_t;
+    using Idx = std::size_t;
+    auto const dev(alpaka::pltf::getDevByIdx<alpaka::pltf::PltfCpu>(0u));
+    alpaka::dev::cpu::setAffinityPolicy(dev, getPolicyWithWorkers(4u));
+
+    CHECK(!alpaka::mem::buf::cpu::isFirstTouch());
+    alpaka::mem::buf::cpu::setFirstTouch(true);
+    CHECK(alpaka::mem::buf::cpu::isFirstTouch());
+
+    for(Idx const elementCount : {Idx(0u), Idx(1u), Idx(1u) << 20u})
+    {
+        auto buf(alpaka::mem::buf::alloc<Elem, Idx>(dev, elementCount));
+        auto const pBuf(alpaka::mem::view::getPtrNative(buf));
+        for(Idx i(0u); i < elementCount; ++i)
+        {
+            pBuf[i] = static_cast<Elem>(i);
+        }
+        if(elementCount > 0u)
+        {
+            CHECK(static_cast<Elem>(elementCount - 1u) == pBuf[elementCount - 1u]);
+        }
+    }
+
+    alpaka::mem::buf::cpu::setFirstTouch(false);
+    alpaka::dev::cpu::setAffinityPolicy(dev, alpaka::core::threads::AffinityPolicy::inherit());
+}
@@ -0,0 +1,109 @@
+/* Copyright 2019 Benjamin Worpitz
+ *
+ * This file is part of Alpaka.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <alpaka/mem/alloc/AllocCpuHugePages.hpp>
+#include <alpaka/dev/DevCpu.hpp>
+#include <alpaka/dim/DimArithmetic.hpp>
+#include <alpaka/mem/buf/BufCpu.hpp>
+#include <alpaka/pltf/PltfCpu.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace
+{
+    std::size_t const hugePageBytes(std::size_t(2u) << 20u);
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE( "allocCpuHugePagesShouldPadToHugePages", "[memBuf]")
+{
+    using Alloc = alpaka::mem::alloc::AllocCpuHugePages;
+
+    CHECK(0u == Alloc::getAllocBytes(0u));
+    CHECK(hugePageBytes == Alloc::getAllocBytes(1u));
+    CHECK(hugePageBytes == Alloc::getAllocBytes(hugePageBytes));
+    CHECK(2u * hugePageBytes == Alloc::getAllocBytes(hugePageBytes + 1u));
+
+    CHECK(nullptr == Alloc::alloc(0u, alpaka::mem::alloc::HugePages::Transparent));
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE( "allocCpuHugePagesShouldAlignToHugePages", "[memBuf]")
+{
+    using Alloc = alpaka::mem::alloc::AllocCpuHugePages;
+
+    for(auto const hugePages : {alpaka::mem::alloc::HugePages::Disabled, alpaka::mem::alloc::HugePages::Transparent, alpaka::mem::alloc::HugePages::HugeTlb})
+    {
+        // HugeTlb falls back to transparent huge pages if no huge pages are reserved.
+        std::size_t const sizeBytes(3u * hugePageBytes + 100u);
+        auto const p(static_cast<std::uint8_t *>(Alloc::alloc(sizeBytes, hugePages)));
+        REQUIRE(nullptr != p);
+        CHECK(0u == reinterpret_cast<std::uintptr_t>(p) % hugePageBytes);
+
+        p[0] = 1u;
+        p[sizeBytes - 1u] = 2u;
+        CHECK(1u == p[0]);
+        CHECK(2u == p[sizeBytes - 1u]);
+
+        Alloc::free(p, sizeBytes);
+    }
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE( "bufCpuShouldUseHugePagesAboveTheThreshold", "[memBuf]")
+{
+    CHECK(alpaka::mem::alloc::HugePages::Disabled == alpaka::mem::buf::cpu::getHugePages(std::size_t(1u) << 40u));
+
+    alpaka::mem::buf::cpu::setHugePages(alpaka::mem::alloc::HugePages::Transparent, 4u * hugePageBytes);
+    CHECK(alpaka::mem::alloc::HugePages::Disabled == alpaka::mem::buf::cpu::getHugePages(4u * hugePageBytes - 1u));
+    CHECK(alpaka::mem::alloc::HugePages::Transparent == alpaka::mem::buf::cpu::getHugePages(4u * hugePageBytes));
+
+    using Elem = float;
+    using Idx = std::size_t;
+    auto const dev(alpaka::pltf::getDevByIdx<alpaka::pltf::PltfCpu>(0u));
+
+    auto const bufSmall(alpaka::mem::buf::alloc<Elem, Idx>(dev, hugePageBytes / sizeof(Elem)));
+    auto const bufLarge(alpaka::mem::buf::alloc<Elem, Idx>(dev, 4u * hugePageBytes / sizeof(Elem)));
+    CHECK(alpaka::mem::alloc::HugePages::Disabled == bufSmall.m_spBufCpuImpl->m_hugePages);
+    CHECK(alpaka::mem::alloc::HugePages::Transparent == bufLarge.m_spBufCpuImpl->m_hugePages);
+    CHECK(0u == reinterpret_cast<std::uintptr_t>(alpaka::mem::view::getPtrNative(bufLarge)) % hugePageBytes);
+
+    alpaka::mem::buf::cpu::setHugePages(alpaka::mem::alloc::HugePages::Disabled);
+    CHECK(alpaka::mem::alloc::HugePages::Disabled == alpaka::mem::buf::cpu::getHugePages(std::size_t(1u) << 40u));
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE( "bufCpuShouldUseTheExplicitlySelectedHugePages", "[memBuf]")
+{
+    using Elem = std::uint32_t;
+    using Idx = std::size_t;
+    auto const dev(alpaka::pltf::getDevByIdx<alpaka::pltf::PltfCpu>(0u));
+    Idx const elementCount(1000u);
+
+    // The explicit selection also applies to buffers below the threshold.
+    alpaka::mem::buf::cpu::setCaching(true);
+    auto buf(alpaka::mem::buf::cpu::alloc<Elem, Idx>(dev, elementCount, alpaka::mem::alloc::HugePages::Transparent));
+    alpaka::mem::buf::cpu::setCaching(false);
+
+    CHECK(alpaka::mem::alloc::HugePages::Transparent == buf.m_spBufCpuImpl->m_hugePages);
+    CHECK(!buf.m_spBufCpuImpl->m_bCached);
+    CHECK(elementCount == alpaka::extent::getExtentProduct(buf));
+
+    auto const pBuf(alpaka::mem::view::getPtrNative(buf));
+    REQUIRE(nullptr != pBuf);
+    CHECK(0u == reinterpret_cast<std::uintptr_t>(pBuf) % hugePageBytes);
+    for(Idx i(0u); i < elementCount; ++i)
+    {
+        pBuf[i] = static_cast<Elem>(i);
+    }
+    CHECK(static_cast<Elem>(elementCount - 1u) == pBuf[elementCount - 1u]);
+}
@@ -0,0 +1,234 @@
+/* Copyright 2019 Benjamin Worpitz
+ *
+ * This file is part of Alpaka.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <alpaka/acc/AccCpuThreads.hpp>
+#include <alpaka/core/ThreadAffinity.hpp>
+#include <alpaka/dev/DevCpu.hpp>
+#include <alpaka/idx/Accessors.hpp>
+#include <alpaka/kernel/TaskKernelCpuThreads.hpp>
+#include <alpaka/pltf/PltfCpu.hpp>
+#include <alpaka/queue/QueueCpuBlocking.hpp>
+#include <alpaka/queue/QueueCpuConcurrent.hpp>
+#include <alpaka/queue/QueueCpuNonBlocking.hpp>
+#include <alpaka/wait/Traits.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <iterator>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+TEST_CASE( "queueCpuShouldUseTheAffinityPolicyOfTheDevice", "[queue]")
+{
+    auto const dev(alpaka::pltf::getDevByIdx<alpaka::pltf::PltfCpu>(0u));
+    auto const policy(alpaka::core::threads::AffinityPolicy::scatter(alpaka::dev::cpu::getCpuSet(dev)));
+
+    CHECK(alpaka::core::threads::AffinityPolicy::Kind::Inherit == alpaka::dev::cpu::getAffinityPolicy(dev).getKind());
+    alpaka::dev::cpu::setAffinityPolicy(dev, policy);
+    CHECK(policy == alpaka::dev::cpu::getAffinityPolicy(dev));
+
+    alpaka::queue::QueueCpuNonBlocking queueNonBlocking(dev);
+    alpaka::queue::QueueCpuBlocking queueBlocking(dev);
+    alpaka::queue::QueueCpuConcurrent queueConcurrent(dev, 2u);
+    CHECK(policy == alpaka::queue::cpu::getAffinityPolicy(queueNonBlocking));
+    CHECK(policy == alpaka::queue::cpu::getAffinityPolicy(queueBlocking));
+    CHECK(policy == alpaka::queue::cpu::getAffinityPolicy(queueConcurrent));
+
+    // The policy of a queue can differ from the one of its device.
+    alpaka::queue::QueueCpuNonBlocking queueInherit(dev, alpaka::core::threads::AffinityPolicy::inherit());
+    CHECK(alpaka::core::threads::AffinityPolicy::Kind::Inherit == alpaka::queue::cpu::getAffinityPolicy(queueInherit).getKind());
+
+    alpaka::dev::cpu::setAffinityPolicy(dev, alpaka::core::threads::AffinityPolicy::inherit());
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE( "queueCpuShouldPinItsWorkerAccordingToThePolicy", "[queue]")
+{
+    auto const dev(alpaka::pltf::getDevByIdx<alpaka::pltf::PltfCpu>(0u));
+    auto const callerCpus(alpaka::core::threads::getCurrentThreadAffinity());
+    if(callerCpus.empty())
+    {
+        // The affinity is not supported on this system.
+        return;
+    }
+
+    auto const policy(alpaka::core::threads::AffinityPolicy::explicitCpus({callerCpus.back()}));
+
+    alpaka::queue::QueueCpuNonBlocking queueNonBlocking(dev, policy);
+    alpaka::core::threads::AffinityPolicy::Kind nonBlockingKind(alpaka::core::threads::AffinityPolicy::Kind::Inherit);
+    alpaka::queue::enqueue(
+        queueNonBlocking,
+        [&nonBlockingKind]() noexcept
+        {
+            nonBlockingKind = alpaka::core::threads::getCurrentAffinityPolicy().getKind();
+        });
+    alpaka::wait::wait(queueNonBlocking);
+    CHECK(policy.getCpus() == alpaka::queue::cpu::getWorkerAffinity(queueNonBlocking));
+    CHECK(alpaka::core::threads::AffinityPolicy::Kind::Explicit == nonBlockingKind);
+
+    alpaka::queue::QueueCpuBlocking queueBlocking(dev, policy);
+    std::vector<std::uint32_t> blockingCpus;
+    alpaka::queue::enqueue(
+        queueBlocking,
+        [&blockingCpus]()
+        {
+            blockingCpus = alpaka::core::threads::getCurrentThreadAffinity();
+        });
+    CHECK(policy.getCpus() == blockingCpus);
+    // The blocking queue restores the affinity and the policy of the calling thread.
+    CHECK(callerCpus == alpaka::core::threads::getCurrentThreadAffinity());
+    CHECK(alpaka::core::threads::AffinityPolicy::Kind::Inherit == alpaka::core::threads::getCurrentAffinityPolicy().getKind());
+
+    alpaka::queue::QueueCpuConcurrent queueConcurrent(dev, 2u, policy);
+    std::vector<std::uint32_t> concurrentCpus;
+    alpaka::queue::enqueue(
+        queueConcurrent,
+        [&concurrentCpus]()
+        {
+            concurrentCpus = alpaka::core::threads::getCurrentThreadAffinity();
+        });
+    alpaka::wait::wait(queueConcurrent);
+    CHECK(policy.getCpus() == concurrentCpus);
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE( "queueCpuConcurrentShouldGiveEachWorkerItsOwnCpus", "[queue]")
+{
+    auto const dev(alpaka::pltf::getDevByIdx<alpaka::pltf::PltfCpu>(0u));
+    std::size_t const workerCount(2u);
+    auto const policy(alpaka::core::threads::AffinityPolicy::explicitCpus({0u, 1u, 2u, 3u}));
+    alpaka::queue::QueueCpuConcurrent queue(dev, workerCount, policy);
+
+    // The tasks wait for each other, so they are executed concurrently by different workers.
+    std::atomic<std::size_t> startedCount(0u);
+    std::array<std::vector<std::uint32_t>, 2u> taskCpus;
+    for(std::size_t i(0u); i < workerCount; ++i)
+    {
+        alpaka::queue::enqueue(
+            queue,
+            alpaka::queue::cpu::withAccesses(
+                [i, workerCount, &startedCount, &taskCpus]()
+                {
+                    ++startedCount;
+                    while(startedCount.load() < workerCount)
+                    {
+                        std::this_thread::yield();
+                    }
+                    taskCpus[i] = alpaka::core::threads::getCurrentAffinityPolicy().getCpus();
+                },
+                alpaka::queue::cpu::reads()));
+    }
+    alpaka::wait::wait(queue);
+
+    // The kernels executed by the workers pin their block threads to disjoint slices of the policy.
+    auto allCpus(taskCpus[0u]);
+    allCpus.insert(allCpus.end(), taskCpus[1u].begin(), taskCpus[1u].end());
+    std::sort(allCpus.begin(), allCpus.end());
+    CHECK(2u == taskCpus[0u].size());
+    CHECK(2u == taskCpus[1u].size());
+    CHECK(policy.getCpus() == allCpus);
+}
+
+#ifdef ALPAKA_ACC_CPU_B_SEQ_T_THREADS_ENABLED
+//#############################################################################
+//! Records the CPUs the block threads are allowed to run on.
+//! The first block thread waits until all kernels have been started, so that the kernels run concurrently.
+class AffinityRecordingKernel
+{
+public:
+    //-----------------------------------------------------------------------------
+    template<
+        typename TAcc>
+    ALPAKA_FN_ACC auto operator()(
+        TAcc const & acc,
+        std::atomic<std::size_t> * pStartedCount,
+        std::size_t kernelCount,
+        std::mutex * pMtx,
+        std::vector<std::uint32_t> * pCpus) const
+    -> void
+    {
+        if(alpaka::idx::getIdx<alpaka::Block, alpaka::Threads>(acc)[0u] == 0u)
+        {
+            ++(*pStartedCount);
+            while(pStartedCount->load() < kernelCount)
+            {
+                std::this_thread::yield();
+            }
+        }
+        auto const cpus(alpaka::core::threads::getCurrentThreadAffinity());
+        std::lock_guard<std::mutex> lock(*pMtx);
+        pCpus->insert(pCpus->end(), cpus.begin(), cpus.end());
+    }
+};
+
+//-----------------------------------------------------------------------------
+TEST_CASE( "queueCpuConcurrentShouldPinTheKernelsOfItsWorkersToDisjointCpus", "[queue]")
+{
+    using Dim = alpaka::dim::DimInt<1u>;
+    using Idx = std::size_t;
+    using Acc = alpaka::acc::AccCpuThreads<Dim, Idx>;
+    using Vec = alpaka::vec::Vec<Dim, Idx>;
+
+    std::size_t const workerCount(2u);
+    auto const callerCpus(alpaka::core::threads::getCurrentThreadAffinity());
+    if(callerCpus.size() < 2u * workerCount)
+    {
+        // Disjoint slices require at least one CPU per block thread.
+        return;
+    }
+
+    auto const dev(alpaka::pltf::getDevByIdx<alpaka::pltf::PltfCpu>(0u));
+    auto const policy(alpaka::core::threads::AffinityPolicy::explicitCpus(
+        std::vector<std::uint32_t>(callerCpus.begin(), callerCpus.begin() + 2u * workerCount)));
+    alpaka::queue::QueueCpuConcurrent queue(dev, workerCount, policy);
+
+    alpaka::workdiv::WorkDivMembers<Dim, Idx> const workDiv(
+        Vec(static_cast<Idx>(1u)),
+        Vec(static_cast<Idx>(2u)),
+        Vec(static_cast<Idx>(1u)));
+    std::atomic<std::size_t> startedCount(0u);
+    std::array<std::mutex, 2u> mutexes;
+    std::array<std::vector<std::uint32_t>, 2u> kernelCpus;
+    for(std::size_t i(0u); i < workerCount; ++i)
+    {
+        alpaka::queue::enqueue(
+            queue,
+            alpaka::queue::cpu::withAccesses(
+                alpaka::kernel::createTaskKernel<Acc>(
+                    workDiv,
+                    AffinityRecordingKernel(),
+                    &startedCount,
+                    workerCount,
+                    &mutexes[i],
+                    &kernelCpus[i]),
+                alpaka::queue::cpu::reads()));
+    }
+    alpaka::wait::wait(queue);
+
+    for(auto & cpus : kernelCpus)
+    {
+        std::sort(cpus.begin(), cpus.end());
+        cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+    }
+    std::vector<std::uint32_t> sharedCpus;
+    std::set_intersection(
+        kernelCpus[0u].begin(), kernelCpus[0u].end(),
+        kernelCpus[1u].begin(), kernelCpus[1u].end(),
+        std::back_inserter(sharedCpus));
+    CHECK(!kernelCpus[0u].empty());
+    CHECK(!kernelCpus[1u].empty());
+    CHECK(sharedCpus.empty());
+}
+#endif
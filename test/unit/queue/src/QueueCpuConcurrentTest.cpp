@@ -0,0 +1,274 @@
+/* Copyright 2019 Benjamin Worpitz
+ *
+ * This file is part of Alpaka.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <alpaka/queue/QueueCpuConcurrent.hpp>
+
+#include <alpaka/event/EventCpu.hpp>
+#include <alpaka/mem/buf/BufCpu.hpp>
+#include <alpaka/pltf/PltfCpu.hpp>
+#include <alpaka/queue/QueueCpuNonBlocking.hpp>
+#include <alpaka/test/event/EventHostManualTrigger.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    using Idx = std::size_t;
+
+    //-----------------------------------------------------------------------------
+    //! Waits until the given number of tasks have arrived or the timeout has elapsed.
+    //! \return If all tasks have arrived.
+    auto arriveAndWait(
+        std::atomic<std::size_t> & arrivedCount,
+        std::size_t const taskCount)
+    -> bool
+    {
+        ++arrivedCount;
+        auto const tpEnd(std::chrono::steady_clock::now() + std::chrono::seconds(10));
+        while(arrivedCount.load() < taskCount)
+        {
+            if(std::chrono::steady_clock::now() > tpEnd)
+            {
+                return false;
+            }
+            std::this_thread::yield();
+        }
+        return true;
+    }
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE( "queueCpuConcurrentShouldOverlapIndependentTasks", "[queue]")
+{
+    auto const dev(alpaka::pltf::getDevByIdx<alpaka::pltf::PltfCpu>(0u));
+    alpaka::queue::QueueCpuConcurrent queue(dev, 2u);
+
+    auto bufA(alpaka::mem::buf::alloc<int, Idx>(dev, Idx(16u)));
+    auto bufB(alpaka::mem::buf::alloc<int, Idx>(dev, Idx(16u)));
+
+    // Both tasks only complete if they are executed at the same time.
+    std::atomic<std::size_t> arrivedCount(0u);
+    std::atomic<bool> bTaskAOverlapped(false);
+    std::atomic<bool> bTaskBOverlapped(false);
+
+    alpaka::queue::enqueue(
+        queue,
+        alpaka::queue::cpu::withAccesses(
+            [&](){bTaskAOverlapped = arriveAndWait(arrivedCount, 2u);},
+            alpaka::queue::cpu::reads(),
+            alpaka::queue::cpu::writes(bufA)));
+    alpaka::queue::enqueue(
+        queue,
+        alpaka::queue::cpu::withAccesses(
+            [&](){bTaskBOverlapped = arriveAndWait(arrivedCount, 2u);},
+            alpaka::queue::cpu::reads(),
+            alpaka::queue::cpu::writes(bufB)));
+
+    alpaka::wait::wait(queue);
+
+    CHECK(bTaskAOverlapped);
+    CHECK(bTaskBOverlapped);
+    CHECK(alpaka::queue::empty(queue));
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE( "queueCpuConcurrentShouldOrderConflictingTasks", "[queue]")
+{
+    auto const dev(alpaka::pltf::getDevByIdx<alpaka::pltf::PltfCpu>(0u));
+    alpaka::queue::QueueCpuConcurrent queue(dev, 4u);
+
+    auto bufA(alpaka::mem::buf::alloc<int, Idx>(dev, Idx(16u)));
+    auto bufB(alpaka::mem::buf::alloc<int, Idx>(dev, Idx(16u)));
+    auto const pA(alpaka::mem::view::getPtrNative(bufA));
+    auto const pB(alpaka::mem::view::getPtrNative(bufB));
+
+    std::size_t const repeatCount(100u);
+    for(std::size_t i(0u); i < repeatCount; ++i)
+    {
+        // Write after write.
+        alpaka::queue::enqueue(
+            queue,
+            alpaka::queue::cpu::withAccesses(
+                [pA]()
+                {
+                    std::this_thread::sleep_for(std::chrono::microseconds(100u));
+                    pA[0] = 1;
+                },
+                alpaka::queue::cpu::reads(),
+                alpaka::queue::cpu::writes(bufA)));
+        alpaka::queue::enqueue(
+            queue,
+            alpaka::queue::cpu::withAccesses(
+                [pA]() noexcept{pA[0] = 2;},
+                alpaka::queue::cpu::reads(),
+                alpaka::queue::cpu::writes(bufA)));
+        // Read after write.
+        alpaka::queue::enqueue(
+            queue,
+            alpaka::queue::cpu::withAccesses(
+                [pA, pB]() noexcept{pB[0] = pA[0];},
+                alpaka::queue::cpu::reads(bufA),
+                alpaka::queue::cpu::writes(bufB)));
+        // Write after read.
+        alpaka::queue::enqueue(
+            queue,
+            alpaka::queue::cpu::withAccesses(
+                [pA]() noexcept{pA[0] = 3;},
+                alpaka::queue::cpu::reads(),
+                alpaka::queue::cpu::writes(bufA)));
+
+        alpaka::wait::wait(queue);
+
+        REQUIRE(3 == pA[0]);
+        REQUIRE(2 == pB[0]);
+    }
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE( "queueCpuConcurrentShouldExecuteTasksWithoutAccessesInOrder", "[queue]")
+{
+    auto const dev(alpaka::pltf::getDevByIdx<alpaka::pltf::PltfCpu>(0u));
+    alpaka::queue::QueueCpuConcurrent queue(dev, 4u);
+
+    auto bufA(alpaka::mem::buf::alloc<int, Idx>(dev, Idx(16u)));
+    auto const pA(alpaka::mem::view::getPtrNative(bufA));
+
+    // Only the queue writes, so no synchronization is required besides waiting for the queue.
+    std::vector<int> order;
+    for(int i(0); i < 100; ++i)
+    {
+        alpaka::queue::enqueue(queue, [&order, i](){order.push_back(i);});
+        // The barriers also order the tasks with accesses.
+        alpaka::queue::enqueue(
+            queue,
+            alpaka::queue::cpu::withAccesses(
+                [pA, i]() noexcept{pA[0] = i;},
+                alpaka::queue::cpu::reads(),
+                alpaka::queue::cpu::writes(bufA)));
+        alpaka::queue::enqueue(queue, [&order, pA](){order.push_back(pA[0]);});
+    }
+    alpaka::wait::wait(queue);
+
+    REQUIRE(200u == order.size());
+    for(std::size_t i(0u); i < order.size(); ++i)
+    {
+        CHECK(static_cast<int>(i / 2u) == order[i]);
+    }
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE( "queueCpuConcurrentEventShouldWaitForAllEarlierTasks", "[queue]")
+{
+    auto const dev(alpaka::pltf::getDevByIdx<alpaka::pltf::PltfCpu>(0u));
+    alpaka::queue::QueueCpuConcurrent queue(dev, 4u);
+    alpaka::event::EventCpu event(dev);
+
+    std::vector<alpaka::mem::buf::Buf<alpaka::dev::DevCpu, int, alpaka::dim::DimInt<1u>, Idx>> bufs;
+    std::atomic<std::size_t> executedCount(0u);
+    for(std::size_t i(0u); i < 8u; ++i)
+    {
+        bufs.emplace_back(alpaka::mem::buf::alloc<int, Idx>(dev, Idx(16u)));
+        alpaka::queue::enqueue(
+            queue,
+            alpaka::queue::cpu::withAccesses(
+                [&executedCount]()
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1u));
+                    ++executedCount;
+                },
+                alpaka::queue::cpu::reads(),
+                alpaka::queue::cpu::writes(bufs.back())));
+    }
+    alpaka::queue::enqueue(queue, event);
+
+    alpaka::wait::wait(event);
+    CHECK(8u == executedCount.load());
+
+    alpaka::wait::wait(queue);
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE( "queueCpuConcurrentWaitForEventShouldStopLaterTasks", "[queue]")
+{
+    auto const dev(alpaka::pltf::getDevByIdx<alpaka::pltf::PltfCpu>(0u));
+    alpaka::queue::QueueCpuNonBlocking queueOther(dev);
+    alpaka::queue::QueueCpuConcurrent queue(dev, 2u);
+    alpaka::event::EventCpu event(dev);
+
+    alpaka::test::event::EventHostManualTrigger<alpaka::dev::DevCpu> trigger(dev);
+    alpaka::queue::enqueue(queueOther, trigger);
+    alpaka::queue::enqueue(queueOther, event);
+
+    std::atomic<bool> bExecuted(false);
+    alpaka::wait::wait(queue, event);
+    alpaka::queue::enqueue(queue, [&bExecuted]() noexcept{bExecuted = true;});
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(10u));
+    CHECK(!bExecuted.load());
+    CHECK(!alpaka::queue::empty(queue));
+
+    trigger.trigger();
+    alpaka::wait::wait(queue);
+
+    CHECK(bExecuted.load());
+    CHECK(alpaka::event::test(event));
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE( "queueCpuConcurrentCanBeDestroyedRightAfterTheWaitedForEventIsCompleted", "[queue]")
+{
+    auto const dev(alpaka::pltf::getDevByIdx<alpaka::pltf::PltfCpu>(0u));
+    alpaka::queue::QueueCpuNonBlocking queueOther(dev);
+
+    // The gate of the wait is submitted by the worker of the other queue while this queue is destroyed.
+    for(std::size_t i(0u); i < 100u; ++i)
+    {
+        alpaka::event::EventCpu event(dev);
+        alpaka::test::event::EventHostManualTrigger<alpaka::dev::DevCpu> trigger(dev);
+        alpaka::queue::enqueue(queueOther, trigger);
+        alpaka::queue::enqueue(queueOther, event);
+
+        {
+            alpaka::queue::QueueCpuConcurrent queue(dev, 2u);
+            alpaka::wait::wait(queue, event);
+
+            trigger.trigger();
+        }
+
+        alpaka::wait::wait(queueOther);
+    }
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE( "queueCpuConcurrentShouldDivideTheHardwareThreadsBetweenTheWorkers", "[queue]")
+{
+    auto const dev(alpaka::pltf::getDevByIdx<alpaka::pltf::PltfCpu>(0u));
+    std::size_t const workerCount(4u);
+    alpaka::queue::QueueCpuConcurrent queue(dev, workerCount);
+
+    auto const hardwareThreadCount(alpaka::core::threads::getCurrentHardwareThreadCount());
+    std::size_t taskHardwareThreadCount(0u);
+    alpaka::queue::enqueue(
+        queue,
+        [&taskHardwareThreadCount]()
+        {
+            taskHardwareThreadCount = alpaka::core::threads::getCurrentHardwareThreadCount();
+        });
+    alpaka::wait::wait(queue);
+
+    CHECK(std::max(hardwareThreadCount / workerCount, static_cast<std::size_t>(1u)) == taskHardwareThreadCount);
+    CHECK(hardwareThreadCount == alpaka::core::threads::getCurrentHardwareThreadCount());
+}
@@ -8,7 +8,12 @@
  */
 
 #include <alpaka/queue/Traits.hpp>
+#include <alpaka/event/Traits.hpp>
 #include <alpaka/meta/Concatenate.hpp>
+#include <alpaka/pltf/PltfCpu.hpp>
+#include <alpaka/queue/QueueCpuBlocking.hpp>
+#include <alpaka/queue/QueueCpuConcurrent.hpp>
+#include <alpaka/queue/QueueCpuNonBlocking.hpp>
 
 #include <alpaka/test/queue/QueueCpuOmp2Collective.hpp>
 
@@ -18,7 +23,12 @@
 #include <catch2/catch.hpp>
 
 #include <future>
+#include <memory>
+#include <stdexcept>
 #include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 //-----------------------------------------------------------------------------
 struct TestTemplateEmpty
@@ -161,6 +171,172 @@ void operator()()
 }
 };
 
+//-----------------------------------------------------------------------------
+struct TestTemplateEnqueueBatch
+{
+template< typename TDevQueue >
+void operator()()
+{
+// Workaround: Clang can not support this when natively compiling device code. See ConcurrentExecPool.hpp.
+#if !(BOOST_COMP_CLANG_CUDA && BOOST_ARCH_PTX)
+    using Fixture = alpaka::test::queue::QueueTestFixture<TDevQueue>;
+    using Queue = typename Fixture::Queue;
+    Fixture f;
+
+    alpaka::event::Event<Queue> event(f.m_dev);
+
+    // Only the queue writes, so no synchronization is required besides waiting for the queue.
+    std::vector<int> order;
+
+    alpaka::queue::enqueueBatch(
+        f.m_queue,
+        [&order](){order.push_back(0);},
+        [&order](){order.push_back(1);},
+        event,
+        [&order](){order.push_back(2);},
+        event);
+
+    alpaka::wait::wait(event);
+    CHECK(alpaka::event::test(event));
+    CHECK((std::vector<int>{0, 1, 2}) == order);
+
+    // An empty batch is allowed.
+    alpaka::queue::enqueueBatch(f.m_queue);
+
+    alpaka::wait::wait(f.m_queue);
+    CHECK(alpaka::queue::empty(f.m_queue));
+#endif
+}
+};
+
+//-----------------------------------------------------------------------------
+//! A function object which can not be copied into a queue.
+class ThrowingCopyTask
+{
+public:
+    //-----------------------------------------------------------------------------
+    ThrowingCopyTask() = default;
+    //-----------------------------------------------------------------------------
+    ThrowingCopyTask(ThrowingCopyTask const &)
+    {
+        throw std::runtime_error("ThrowingCopyTask can not be copied!");
+    }
+    //-----------------------------------------------------------------------------
+    void operator()() const noexcept
+    {}
+};
+
+//-----------------------------------------------------------------------------
+struct TestTemplateEnqueueBatchThrowing
+{
+template< typename TQueue >
+void operator()()
+{
+    auto const dev(alpaka::pltf::getDevByIdx<alpaka::pltf::PltfCpu>(0u));
+    TQueue queue(dev);
+
+    alpaka::event::Event<TQueue> event(dev);
+
+    // The event is contained twice. Both enqueues are reverted because the batch is not enqueued.
+    CHECK_THROWS_AS(
+        alpaka::queue::enqueueBatch(
+            queue,
+            event,
+            event,
+            ThrowingCopyTask()),
+        std::runtime_error);
+    CHECK(alpaka::event::test(event));
+
+    alpaka::queue::enqueue(queue, event);
+    alpaka::wait::wait(event);
+    CHECK(alpaka::event::test(event));
+}
+};
+
+//-----------------------------------------------------------------------------
+//! A move-only function object.
+class MoveOnlyAppender
+{
+public:
+    //-----------------------------------------------------------------------------
+    explicit MoveOnlyAppender(std::vector<int> & values) :
+        m_upValues(new std::vector<int>*(&values))
+    {}
+    //-----------------------------------------------------------------------------
+    MoveOnlyAppender(MoveOnlyAppender const &) = delete;
+    //-----------------------------------------------------------------------------
+    MoveOnlyAppender(MoveOnlyAppender &&) = default;
+
+    //-----------------------------------------------------------------------------
+    void operator()(std::unique_ptr<int> upValue)
+    {
+        (*m_upValues)->push_back(*upValue);
+    }
+
+private:
+    std::unique_ptr<std::vector<int> *> m_upValues;
+};
+
+//-----------------------------------------------------------------------------
+struct TestTemplateEnqueueHostFn
+{
+template< typename TQueue >
+void operator()()
+{
+    auto const dev(alpaka::pltf::getDevByIdx<alpaka::pltf::PltfCpu>(0u));
+    TQueue queue(dev);
+
+    std::vector<int> values;
+
+    // A move-only argument is moved into the function.
+    alpaka::queue::enqueueHostFn(
+        queue,
+        [&values](std::unique_ptr<int> upValue, int const offset)
+        {
+            values.push_back(*upValue + offset);
+        },
+        std::unique_ptr<int>(new int(1)),
+        10);
+
+    // A move-only function.
+    alpaka::queue::enqueueHostFn(
+        queue,
+        MoveOnlyAppender(values),
+        std::unique_ptr<int>(new int(2)));
+
+    // Lvalue arguments are copied, so they can be changed after the enqueue.
+    std::vector<int> lvalueValues{3};
+    alpaka::queue::enqueueHostFn(
+        queue,
+        [&values](std::vector<int> const & arg)
+        {
+            values.insert(values.end(), arg.begin(), arg.end());
+        },
+        lvalueValues);
+    lvalueValues.clear();
+
+    alpaka::wait::wait(queue);
+
+    CHECK((std::vector<int>{11, 2, 3}) == values);
+}
+};
+
+//-----------------------------------------------------------------------------
+struct TestTemplateEnqueueHostFnCapture
+{
+template< typename TQueue >
+void operator()()
+{
+    auto const dev(alpaka::pltf::getDevByIdx<alpaka::pltf::PltfCpu>(0u));
+    TQueue queue(dev);
+
+    // Host functions can not be recorded.
+    alpaka::graph::beginCapture(queue);
+    CHECK_THROWS_AS(alpaka::queue::enqueueHostFn(queue, [](){}), std::runtime_error);
+    alpaka::graph::endCapture(queue);
+}
+};
+
 using TestQueues = alpaka::meta::Concatenate<
         alpaka::test::queue::TestQueues
  #ifdef ALPAKA_ACC_CPU_B_OMP2_T_SEQ_ENABLED
@@ -193,3 +369,32 @@ TEST_CASE( "queueShouldNotExecuteTasksInParallel", "[queue]")
 {
     alpaka::meta::forEachType< TestQueues >( TestQueueDoesNotExecuteTasksInParallel() );
 }
+
+TEST_CASE( "queueEnqueueBatchShouldExecuteTasksInOrder", "[queue]")
+{
+    alpaka::meta::forEachType< TestQueues >( TestTemplateEnqueueBatch() );
+}
+
+TEST_CASE( "queueEnqueueBatchShouldRevertTheEventsIfATaskCanNotBeEnqueued", "[queue]")
+{
+    alpaka::meta::forEachType<
+        std::tuple<
+            alpaka::queue::QueueCpuNonBlocking>>( TestTemplateEnqueueBatchThrowing() );
+}
+
+TEST_CASE( "queueEnqueueHostFnShouldMoveTheArguments", "[queue]")
+{
+    alpaka::meta::forEachType<
+        std::tuple<
+            alpaka::queue::QueueCpuBlocking,
+            alpaka::queue::QueueCpuNonBlocking,
+            alpaka::queue::QueueCpuConcurrent>>( TestTemplateEnqueueHostFn() );
+}
+
+TEST_CASE( "queueEnqueueHostFnCanNotBeCaptured", "[queue]")
+{
+    alpaka::meta::forEachType<
+        std::tuple<
+            alpaka::queue::QueueCpuBlocking,
+            alpaka::queue::QueueCpuNonBlocking>>( TestTemplateEnqueueHostFnCapture() );
+}
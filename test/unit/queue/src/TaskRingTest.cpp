@@ -0,0 +1,344 @@
+/* Copyright 2019 Benjamin Worpitz
+ *
+ * This file is part of Alpaka.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <alpaka/queue/cpu/TaskRing.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <chrono>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    //#############################################################################
+    //! A task which can not be copied into the ring.
+    class ThrowingCopyTask
+    {
+    public:
+        //-----------------------------------------------------------------------------
+        explicit ThrowingCopyTask(
+            std::atomic<std::size_t> & executedCount) :
+                m_pExecutedCount(&executedCount)
+        {}
+        //-----------------------------------------------------------------------------
+        ThrowingCopyTask(ThrowingCopyTask const &)
+        {
+            throw std::runtime_error("task copy failed");
+        }
+        //-----------------------------------------------------------------------------
+        auto operator()() const
+        -> void
+        {
+            ++(*m_pExecutedCount);
+        }
+
+    private:
+        std::atomic<std::size_t> * m_pExecutedCount;
+    };
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE( "taskRingExecutesTasksInOrder", "[queue]")
+{
+    // A small capacity forces the producers to wrap around and to spill tasks into the overflow list.
+    alpaka::queue::cpu::detail::TaskRing taskRing(4u);
+
+    std::size_t const producerCount(4u);
+    std::size_t const taskCount(1000u);
+
+    // Only the worker writes, so no synchronization is required besides waiting for the tasks.
+    std::vector<std::size_t> lastTaskIdx(producerCount, 0u);
+    std::atomic<bool> bOrderError(false);
+
+    std::vector<std::thread> producers;
+    for(std::size_t p(0u); p < producerCount; ++p)
+    {
+        producers.emplace_back(
+            [&, p]()
+            {
+                for(std::size_t i(1u); i <= taskCount; ++i)
+                {
+                    taskRing.enqueue(
+                        [&, p, i]()
+                        {
+                            // The tasks of each producer have to be executed in the order they have been enqueued.
+                            if(lastTaskIdx[p] + 1u != i)
+                            {
+                                bOrderError = true;
+                            }
+                            lastTaskIdx[p] = i;
+                        });
+                }
+            });
+    }
+    for(auto & producer : producers)
+    {
+        producer.join();
+    }
+
+    taskRing.waitFor(taskRing.getEnqueueCount());
+
+    CHECK(taskRing.isIdle());
+    CHECK(!bOrderError);
+    CHECK(producerCount * taskCount == taskRing.getCompletedCount());
+    for(auto const idx : lastTaskIdx)
+    {
+        CHECK(taskCount == idx);
+    }
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE( "taskRingWaitsForSequenceNumber", "[queue]")
+{
+    alpaka::queue::cpu::detail::TaskRing taskRing;
+
+    std::atomic<bool> bRelease(false);
+    bool bSecondTaskDone(false);
+
+    auto const sequence0(taskRing.enqueue(
+        [&]()
+        {
+            while(!bRelease)
+            {
+                std::this_thread::yield();
+            }
+        }));
+    auto const sequence1(taskRing.enqueue([&](){bSecondTaskDone = true;}));
+
+    CHECK(sequence0 + 1u == sequence1);
+    CHECK(!taskRing.isIdle());
+
+    bRelease = true;
+    taskRing.waitFor(sequence1);
+
+    CHECK(bSecondTaskDone);
+    CHECK(taskRing.isIdle());
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE( "taskRingStoresLargeTasks", "[queue]")
+{
+    alpaka::queue::cpu::detail::TaskRing taskRing;
+
+    // The function object is larger than the in-place storage.
+    std::array<std::uint64_t, 64u> values;
+    values.fill(1u);
+    std::uint64_t sum(0u);
+
+    taskRing.waitFor(taskRing.enqueue(
+        [values, &sum]()
+        {
+            for(auto const value : values)
+            {
+                sum += value;
+            }
+        }));
+
+    CHECK(64u == sum);
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE( "taskRingExecutesRemainingTasksOnDestruction", "[queue]")
+{
+    std::atomic<std::size_t> executedCount(0u);
+    {
+        alpaka::queue::cpu::detail::TaskRing taskRing;
+        for(std::size_t i(0u); i < 100u; ++i)
+        {
+            taskRing.enqueue([&](){++executedCount;});
+        }
+    }
+    CHECK(100u == executedCount);
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE( "taskRingExecutesBatchesWithoutInterleaving", "[queue]")
+{
+    alpaka::queue::cpu::detail::TaskRing taskRing(8u);
+
+    std::size_t const producerCount(4u);
+    std::size_t const batchCount(250u);
+
+    // Only the worker writes, so no synchronization is required besides waiting for the tasks.
+    std::vector<std::size_t> executedProducers;
+    executedProducers.reserve(producerCount * batchCount * 4u);
+
+    std::vector<std::thread> producers;
+    for(std::size_t p(0u); p < producerCount; ++p)
+    {
+        producers.emplace_back(
+            [&, p]()
+            {
+                auto const task([&, p](){executedProducers.push_back(p);});
+                for(std::size_t i(0u); i < batchCount; ++i)
+                {
+                    taskRing.enqueueBatch(task, task, task, task);
+                }
+            });
+    }
+    for(auto & producer : producers)
+    {
+        producer.join();
+    }
+
+    taskRing.waitFor(taskRing.getEnqueueCount());
+
+    // The four tasks of each batch have to be executed in a row.
+    REQUIRE(producerCount * batchCount * 4u == executedProducers.size());
+    for(std::size_t i(0u); i < executedProducers.size(); i += 4u)
+    {
+        CHECK(executedProducers[i] == executedProducers[i + 1u]);
+        CHECK(executedProducers[i] == executedProducers[i + 2u]);
+        CHECK(executedProducers[i] == executedProducers[i + 3u]);
+    }
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE( "taskRingSpillsBatchesLargerThanTheCapacity", "[queue]")
+{
+    alpaka::queue::cpu::detail::TaskRing taskRing(2u);
+
+    std::vector<int> order;
+
+    auto const sequence(taskRing.enqueueBatch(
+        [&](){order.push_back(0);},
+        [&](){order.push_back(1);},
+        [&](){order.push_back(2);}));
+
+    CHECK(3u == sequence);
+    CHECK(sequence == taskRing.enqueueBatch());
+
+    taskRing.waitFor(sequence);
+
+    CHECK((std::vector<int>{0, 1, 2}) == order);
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE( "taskRingParksTheTasksBehindAGateUntilItIsOpened", "[queue]")
+{
+    alpaka::queue::cpu::detail::TaskRing taskRing(8u);
+
+    std::atomic<std::size_t> executedCount(0u);
+    taskRing.enqueue([&](){++executedCount;});
+    auto const gate0(taskRing.enqueueGate());
+    taskRing.enqueue([&](){++executedCount;});
+    auto const gate1(taskRing.enqueueGate());
+    auto const sequence(taskRing.enqueue([&](){++executedCount;}));
+    CHECK(5u == sequence);
+
+    taskRing.waitFor(1u);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10u));
+    CHECK(1u == executedCount);
+    CHECK(1u == taskRing.getCompletedCount());
+
+    // Opening the later gate first does not release the tasks behind the earlier one.
+    std::thread(gate1).join();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10u));
+    CHECK(1u == executedCount);
+    CHECK(1u == taskRing.getCompletedCount());
+
+    std::thread(gate0).join();
+    taskRing.waitFor(sequence);
+    CHECK(3u == executedCount);
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE( "taskRingDoesNotBlockTheProducerBehindAClosedGate", "[queue]")
+{
+    alpaka::queue::cpu::detail::TaskRing taskRing(4u);
+
+    std::vector<int> order;
+    auto const gate(taskRing.enqueueGate());
+    // The tasks do not fit into the ring while the gate is closed.
+    std::uint64_t sequence(0u);
+    for(int i(0); i < 16; ++i)
+    {
+        sequence = taskRing.enqueue([&order, i](){order.push_back(i);});
+    }
+    // A gate spilled into the overflow list can be opened too.
+    auto const gateSpilled(taskRing.enqueueGate());
+    auto const sequenceLast(taskRing.enqueue([&order](){order.push_back(16);}));
+    CHECK(0u == taskRing.getCompletedCount());
+
+    gate();
+    taskRing.waitFor(sequence);
+    CHECK(16u == order.size());
+    CHECK(sequence == taskRing.getCompletedCount());
+
+    gateSpilled();
+    taskRing.waitFor(sequenceLast);
+    for(int i(0); i < 17; ++i)
+    {
+        CHECK(i == order[static_cast<std::size_t>(i)]);
+    }
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE( "taskRingAcceptsTasksEnqueuedByItsOwnTasks", "[queue]")
+{
+    alpaka::queue::cpu::detail::TaskRing taskRing(4u);
+
+    std::atomic<std::size_t> executedCount(0u);
+    std::size_t const taskCount(16u);
+    auto const sequence(taskRing.enqueue(
+        [&taskRing, &executedCount, taskCount]()
+        {
+            for(std::size_t i(0u); i < taskCount; ++i)
+            {
+                taskRing.enqueue([&executedCount](){++executedCount;});
+            }
+        }));
+    taskRing.waitFor(sequence + taskCount);
+
+    CHECK(taskCount == executedCount.load());
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE( "taskRingCanBeDestroyedAfterTheCopyOfATaskThrew", "[queue]")
+{
+    std::atomic<std::size_t> executedCount(0u);
+    {
+        // The worker is blocked and the capacity is small, so the tasks are stored both in the ring and in the overflow list.
+        alpaka::queue::cpu::detail::TaskRing taskRing(2u);
+
+        std::atomic<bool> bRelease(false);
+        taskRing.enqueue(
+            [&]()
+            {
+                while(!bRelease.load())
+                {
+                    std::this_thread::yield();
+                }
+                ++executedCount;
+            });
+
+        ThrowingCopyTask const task(executedCount);
+        for(std::size_t i(0u); i < 4u; ++i)
+        {
+            CHECK_THROWS_AS(taskRing.enqueue(task), std::runtime_error);
+        }
+        CHECK_THROWS_AS(
+            taskRing.enqueueBatch(
+                [&](){++executedCount;},
+                task,
+                [&](){++executedCount;}),
+            std::runtime_error);
+        taskRing.enqueue([&](){++executedCount;});
+
+        bRelease = true;
+    }
+    // Tasks doing nothing have taken the places of the task which could not be copied and of the rest of its batch.
+    CHECK(3u == executedCount.load());
+}